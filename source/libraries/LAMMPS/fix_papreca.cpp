@@ -1,9 +1,13 @@
 #include "fix_papreca.h"
 #include "atom.h"
+#include "comm.h"
+#include "force.h"
+#include "memory.h"
 #include "neighbor.h"
 #include "neigh_request.h"
 #include "neigh_list.h"
 #include "error.h"
+#include <algorithm>
 #include <cstring>
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -14,12 +18,21 @@ FixPAPRECA::FixPAPRECA(LAMMPS *lmp, int narg, char **arg) : Fix(lmp, narg, arg)
   if (narg != 3) error->all(FLERR, "Illegal papreca command. Use this fix as: fix papreca all papreca");
   if ( strcmp( arg[0] , "papreca" ) != 0 ) error->all(FLERR, "Illegal papreca command. Group id MUST be papreca. Only use this fix as: fix papreca all papreca");
   if ( strcmp( arg[1] , "all" ) != 0 ) error->all(FLERR, "Illegal papreca command. This fix has to be applied to the all group. Only use this fix as: fix papreca all papreca");
+
+  bond_adj_num = nullptr;
+  bond_adj_partner = nullptr;
+  bond_adj_type = nullptr;
+  bond_adj_head = nullptr;
+  maxbond_adj = maxbond_alloc = nmax_adj = 0;
 }
 
 /* ---------------------------------------------------------------------- */
 
 FixPAPRECA::~FixPAPRECA() {
-  // Destructor if needed
+  memory->destroy(bond_adj_num);
+  memory->destroy(bond_adj_partner);
+  memory->destroy(bond_adj_type);
+  memory->destroy(bond_adj_head);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -39,7 +52,13 @@ void FixPAPRECA::init() {
   
   // Request a half neighbor list
   neighbor->add_request( this )->set_id(2);
-  
+
+  // Size of per-atom bond adjacency messages. Every bond of an atom is also a 1-2 special neighbor,
+  // so maxspecial bounds the number of bonds per atom (bond_per_atom bounds it for newton_bond off).
+  maxbond_adj = 0;
+  if (atom->molecular == Atom::MOLECULAR) maxbond_adj = std::max(atom->maxspecial, atom->bond_per_atom);
+  comm_forward = comm_reverse = 1 + 3 * maxbond_adj;
+
 }
 
 void FixPAPRECA::init_list(int id, NeighList *ptr)
@@ -55,3 +74,149 @@ void FixPAPRECA::init_list(int id, NeighList *ptr)
   
 }
 
+/* ----------------------------------------------------------------------
+   build bond adjacency of owned and ghost atoms from the per-atom bond
+   arrays (i.e., without gathering the bonds of the whole system).
+   newton_bond on: each bond is stored by one atom only, so bonds are
+   also added to the partner atom (local or ghost) and ghost contributions
+   are summed to the owners through a reverse communication.
+   A forward communication then copies the complete lists of owned atoms
+   to their ghosts. The head atom of a bond is the atom storing it
+   (newton_bond on) or the atom with the smaller ID (newton_bond off),
+   consistent with lammps_gather_bonds().
+------------------------------------------------------------------------- */
+
+void FixPAPRECA::build_bond_adjacency()
+{
+  if (atom->molecular != Atom::MOLECULAR)
+    error->all(FLERR, "Fix papreca bond adjacency requires a molecular atom style with bonds");
+
+  if (atom->nmax > nmax_adj || maxbond_adj != maxbond_alloc) {
+    memory->destroy(bond_adj_num);
+    memory->destroy(bond_adj_partner);
+    memory->destroy(bond_adj_type);
+    memory->destroy(bond_adj_head);
+    nmax_adj = atom->nmax;
+    maxbond_alloc = maxbond_adj;
+    memory->create(bond_adj_num, nmax_adj, "papreca:bond_adj_num");
+    memory->create(bond_adj_partner, nmax_adj, std::max(maxbond_alloc, 1), "papreca:bond_adj_partner");
+    memory->create(bond_adj_type, nmax_adj, std::max(maxbond_alloc, 1), "papreca:bond_adj_type");
+    memory->create(bond_adj_head, nmax_adj, std::max(maxbond_alloc, 1), "papreca:bond_adj_head");
+  }
+
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+  for (int i = 0; i < nall; i++) bond_adj_num[i] = 0;
+
+  tagint *tag = atom->tag;
+  int *num_bond = atom->num_bond;
+  int **bond_type = atom->bond_type;
+  tagint **bond_atom = atom->bond_atom;
+  const int newton_bond = force->newton_bond;
+
+  for (int i = 0; i < nlocal; i++) {
+    for (int m = 0; m < num_bond[i]; m++) {
+      if (bond_type[i][m] <= 0) continue;    // bonds turned off by delete_bonds
+      const tagint partner = bond_atom[i][m];
+      if (newton_bond) {
+        const int j = atom->map(partner);
+        if (j < 0) error->one(FLERR, "Bond atom {} missing in fix papreca bond adjacency", partner);
+        add_bond_adj(i, partner, bond_type[i][m], 1);
+        add_bond_adj(j, tag[i], bond_type[i][m], 0);
+      } else {
+        add_bond_adj(i, partner, bond_type[i][m], tag[i] < partner ? 1 : 0);
+      }
+    }
+  }
+
+  if (newton_bond) comm->reverse_comm(this);
+  comm->forward_comm(this);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixPAPRECA::add_bond_adj(int i, tagint partner, int type, int head)
+{
+  if (bond_adj_num[i] == maxbond_alloc)
+    error->one(FLERR, "Too many bonds per atom in fix papreca bond adjacency");
+  const int k = bond_adj_num[i]++;
+  bond_adj_partner[i][k] = partner;
+  bond_adj_type[i][k] = type;
+  bond_adj_head[i][k] = head;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixPAPRECA::pack_forward_comm(int n, int *list, double *buf, int /*pbc_flag*/, int * /*pbc*/)
+{
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    const int j = list[i];
+    buf[m++] = ubuf(bond_adj_num[j]).d;
+    for (int k = 0; k < bond_adj_num[j]; k++) {
+      buf[m++] = ubuf(bond_adj_partner[j][k]).d;
+      buf[m++] = ubuf(bond_adj_type[j][k]).d;
+      buf[m++] = ubuf(bond_adj_head[j][k]).d;
+    }
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixPAPRECA::unpack_forward_comm(int n, int first, double *buf)
+{
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    bond_adj_num[i] = (int) ubuf(buf[m++]).i;
+    for (int k = 0; k < bond_adj_num[i]; k++) {
+      bond_adj_partner[i][k] = (tagint) ubuf(buf[m++]).i;
+      bond_adj_type[i][k] = (int) ubuf(buf[m++]).i;
+      bond_adj_head[i][k] = (int) ubuf(buf[m++]).i;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixPAPRECA::pack_reverse_comm(int n, int first, double *buf)
+{
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    buf[m++] = ubuf(bond_adj_num[i]).d;
+    for (int k = 0; k < bond_adj_num[i]; k++) {
+      buf[m++] = ubuf(bond_adj_partner[i][k]).d;
+      buf[m++] = ubuf(bond_adj_type[i][k]).d;
+      buf[m++] = ubuf(bond_adj_head[i][k]).d;
+    }
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixPAPRECA::unpack_reverse_comm(int n, int *list, double *buf)
+{
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    const int j = list[i];
+    const int num = (int) ubuf(buf[m++]).i;
+    for (int k = 0; k < num; k++) {
+      const tagint partner = (tagint) ubuf(buf[m++]).i;
+      const int type = (int) ubuf(buf[m++]).i;
+      const int head = (int) ubuf(buf[m++]).i;
+      add_bond_adj(j, partner, type, head);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixPAPRECA::memory_usage()
+{
+  double bytes = (double) nmax_adj * sizeof(int);
+  bytes += (double) nmax_adj * maxbond_alloc * (sizeof(tagint) + 2 * sizeof(int));
+  return bytes;
+}
@@ -16,9 +16,27 @@ class FixPAPRECA : public Fix {
   int setmask() override;
   void init() override;
   void init_list(int id, NeighList *ptr) override;
+  int pack_forward_comm(int, int *, double *, int, int *) override;
+  void unpack_forward_comm(int, int, double *) override;
+  int pack_reverse_comm(int, int, double *) override;
+  void unpack_reverse_comm(int, int *, double *) override;
+  double memory_usage() override;
+
+  // rank-local bond adjacency of owned and ghost atoms (see build_bond_adjacency())
+  void build_bond_adjacency();
+  int *bond_adj_num;            // number of bonds of each owned/ghost atom
+  tagint **bond_adj_partner;    // IDs of bonded atoms
+  int **bond_adj_type;          // bond types
+  int **bond_adj_head;          // 1 if the atom is the head atom of the bond, 0 otherwise
+
  private:
   class NeighList *nlist_half;
   class NeighList *nlist_full;
+  int maxbond_adj;              // max bonds per atom (set in init())
+  int maxbond_alloc;            // max bonds per atom of allocated arrays
+  int nmax_adj;                 // max atoms of allocated arrays
+
+  void add_bond_adj(int, tagint, int, int);
 };
 
 }
@@ -38,73 +38,19 @@ namespace PAPRECA{
 	void Bond::assignBondType( const int &bond_type_in ){ bond_type = bond_type_in; }
 	
 	//Static functions
-	const bool Bond::atomIDIsMapped( LAMMPS_NS::tagint &parent_atomID , PAPRECA::ATOM2BONDS_MAP &atomID2bonds ){
-
-		/// Checks if the parent_atomID is contained in the atomID2bonds map
-		/// @param[in] parent_atomID ID of parent atom.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @see PAPRECA::Bond::fillAtomID2BondsContainer(), PAPRECA::Bond::addBond2BondVector(), PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::Bond::initAndGatherBondsList()
-		
-		return( ( atomID2bonds.find( parent_atomID ) == atomID2bonds.end( ) ) ? false : true );
-	
-	}
-	
-	void Bond::addBond2BondVector( int &bond_type , LAMMPS_NS::tagint &parent_atomID , LAMMPS_NS::tagint &bond_atomID , const bool &head_atom_parent , ATOM2BONDS_MAP &atomID2bonds ){
-	
-		/// Receives the bond type and atom IDs of a bond. Then, initializes a PAPRECA::Bond and inserts it in the relevant std::vector< PAPRECA::Bond > containers. The std::vector< PAPRECA::Bond > containers are stored in the atomID2bonds map.
-		/// @param[in] bond_type type of bond.
-		/// @param[in] parent_atomID ID of the first atom ID of the bond.
-		/// @param[in] bond_atomID ID of the second atom ID of the bond.
-		/// @param[in] head_atom_parent boolean dictating whether the parent_atomID is the head atom of the current bond
-		/// @param[in,out] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @see PAPRECA::Bond::fillAtomID2BondsContainer(), PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::Bond::atomIDIsMapped(), PAPRECA::Bond::initAndGatherBondsList()
-		
-		if ( !atomIDIsMapped( parent_atomID , atomID2bonds ) ){
-			BOND_VECTOR bonds;
-			Bond bond = Bond( bond_atomID , bond_type , head_atom_parent ); //initialize bond object with bond_atomID
-			bonds.push_back( bond ); //insert initialized bond object in BOND_VECTOR of parent_atom
-			atomID2bonds[parent_atomID] = bonds; //map parent atom to BOND_VECTOR, since the BOND_VECTOR was created in here.
-		}else{ //if the parent atom is already mapped
-			BOND_VECTOR &bonds = atomID2bonds[ parent_atomID ]; //retrieve unordered set from map, if map already exists
-			Bond bond = Bond( bond_atomID , bond_type , head_atom_parent ); //initialize bond object with bond_atomID
-			bonds.push_back( bond );
-		}
-	
-	}
-	
-	void Bond::fillAtomID2BondsContainer( ATOM2BONDS_MAP &atomID2bonds , LAMMPS_NS::tagint *bonds_list , const LAMMPS_NS::bigint &bonds_num ){
-		
-		/// Fills atomID2bonds container with bonds gathered from LAMMPS and stored in the bonds_list array.
-		/// @param[in,out] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @param[in] bonds_list array containing the IDs of bonds.
-		/// @param[in] bonds_num number of bonds in the bonds_list array.
-		/// @see PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::Bond::addBond2BondVector(), PAPRECA::Bond::atomIDIsMapped(), PAPRECA::Bond::initAndGatherBondsList()
-
-		for ( int i = 0; i < bonds_num; ++i ){
-			int bond_type = bonds_list[3*i];
-			LAMMPS_NS::tagint bond_atom1ID = bonds_list[3*i+1];
-			LAMMPS_NS::tagint bond_atom2ID = bonds_list[3*i+2];
-			addBond2BondVector( bond_type , bond_atom1ID , bond_atom2ID , true , atomID2bonds ); //We consider the first atom appearing in the list (atom1) to be the head atom of this bond
-																								//We use the head atom to find which processor "owns" a bonding event and avoid scanning the same pair of bonds twice( this would happen if in the future the bond formation events are discovered using a full neib list).
-			addBond2BondVector( bond_type , bond_atom2ID , bond_atom1ID , false , atomID2bonds ); //repeat inverse process so the other atom also knows about the current atom.
-
-		}
-	}
+	void Bond::initAtomID2BondsMap( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , BondGraph &atomID2bonds ){
 	
-	void Bond::initAtomID2BondsMap( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , ATOM2BONDS_MAP &atomID2bonds ){
-	
-		/// Initializes/fills atomID2bonds map. This is done by 1) gathering all bonds from the LAMMPS instance, 2) creating a std::vector< PAPRECA::Bond > container for each atomID, 3) filling the std::vector< PAPRECA::Bond > container with the IDs of bonded atoms.
+		/// Initializes/fills atomID2bonds graph. This is done by 1) gathering all bonds from the LAMMPS instance, 2) counting the bonds of each atom ID, 3) filling the contiguous PAPRECA::Bond storage of the graph with the IDs of bonded atoms (see PAPRECA::BondGraph::buildFromBondsList()).
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in,out] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @see PAPRECA::Bond::fillAtomID2BondsContainer(), PAPRECA::Bond::addBond2BondVector(), PAPRECA::Bond::atomIDIsMapped(), PAPRECA::Bond::initAndGatherBondsList()
+		/// @param[in,out] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @see PAPRECA::BondGraph::buildFromBondsList(), PAPRECA::initAndGatherBondsList()
+		/// @note This function does not refresh the LAMMPS system. Call PAPRECA::refreshLammps() beforehand if the neighbor lists of LAMMPS are used after this call.
 
-		runLammps( lmp , 0 ); //force a run 0 to initialize/refresh bonds list and initialize/refresh neighbor list.
-		
 		LAMMPS_NS::tagint *bonds_list = NULL;
 		LAMMPS_NS::bigint bonds_num = 0;
 		initAndGatherBondsList( lmp , &bonds_list , bonds_num );
-		fillAtomID2BondsContainer( atomID2bonds , bonds_list , bonds_num );
+		atomID2bonds.buildFromBondsList( bonds_list , bonds_num );
 		
 		delete[ ] bonds_list;
 
@@ -112,23 +58,42 @@ namespace PAPRECA{
 	}
 	
 	
-	bool Bond::atomHasBonds( const LAMMPS_NS::tagint &iatom_id , ATOM2BONDS_MAP &atomID2bonds ){
+	void Bond::initAtomID2BondsMapFromLocalAtoms( LAMMPS_NS::LAMMPS *lmp , BondGraph &atomID2bonds ){
+		
+		/// Initializes/fills atomID2bonds graph ONLY for the local (owned) and ghost atoms of the current MPI process. Contrary to PAPRECA::Bond::initAtomID2BondsMap(), the bonds of the whole system are not gathered on every MPI process. Instead, the bonds of local and ghost atoms are retrieved from the per-atom bond arrays of LAMMPS (through the papreca fix, see FixPAPRECA::build_bond_adjacency()). Hence, memory and time scale with the number of local atoms and not with the total number of atoms.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @see PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::BondGraph::buildFromLocalAtoms()
+		/// @note The head atom of each bond is the same as in PAPRECA::Bond::initAtomID2BondsMap() (i.e., the first atom of each bond in the list returned by lammps_gather_bonds).
+		/// @note Event detection only requires the bonds of local atoms and their neighbors (i.e., ghost atoms). However, PAPRECA::Bond::recursiveCollectBondedAtoms() requires the bonds of the whole system, so this function should not be used to collect bonded atoms.
+		
+		/// @note Ghost atoms have to be up-to-date. Hence, PAPRECA::refreshLammps() has to be called beforehand.
+		
+		LAMMPS_NS::FixPAPRECA *fix_papreca = dynamic_cast< LAMMPS_NS::FixPAPRECA* >( lmp->modify->get_fix_by_id( "papreca" ) );
+		if( !fix_papreca ){ allAbortWithMessage( MPI_COMM_WORLD , "Lammps could not find fix papreca in initAtomID2BondsMapFromLocalAtoms function (bond.cpp). Please ensure that the fix papreca command is present in your LAMMPS input file." ); }
+		fix_papreca->build_bond_adjacency( );
+		
+		atomID2bonds.buildFromLocalAtoms( lmp->atom , fix_papreca->bond_adj_num , fix_papreca->bond_adj_partner , fix_papreca->bond_adj_type , fix_papreca->bond_adj_head );
+		
+	}
+	
+	bool Bond::atomHasBonds( const LAMMPS_NS::tagint &iatom_id , BondGraph &atomID2bonds ){
 			
-		return !atomID2bonds[ iatom_id ].empty( ); //atomID2bonds[ iatom_id ] returns a BONDS_vector. We use empty( ) to see if the vector is empty and return false (use of !) if that's the case because it means that the atom has no bonds.
+		return ( atomID2bonds.getBondsNum( iatom_id ) > 0 ); //Unbonded (or unknown) atoms have zero bonds.
 			
 	}
 	
-	void Bond::recursiveCollectBondedAtoms( LAMMPS_NS::tagint &atom_id , std::vector< LAMMPS_NS::tagint > &delids_local , TAGINT_SET &delids_set , ATOM2BONDS_MAP &atomID2bonds ){
+	void Bond::recursiveCollectBondedAtoms( LAMMPS_NS::tagint &atom_id , std::vector< LAMMPS_NS::tagint > &delids_local , TAGINT_SET &delids_set , BondGraph &atomID2bonds ){
 		
-		/// Recursively collects all bonded atoms of an atom. The IDs of collected atoms are inserted in the std::vector< tagint > container (delids_local). The vector of PAPRECA::Bond objects is retrieved for the atom_id from the atomID2bonds map. The function uses an atom tagint to start adding bonded atoms and returns when all bonded atoms are recursively collected (uses an std::unordered_set to decide that).
+		/// Recursively collects all bonded atoms of an atom. The IDs of collected atoms are inserted in the std::vector< tagint > container (delids_local). The PAPRECA::Bond objects of atom_id are retrieved from the atomID2bonds graph. The function uses an atom tagint to start adding bonded atoms and returns when all bonded atoms are recursively collected (uses an std::unordered_set to decide that).
 		/// @param[in] atom_id ID of atom.
 		/// @param[in,out] delids_local vector of collected atom IDs.
 		/// @param[in,out] delids_set std::unordered_set< LAMMPS_NS::tagint > containing atom IDs marked for deletion. Used to avoid duplicate deletion of atoms.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @note This function works consistently because all MPI processes contain the same data in their atomID2bonds map.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @note This function works consistently because all MPI processes contain the same data in their atomID2bonds graph (i.e., if the graph was initialized by PAPRECA::Bond::initAtomID2BondsMap()).
 		/// @see PAPRECA::Bond::initAtomID2BondsMap()
 		
-		BOND_VECTOR &bonds = atomID2bonds[ atom_id ];
+		const BondRange bonds = atomID2bonds.getBonds( atom_id );
 		
 		
 		for( const auto &bond : bonds ){
@@ -150,4 +115,141 @@ namespace PAPRECA{
 		
 	}
 	
+	//BondRange
+	BondRange::BondRange( const Bond *first_in , const Bond *last_in ) : first( first_in ) , last( last_in ){ }
+	BondRange::~BondRange( ){ }
+	
+	const Bond *BondRange::begin( ) const{ return first; }
+	const Bond *BondRange::end( ) const{ return last; }
+	const int BondRange::size( ) const{ return static_cast< int >( last - first ); }
+	const bool BondRange::empty( ) const{ return ( first == last ); }
+	
+	//BondGraph
+	BondGraph::BondGraph( ){ }
+	BondGraph::~BondGraph( ){ }
+	
+	void BondGraph::buildFromBondsList( const LAMMPS_NS::tagint *bonds_list , const LAMMPS_NS::bigint &bonds_num ){
+		
+		/// Builds a global graph from the bonds list returned by lammps_gather_bonds (i.e., bond type, atom1 ID, atom2 ID for each bond). The bonds are counted per atom, the CSR offsets are computed, and the PAPRECA::Bond objects are then placed directly in their final (contiguous) position.
+		/// @param[in] bonds_list array containing the types and atom IDs of bonds.
+		/// @param[in] bonds_num number of bonds in the bonds_list array.
+		/// @see PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::initAndGatherBondsList()
+		/// @note We consider the first atom appearing in the list (atom1) to be the head atom of each bond. We use the head atom to find which processor "owns" a bond breaking event and avoid scanning the same bond twice.
+		/// @note The bonds of each atom are stored in the order they appear in bonds_list.
+		
+		clear( );
+		
+		LAMMPS_NS::tagint atom_id_max = 0;
+		for( LAMMPS_NS::bigint i = 0; i < bonds_num; ++i ){
+			atom_id_max = std::max( atom_id_max , std::max( bonds_list[3*i+1] , bonds_list[3*i+2] ) );
+		}
+		atomID2vertex.assign( atom_id_max + 1 , -1 );
+		
+		//Assign vertices (in order of appearance) and count the bonds of each vertex
+		offsets.push_back( 0 );
+		for( LAMMPS_NS::bigint i = 0; i < 2 * bonds_num; ++i ){
+			const LAMMPS_NS::tagint atom_id = bonds_list[3*(i/2)+1+(i%2)];
+			int &vertex = atomID2vertex[atom_id];
+			if( vertex == -1 ){
+				vertex = static_cast< int >( vertex2atomID.size( ) );
+				vertex2atomID.push_back( atom_id );
+				offsets.push_back( 0 );
+			}
+			++offsets[vertex+1];
+		}
+		for( size_t v = 1; v < offsets.size( ); ++v ){ offsets[v] += offsets[v-1]; }
+		
+		//Place bonds
+		bonds.resize( 2 * bonds_num );
+		std::vector< LAMMPS_NS::bigint > next( offsets.begin( ) , offsets.end( ) - 1 );
+		for( LAMMPS_NS::bigint i = 0; i < bonds_num; ++i ){
+			const int bond_type = bonds_list[3*i];
+			const LAMMPS_NS::tagint atom1_id = bonds_list[3*i+1];
+			const LAMMPS_NS::tagint atom2_id = bonds_list[3*i+2];
+			bonds[ next[ atomID2vertex[atom1_id] ]++ ] = Bond( atom2_id , bond_type , true );
+			bonds[ next[ atomID2vertex[atom2_id] ]++ ] = Bond( atom1_id , bond_type , false ); //The other atom also knows about the current atom.
+		}
+		
+	}
+	
+	void BondGraph::buildFromLocalAtoms( LAMMPS_NS::Atom *atom_in , const int *bonds_num , LAMMPS_NS::tagint **bond_atoms , int **bond_types , int **bond_heads ){
+		
+		/// Builds a local graph from per-atom bond arrays of local and ghost atoms (e.g., see FixPAPRECA::build_bond_adjacency()). The vertices of the graph are the local atom indices.
+		/// @param[in] atom_in pointer to the LAMMPS Atom class.
+		/// @param[in] bonds_num number of bonds of each local/ghost atom.
+		/// @param[in] bond_atoms IDs of bonded atoms of each local/ghost atom.
+		/// @param[in] bond_types bond types of each local/ghost atom.
+		/// @param[in] bond_heads 1 if the local/ghost atom is the head atom of the bond, 0 otherwise.
+		/// @see PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()
+		/// @note Queries on local graphs use the LAMMPS atom map. Hence, the graph is only valid until atoms are inserted/deleted or migrated between MPI processes.
+		
+		clear( );
+		atom = atom_in;
+		
+		const int nall = atom->nlocal + atom->nghost;
+		offsets.resize( nall + 1 );
+		offsets[0] = 0;
+		for( int i = 0; i < nall; ++i ){ offsets[i+1] = offsets[i] + bonds_num[i]; }
+		
+		bonds.resize( offsets[nall] );
+		for( int i = 0; i < nall; ++i ){
+			for( int k = 0; k < bonds_num[i]; ++k ){
+				bonds[ offsets[i] + k ] = Bond( bond_atoms[i][k] , bond_types[i][k] , bond_heads[i][k] );
+			}
+		}
+		
+	}
+	
+	void BondGraph::clear( ){
+		
+		/// Clears the graph. The capacity of the underlying containers is kept, so rebuilding the graph on the next PAPRECA step does not require new allocations (unless the system grows).
+		
+		offsets.clear( );
+		bonds.clear( );
+		atomID2vertex.clear( );
+		vertex2atomID.clear( );
+		atom = nullptr;
+		
+	}
+	
+	const int BondGraph::getVertex( const LAMMPS_NS::tagint &atom_id ) const{
+		
+		/// @param[in] atom_id ID of atom.
+		/// @return vertex of atom_id or -1 if atom_id is not a vertex of the graph.
+		
+		if( atom ){
+			const int vertex = atom->map( atom_id );
+			return ( ( vertex >= 0 && vertex + 1 < static_cast< int >( offsets.size( ) ) ) ? vertex : -1 );
+		}
+		
+		return ( ( atom_id >= 0 && atom_id < static_cast< LAMMPS_NS::tagint >( atomID2vertex.size( ) ) ) ? atomID2vertex[atom_id] : -1 );
+		
+	}
+	
+	const int BondGraph::getBondsNum( const LAMMPS_NS::tagint &atom_id ) const{
+		
+		/// @param[in] atom_id ID of atom.
+		/// @return number of bonds of atom_id (0 if atom_id is not a vertex of the graph).
+		
+		const int vertex = getVertex( atom_id );
+		return ( vertex == -1 ? 0 : static_cast< int >( offsets[vertex+1] - offsets[vertex] ) );
+		
+	}
+	
+	BondRange BondGraph::getBonds( const LAMMPS_NS::tagint &atom_id ) const{
+		
+		/// @param[in] atom_id ID of atom.
+		/// @return PAPRECA::BondRange of the bonds of atom_id (empty if atom_id is not a vertex of the graph).
+		
+		const int vertex = getVertex( atom_id );
+		return ( vertex == -1 ? BondRange( nullptr , nullptr ) : getVertexBonds( vertex ) );
+		
+	}
+	
+	const int BondGraph::getVerticesNum( ) const{ return ( offsets.empty( ) ? 0 : static_cast< int >( offsets.size( ) ) - 1 ); }
+	
+	const LAMMPS_NS::tagint BondGraph::getVertexAtomID( const int &vertex ) const{ return ( atom ? atom->tag[vertex] : vertex2atomID[vertex] ); }
+	
+	BondRange BondGraph::getVertexBonds( const int &vertex ) const{ return BondRange( bonds.data( ) + offsets[vertex] , bonds.data( ) + offsets[vertex+1] ); }
+	
 } //End of PAPRECA namespace
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 //System Headers
 #include <vector>
 #include <unordered_map>
+#include <algorithm>
 #include <cstdlib>
 #include <cstdio>
 
@@ -33,6 +34,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 //LAMMPS headers
 /// \cond
 #include "pointers.h"
+#include "atom.h"
+#include "modify.h"
+#include "fix_papreca.h"
 /// \endcond
 
 //PAPRECA headers
@@ -41,18 +45,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 
-	class Bond; //Forward definition of bond class
-	typedef std::vector< Bond > BOND_VECTOR;
-	typedef std::unordered_map< LAMMPS_NS::tagint , BOND_VECTOR > ATOM2BONDS_MAP; ///< maps atom IDs to their associated PAPRECA::BOND_VECTOR to allow easy access of bonds and bond types.
+	class BondGraph; //Forward definition of bond graph class
 	
 	class Bond{
 		
 		/// @class PAPRECA::Bond
 		/// @brief Custom bond class (not to be confused with a LAMMPS bond).
 		///
-		/// Every atom in the system is associated with a vector of bond objects. The bonds vector of objects provides easy access to bonded atom IDs and bond types.
-		/// PAPRECA::Bond objects enable bond formation, bond breaking, and custom diffusion events (e.g., the Fe_4PO4neib diffusion style deploys the bond vectors of the neighbors of the candidate Fe atom to determine whether or not there are 4 PO4 in the parent Fe neighborhood).
-		/// The unordered_map PAPRECA::ATOM2BONDS_MAP can be used to retrieve the relevant vector of bond objects using a LAMMPS atom ID.
+		/// Every atom in the system is associated with a contiguous range of bond objects stored in a PAPRECA::BondGraph. The bond objects provide easy access to bonded atom IDs and bond types.
+		/// PAPRECA::Bond objects enable bond formation, bond breaking, and custom diffusion events (e.g., the Fe_4PO4neib diffusion style deploys the bonds of the neighbors of the candidate Fe atom to determine whether or not there are 4 PO4 in the parent Fe neighborhood).
+		/// The PAPRECA::BondGraph can be used to retrieve the relevant bond objects using a LAMMPS atom ID.
 		
 
 		private:
@@ -74,12 +76,68 @@ namespace PAPRECA{
 			void assignBondType( const int &bond_type_in );
 			
 			//Static functions
-			static const bool atomIDIsMapped( LAMMPS_NS::tagint &parent_atomID , ATOM2BONDS_MAP &atomID2bonds );
-			static void addBond2BondVector( int &bond_type , LAMMPS_NS::tagint &parent_atomID , LAMMPS_NS::tagint &bond_atomID , const bool &head_atom_parent , ATOM2BONDS_MAP &atomID2bonds );
-			static void fillAtomID2BondsContainer( ATOM2BONDS_MAP &atomID2bonds , LAMMPS_NS::tagint *bonds_list , const LAMMPS_NS::bigint &bonds_num );
-			static void initAtomID2BondsMap( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , ATOM2BONDS_MAP &atomID2bonds );
-			static bool atomHasBonds( const LAMMPS_NS::tagint &iatom_id , ATOM2BONDS_MAP &atomID2bonds );
-			static void recursiveCollectBondedAtoms( LAMMPS_NS::tagint &atom_id , std::vector< LAMMPS_NS::tagint > &delids_local , TAGINT_SET &delids_set , ATOM2BONDS_MAP &atomID2bonds );
+			static void initAtomID2BondsMap( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , BondGraph &atomID2bonds );
+			static void initAtomID2BondsMapFromLocalAtoms( LAMMPS_NS::LAMMPS *lmp , BondGraph &atomID2bonds );
+			static bool atomHasBonds( const LAMMPS_NS::tagint &iatom_id , BondGraph &atomID2bonds );
+			static void recursiveCollectBondedAtoms( LAMMPS_NS::tagint &atom_id , std::vector< LAMMPS_NS::tagint > &delids_local , TAGINT_SET &delids_set , BondGraph &atomID2bonds );
+	};
+	
+	class BondRange{
+		
+		/// @class PAPRECA::BondRange
+		/// @brief Contiguous (read-only) range of the PAPRECA::Bond objects of a single atom, as returned by PAPRECA::BondGraph::getBonds(). Can be used in range-based for loops.
+		
+		private:
+			const Bond *first = nullptr;
+			const Bond *last = nullptr;
+		
+		public:
+			//Constructors/Destructors
+			BondRange( const Bond *first_in , const Bond *last_in );
+			~BondRange( );
+			
+			//Member functions
+			const Bond *begin( ) const;
+			const Bond *end( ) const;
+			const int size( ) const;
+			const bool empty( ) const;
+	};
+	
+	class BondGraph{
+		
+		/// @class PAPRECA::BondGraph
+		/// @brief Bonds of atoms stored in compressed sparse row (CSR) format.
+		///
+		/// The PAPRECA::Bond objects of all atoms are stored in a single contiguous container. The bonds of each vertex (i.e., atom) occupy the range [offsets[vertex],offsets[vertex+1]) of that container.
+		/// Global graphs (see PAPRECA::Bond::initAtomID2BondsMap()) contain the bonds of the whole system. Their vertices are retrieved from atom IDs through a dense (i.e., indexed by atom ID) lookup table.
+		/// Local graphs (see PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()) only contain the bonds of local and ghost atoms. Their vertices are the local (LAMMPS) atom indices and are retrieved through the LAMMPS atom map.
+		/// Queries for unbonded or unknown atoms return empty ranges without modifying the graph.
+		
+		public:
+			//Constructors/Destructors
+			BondGraph( );
+			~BondGraph( );
+			
+			//Build
+			void buildFromBondsList( const LAMMPS_NS::tagint *bonds_list , const LAMMPS_NS::bigint &bonds_num );
+			void buildFromLocalAtoms( LAMMPS_NS::Atom *atom_in , const int *bonds_num , LAMMPS_NS::tagint **bond_atoms , int **bond_types , int **bond_heads );
+			void clear( );
+			
+			//Queries
+			const int getBondsNum( const LAMMPS_NS::tagint &atom_id ) const;
+			BondRange getBonds( const LAMMPS_NS::tagint &atom_id ) const;
+			const int getVerticesNum( ) const;
+			const LAMMPS_NS::tagint getVertexAtomID( const int &vertex ) const;
+			BondRange getVertexBonds( const int &vertex ) const;
+		
+		private:
+			const int getVertex( const LAMMPS_NS::tagint &atom_id ) const;
+			
+			std::vector< LAMMPS_NS::bigint > offsets; ///< CSR offsets. The bonds of vertex v are stored in bonds[offsets[v]] to bonds[offsets[v+1]-1].
+			std::vector< Bond > bonds; ///< PAPRECA::Bond objects of all vertices (stored contiguously).
+			std::vector< int > atomID2vertex; ///< dense lookup table (global graphs only). atomID2vertex[atom_id] is the vertex of atom_id or -1 if the atom has no bonds.
+			std::vector< LAMMPS_NS::tagint > vertex2atomID; ///< atom ID of each vertex (global graphs only).
+			LAMMPS_NS::Atom *atom = nullptr; ///< pointer to the LAMMPS Atom class (local graphs only). Vertices are local atom indices retrieved through atom->map().
 	};
 	
 } //End of PAPRECA namespace
@@ -0,0 +1,97 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Definitions for counter_rng.h.
+
+#include "counter_rng.h"
+
+namespace PAPRECA{
+	
+	//Constructors/Destructors
+	CounterRNG::CounterRNG( ){ }
+	CounterRNG::~CounterRNG( ){ }
+	
+	//Functions
+	void CounterRNG::setSeed( const uint64_t &seed ){
+		
+		/// @param[in] seed random seed (used as the Philox key).
+		
+		key[0] = static_cast< uint32_t >( seed );
+		key[1] = static_cast< uint32_t >( seed >> 32 );
+		
+	}
+	
+	void CounterRNG::getUniformRanNums( const uint64_t &step , const uint64_t &atom_id , const RNG_STREAM &stream , const uint32_t &template_id , double *rnums ) const{
+		
+		/// Fills rnums with 2 random numbers uniformly distributed in (0,1). The same arguments always produce the same numbers.
+		/// @param[in] step current PAPRECA step.
+		/// @param[in] atom_id ID of the parent atom of the event candidate.
+		/// @param[in] stream random number stream (i.e., the kind of event candidate).
+		/// @param[in] template_id ID of the event template.
+		/// @param[in,out] rnums array of (at least) 2 doubles.
+		
+		uint32_t ctr[4] = { static_cast< uint32_t >( step ) , ( template_id << 1 ) | static_cast< uint32_t >( stream ) , static_cast< uint32_t >( atom_id ) , static_cast< uint32_t >( atom_id >> 32 ) };
+		uint32_t round_key[2] = { key[0] , key[1] };
+		philox4x32( ctr , round_key );
+		
+		rnums[0] = uint64ToUniform( ( static_cast< uint64_t >( ctr[0] ) << 32 ) | ctr[1] );
+		rnums[1] = uint64ToUniform( ( static_cast< uint64_t >( ctr[2] ) << 32 ) | ctr[3] );
+		
+	}
+	
+	void CounterRNG::philox4x32( uint32_t *ctr , uint32_t *key ){
+		
+		/// Applies the 10 rounds of the Philox4x32 bijection to ctr.
+		/// @param[in,out] ctr 4-element counter. Overwritten by the random output.
+		/// @param[in,out] key 2-element key. Bumped after every round.
+		
+		const uint32_t M0 = 0xD2511F53 , M1 = 0xCD9E8D57; //Multipliers
+		const uint32_t W0 = 0x9E3779B9 , W1 = 0xBB67AE85; //Key bumps (Weyl sequence)
+		
+		for( int round = 0; round < 10; ++round ){
+			
+			const uint64_t prod0 = static_cast< uint64_t >( M0 ) * ctr[0];
+			const uint64_t prod1 = static_cast< uint64_t >( M1 ) * ctr[2];
+			const uint32_t hi0 = static_cast< uint32_t >( prod0 >> 32 ) , lo0 = static_cast< uint32_t >( prod0 );
+			const uint32_t hi1 = static_cast< uint32_t >( prod1 >> 32 ) , lo1 = static_cast< uint32_t >( prod1 );
+			
+			ctr[0] = hi1 ^ ctr[1] ^ key[0];
+			ctr[1] = lo1;
+			ctr[2] = hi0 ^ ctr[3] ^ key[1];
+			ctr[3] = lo0;
+			
+			key[0] += W0;
+			key[1] += W1;
+			
+		}
+		
+	}
+	
+	double CounterRNG::uint64ToUniform( const uint64_t &bits ){
+		
+		/// @param[in] bits 64 random bits.
+		/// @return double uniformly distributed in (0,1). The 53 most significant bits are used (i.e., the full precision of a double).
+		
+		return ( static_cast< double >( bits >> 11 ) + 0.5 ) * ( 1.0 / 9007199254740992.0 ); //2^53
+		
+	}
+	
+	
+}//end of namespace PAPRECA
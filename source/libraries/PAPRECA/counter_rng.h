@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Declarations for PAPRECA::CounterRNG class producing counter-based (stateless) random numbers.
+
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+//System Headers
+#include <cstdint>
+
+namespace PAPRECA{
+	
+	/// Random number streams of PAPRECA::CounterRNG. Each stream is combined with a template ID, so that different event templates draw different numbers for the same atom.
+	enum RNG_STREAM{ RNG_STREAM_DEPOSITION = 0 , RNG_STREAM_DIFFUSION = 1 };
+	
+	class CounterRNG{
+		
+		/// @class PAPRECA::CounterRNG
+		/// @brief Counter-based random number generator (Philox4x32-10, see Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11).
+		///
+		/// Random numbers are not drawn from a sequence. Instead, they are a pure function of a key (the random seed) and a counter (the PAPRECA step, the ID of the parent atom, the random number stream, and the event template ID).
+		/// Hence, the random numbers of an event candidate do not depend on the MPI process (or OpenMP thread) detecting the candidate, or on the order in which candidates are detected.
+		
+		public:
+			//Constructors/Destructors
+			CounterRNG( );
+			~CounterRNG( );
+			
+			//Functions
+			void setSeed( const uint64_t &seed );
+			void getUniformRanNums( const uint64_t &step , const uint64_t &atom_id , const RNG_STREAM &stream , const uint32_t &template_id , double *rnums ) const;
+		
+		private:
+			static void philox4x32( uint32_t *ctr , uint32_t *key );
+			static double uint64ToUniform( const uint64_t &bits );
+			
+			uint32_t key[2] = { 0 , 0 }; ///< Philox key (i.e., the random seed).
+		
+	};
+	
+	
+}//end of namespace PAPRECA
+
+#endif
@@ -28,15 +28,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace PAPRECA{
 	
 	
-	void debugPrintBondMapPairs( ATOM2BONDS_MAP const &bonds_map , const int &proc_id ){
+	void debugPrintBondMapPairs( BondGraph const &bonds_map , const int &proc_id ){
 		if ( proc_id == 0 ){
-			for ( auto const &pair: bonds_map ) {
-				int parent_id = pair.first;
+			for ( int vertex = 0; vertex < bonds_map.getVerticesNum( ); ++vertex ) {
+				LAMMPS_NS::tagint parent_id = bonds_map.getVertexAtomID( vertex );
+				const BondRange bonds = bonds_map.getVertexBonds( vertex );
 				
 				std::cout << "This is the bond list of atom with id: " << parent_id << " on proc " << proc_id << std::endl;
-				std::cout << "~~~this bond list has " << pair.second.size( ) << " member(s) \n";
-				for ( auto const &bond : pair.second ){
-					std::cout <<  "			Atom " << pair.first << " HEADATOM1(?)= " << bond.parentAtomIsHead( ) << " is paired with atom " << bond.getBondAtom( ) << std::endl;
+				std::cout << "~~~this bond list has " << bonds.size( ) << " member(s) \n";
+				for ( auto const &bond : bonds ){
+					std::cout <<  "			Atom " << parent_id << " HEADATOM1(?)= " << bond.parentAtomIsHead( ) << " is paired with atom " << bond.getBondAtom( ) << std::endl;
 				}
 			}
 		}
@@ -95,7 +96,7 @@ namespace PAPRECA{
 		
 	}
 	
-	void debugCheckBondsInNeibLists( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , ATOM2BONDS_MAP &atomID2bonds){
+	void debugCheckBondsInNeibLists( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , BondGraph &atomID2bonds){
 		
 		int *atom_ids = lmp->atom->tag;
 		LAMMPS_NS::tagint **bond_ids = lmp->atom->bond_atom;
@@ -146,16 +147,16 @@ namespace PAPRECA{
 	void debugPrintEventInfo( Event *event , const int &proc_id ){
 		
 		
-		if( event->getType( ) == "RXN-BREAK" ){
-			BondBreak *bond_break = dynamic_cast<BondBreak*>( event );
+		if( event->getType( ) == EVENT_RXN_BREAK ){
+			BondBreak *bond_break = static_cast<BondBreak*>( event );
 			std::cout << "This is a bond breaking event between " << bond_break->getAtom1ID( ) << " and " << bond_break->getAtom2ID( ) << " of bond type " << bond_break->getBondType( ) << " with rate " << bond_break->getRate( ) << " on proc " << proc_id << std::endl;
-		}else if( event->getType( ) == "RXN-FORM" ){
-			BondForm *bond_form = dynamic_cast<BondForm*>( event );
+		}else if( event->getType( ) == EVENT_RXN_FORM ){
+			BondForm *bond_form = static_cast<BondForm*>( event );
 			std::cout << "This is a bond forming event between " << bond_form->getAtom1ID( ) << " and " << bond_form->getAtom2ID( ) << " of bond type " << bond_form->getBondType( ) << " with rate " << bond_form->getRate( ) << " on proc " << proc_id << std::endl;
-		}else if( event->getType( ) == "DEPO" ){
-			Deposition *deposition = dynamic_cast<Deposition*>( event );
-		}else if( event->getType( ) == "DIFF" ){
-			Diffusion *diffusion = dynamic_cast<Diffusion*>( event );
+		}else if( event->getType( ) == EVENT_DEPO ){
+			Deposition *deposition = static_cast<Deposition*>( event );
+		}else if( event->getType( ) == EVENT_DIFF ){
+			Diffusion *diffusion = static_cast<Diffusion*>( event );
 		
 		}
 		
@@ -46,10 +46,10 @@ namespace PAPRECA{
 	
 
 	
-	void debugPrintBondMapPairs( ATOM2BONDS_MAP const &bonds_map , const int &proc_num );
+	void debugPrintBondMapPairs( BondGraph const &bonds_map , const int &proc_num );
 	void debugPrintBasicAtomInfo( LAMMPS_NS::LAMMPS *lmp , const int &proc_id );
 	void debugPrintNeighborLists( LAMMPS_NS::LAMMPS *lmp , const int &proc_id );
-	void debugCheckBondsInNeibLists( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , ATOM2BONDS_MAP &atomID2bonds );
+	void debugCheckBondsInNeibLists( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , BondGraph &atomID2bonds );
 	void debugPrintBondsList( LAMMPS_NS::tagint *bonds_list , LAMMPS_NS::bigint &bonds_num , const int &proc_id );
 	void debugPrintType2SigmaMap( INTPAIR2DOUBLE_MAP &types2sigma );
 	void debugPrintEventInfo( Event *event , const int &proc_id );
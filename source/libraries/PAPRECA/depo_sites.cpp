@@ -0,0 +1,184 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Definitions for depo_sites.h.
+
+#include "depo_sites.h"
+#include "lammps_wrappers.h"
+
+namespace PAPRECA{
+	
+	//Constructors/Destructors
+	DepositionSiteGrid::DepositionSiteGrid( ){ }
+	DepositionSiteGrid::~DepositionSiteGrid( ){ }
+	
+	//Functions
+	void DepositionSiteGrid::reset( LAMMPS_NS::LAMMPS *lmp , const double &tolerance ){
+		
+		/// Removes all stored candidates and fits the columns grid to the current simulation box. Called before every event detection pass.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] tolerance candidates closer than tolerance are considered identical.
+		
+		for( const int &column : used_columns ){
+			column_centers[column].clear( );
+			column_keys[column].clear( );
+		}
+		used_columns.clear( );
+		
+		tolerance_sqr = tolerance * tolerance;
+		const double max_columns_num = 1024.0;
+		
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		triclinic = domain->triclinic;
+		for( int k = 0; k < 3; ++k ){ boxlo[k] = domain->boxlo[k]; }
+		for( int k = 0; k < 6; ++k ){ h_inv[k] = domain->h_inv[k]; }
+		
+		for( int k = 0; k < 2; ++k ){
+			
+			if( triclinic ){
+				//Two centers within the tolerance differ by at most tolerance*|row k of h_inv| in lamda coordinate k (lamda_x = h_inv[0]*dx + h_inv[5]*dy + h_inv[4]*dz, lamda_y = h_inv[1]*dy + h_inv[3]*dz).
+				const double lamda_tolerance = ( k == 0 ? tolerance * sqrt( h_inv[0] * h_inv[0] + h_inv[5] * h_inv[5] + h_inv[4] * h_inv[4] ) : tolerance * sqrt( h_inv[1] * h_inv[1] + h_inv[3] * h_inv[3] ) );
+				columns_num[k] = std::max( 1 , static_cast< int >( std::min( max_columns_num , 1.0 / lamda_tolerance ) ) );
+				columns_lo[k] = 0.0;
+				column_size[k] = 1.0 / columns_num[k]; //At least as wide as the tolerance (in lamda coordinates)
+			}else{
+				columns_num[k] = std::max( 1 , static_cast< int >( std::min( max_columns_num , domain->prd[k] / tolerance ) ) ); //Capped, so that very small tolerances do not produce huge grids
+				columns_lo[k] = domain->boxlo[k];
+				column_size[k] = domain->prd[k] / columns_num[k]; //At least as wide as the tolerance
+			}
+			periodic[k] = domain->periodicity[k];
+			
+		}
+		
+		const int total_columns = columns_num[0] * columns_num[1];
+		if( column_centers.size( ) != static_cast< size_t >( total_columns ) ){
+			column_centers.assign( total_columns , std::vector< double >( ) );
+			column_keys.assign( total_columns , std::vector< int >( ) );
+		}
+		
+	}
+	
+	const DEPO_SITE_STATUS DepositionSiteGrid::findSite( LAMMPS_NS::LAMMPS *lmp , const int &template_id , const double *center ) const{
+		
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] template_id ID of the deposition template (see PAPRECA::PredefinedDeposition::getTemplateID()).
+		/// @param[in] center coordinates of the candidate center.
+		/// @return PAPRECA::DEPO_SITE_FREE or PAPRECA::DEPO_SITE_BLOCKED if a candidate of the same template was stored within the tolerance of center (and was found free or blocked, respectively), or PAPRECA::DEPO_SITE_NONE otherwise.
+		
+		double coords[2];
+		getColumnCoords( center , coords );
+		const int ix = getColumnIndex( coords[0] , 0 );
+		const int iy = getColumnIndex( coords[1] , 1 );
+		
+		//Collect the (unique) indexes of adjacent columns along each direction
+		int column_ids[2][3] , ids_num[2];
+		const int icol[2] = { ix , iy };
+		for( int k = 0; k < 2; ++k ){
+			
+			ids_num[k] = 0;
+			for( int d = -1; d <= 1; ++d ){
+				
+				int id = icol[k] + d;
+				if( periodic[k] ){
+					id = ( id % columns_num[k] + columns_num[k] ) % columns_num[k];
+				}else if( id < 0 || id >= columns_num[k] ){
+					continue;
+				}
+				
+				bool exists = false;
+				for( int i = 0; i < ids_num[k]; ++i ){ if( column_ids[k][i] == id ){ exists = true; } }
+				if( !exists ){ column_ids[k][ids_num[k]++] = id; }
+				
+			}
+			
+		}
+		
+		for( int i = 0; i < ids_num[0]; ++i ){
+			for( int j = 0; j < ids_num[1]; ++j ){
+				
+				const int column = column_ids[1][j] * columns_num[0] + column_ids[0][i];
+				const std::vector< double > &centers = column_centers[column];
+				const std::vector< int > &keys = column_keys[column];
+				
+				for( size_t s = 0; s < keys.size( ); ++s ){
+					
+					if( ( keys[s] >> 1 ) != template_id ){ continue; }
+					if( get3DSqrDistWithPBC( lmp , center , &centers[3*s] ) <= tolerance_sqr ){ return( ( keys[s] & 1 ) ? DEPO_SITE_FREE : DEPO_SITE_BLOCKED ); }
+					
+				}
+				
+			}
+		}
+		
+		return DEPO_SITE_NONE;
+		
+	}
+	
+	void DepositionSiteGrid::insertSite( const int &template_id , const double *center , const bool &site_is_free ){
+		
+		/// @param[in] template_id ID of the deposition template (see PAPRECA::PredefinedDeposition::getTemplateID()).
+		/// @param[in] center coordinates of the candidate center.
+		/// @param[in] site_is_free true if the candidate passed the collision check, false otherwise.
+		
+		double coords[2];
+		getColumnCoords( center , coords );
+		const int column = getColumnIndex( coords[1] , 1 ) * columns_num[0] + getColumnIndex( coords[0] , 0 );
+		if( column_keys[column].empty( ) ){ used_columns.push_back( column ); }
+		
+		column_centers[column].insert( column_centers[column].end( ) , center , center + 3 );
+		column_keys[column].push_back( 2 * template_id + ( site_is_free ? 1 : 0 ) );
+		
+	}
+	
+	void DepositionSiteGrid::getColumnCoords( const double *center , double *coords ) const{
+		
+		/// @param[in] center coordinates of the candidate center.
+		/// @param[in,out] coords 2-element array filled with the x and y coordinates of center (or the x and y lamda coordinates of center, for triclinic boxes).
+		
+		if( !triclinic ){
+			coords[0] = center[0];
+			coords[1] = center[1];
+			return;
+		}
+		
+		const double dx = center[0] - boxlo[0];
+		const double dy = center[1] - boxlo[1];
+		const double dz = center[2] - boxlo[2];
+		coords[0] = h_inv[0] * dx + h_inv[5] * dy + h_inv[4] * dz;
+		coords[1] = h_inv[1] * dy + h_inv[3] * dz;
+		
+	}
+	
+	const int DepositionSiteGrid::getColumnIndex( const double &coord , const int &dim ) const{
+		
+		/// @param[in] coord x or y coordinate, or lamda coordinate for triclinic boxes (not necessarily inside the box, since candidate centers are not remapped).
+		/// @param[in] dim 0 for x and 1 for y.
+		/// @return column index along dim (wrapped for periodic and clamped for non-periodic directions).
+		
+		int id = static_cast< int >( std::floor( ( coord - columns_lo[dim] ) / column_size[dim] ) );
+		
+		if( periodic[dim] ){ return ( id % columns_num[dim] + columns_num[dim] ) % columns_num[dim]; }
+		
+		return std::min( std::max( id , 0 ) , columns_num[dim] - 1 );
+		
+	}
+	
+	
+}//end of namespace PAPRECA
@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Declarations for PAPRECA::DepositionSiteGrid class deduplicating deposition candidate sites.
+
+#ifndef DEPO_SITES_H
+#define DEPO_SITES_H
+
+//System Headers
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+//LAMMPS headers
+#include "lammps.h"
+/// \cond
+#include "domain.h"
+/// \endcond
+
+namespace PAPRECA{
+	
+	/// Status of a deposition candidate site in a PAPRECA::DepositionSiteGrid.
+	enum DEPO_SITE_STATUS{ DEPO_SITE_NONE = 0 , DEPO_SITE_BLOCKED = 1 , DEPO_SITE_FREE = 2 };
+	
+	class DepositionSiteGrid{
+		
+		/// @class PAPRECA::DepositionSiteGrid
+		/// @brief Deposition candidate sites checked during an event detection pass, binned in x-y columns of the simulation box.
+		///
+		/// On dense surfaces, many parent atoms produce almost identical deposition candidates (e.g., atoms of the same column below the top surface). Every checked candidate is stored in the column containing its center, together with its deposition template and the result of its collision check.
+		/// A new candidate whose center is within the tolerance of a stored candidate (of the same template) in the same or adjacent columns inherits the stored result, so its collision check is skipped and no duplicate deposition event is created (see PAPRECA::getDepoEventsFromAtom()).
+		/// @note Columns are at least as wide as the tolerance, so only the 3x3 block of columns around a candidate has to be searched. For triclinic boxes, the columns are defined in lamda (i.e., fractional) coordinates.
+		
+		public:
+			//Constructors/Destructors
+			DepositionSiteGrid( );
+			~DepositionSiteGrid( );
+			
+			//Functions
+			void reset( LAMMPS_NS::LAMMPS *lmp , const double &tolerance );
+			const DEPO_SITE_STATUS findSite( LAMMPS_NS::LAMMPS *lmp , const int &template_id , const double *center ) const;
+			void insertSite( const int &template_id , const double *center , const bool &site_is_free );
+		
+		private:
+			void getColumnCoords( const double *center , double *coords ) const;
+			const int getColumnIndex( const double &coord , const int &dim ) const;
+			
+			double tolerance_sqr = 0.0; ///< squared distance below which two candidate centers are considered identical.
+			double columns_lo[2] = { 0.0 , 0.0 }; ///< lower x and y bounds of the columns grid.
+			double column_size[2] = { 1.0 , 1.0 }; ///< x and y edges of each column.
+			int columns_num[2] = { 1 , 1 }; ///< number of columns along the x- and y-directions.
+			bool periodic[2] = { false , false }; ///< true if the box is periodic along the x-/y-direction (i.e., column indexes are wrapped).
+			bool triclinic = false; ///< true if the columns are defined in lamda coordinates (triclinic boxes).
+			double boxlo[3] = { 0.0 , 0.0 , 0.0 }; ///< lower bounds of the simulation box (triclinic boxes only).
+			double h_inv[6] = { 0.0 , 0.0 , 0.0 , 0.0 , 0.0 , 0.0 }; ///< inverse box matrix in LAMMPS (Voigt) ordering, used to convert coordinates to lamda coordinates (triclinic boxes only).
+			std::vector< std::vector< double > > column_centers; ///< centers (x,y,z triplets) of the candidates stored in each column.
+			std::vector< std::vector< int > > column_keys; ///< 2*template_id+1 for free and 2*template_id for blocked candidates stored in each column.
+			std::vector< int > used_columns; ///< columns with stored candidates (cleared on reset).
+		
+	};
+	
+	
+}//end of namespace PAPRECA
+
+#endif
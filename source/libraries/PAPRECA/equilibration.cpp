@@ -25,13 +25,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace PAPRECA{
 	
 	//Delete Desorbed atoms
-	void fillDelidsLocalVec( LAMMPS_NS::LAMMPS *lmp , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void fillDelidsLocalVec( LAMMPS_NS::LAMMPS *lmp , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids_local , BondGraph &atomID2bonds ){
 		
 		/// Called by deleteDesorbedAtoms() and only when the delete_desorbed algorithm is set to gather_local. The function compares the z-coordinate of an atom. If the atom z-value is higher than desorb_cut, the atom ID is marked for deletion (i.e., inserted in the delids_local container) and it is later deleted along with its bonded atoms (retrieved from atomID2bonds map).
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] desorb_cut cutoff distance for atom deletion. Atoms whose z-coordinate is equal to or greater than desorb_cut are marked for deletion.
 		/// @param[in,out] delids_local vector of collected atom IDs (delids_local will be different on each MPI process).
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::deleteDesorbedAtoms(), PAPRECA::Bond::recursiveCollectBondedAtoms()
 		/// @note When deleting an atom, all atoms bonded with the deleted atom have to be deleted as well. Otherwise, LAMMPS will likely throw a "Missing Bond Atoms in proc %d" error. See lammps documentation (https://docs.lammps.org/) for more information.
 		/// @note This function is not to be confused with fillDelidsVec(). fillDelidsVec() is only called when the user sets the delete_desorbed algorithm to gather_all, while this function (i.e., fillDelidsLocalVec() ) is called if the user set the delete_desorbed algorithm to gather_local.
@@ -139,14 +139,14 @@ namespace PAPRECA{
 		
 	}
 
-	int fillDelidsVec( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , ATOM2BONDS_MAP &atomID2bonds ){
+	int fillDelidsVec( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , BondGraph &atomID2bonds ){
 		
 		/// Called by deleteDesorbedAtoms() and only when the delete_desorbed algorithm is set to gather_all. The function compares the z-coordinate of an atom. If the atom z-coordinate is higher than desorb_cut, the atom ID is marked for deletion (i.e., inserted in the delids container) and it is deleted along with its bonded atoms (retrieved from atomID2bonds map). Here, a gather operation collects data from all atoms on the master MPI process (i.e., proc_id==0) before comparing the z-coordinates of atoms with desorb_cut.
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] proc_id ID of current MPI process.
 		/// @param[in] desorb_cut cutoff distance for atom deletion. Atoms whose z-coordinate is equal to or greater than desorb_cut are marked for deletion.
 		/// @param[in,out] delids vector of collected atom IDs on the master MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::deleteDesorbedAtoms(), PAPRECA::broadcastDelidsFromMasterProc(), PAPRECA::Bond::recursiveCollectBondedAtoms()
 		/// @note When deleting an atom, all atoms bonded with the deleted atom have to be deleted as well. Otherwise, LAMMPS will likely throw a "Missing Bond Atoms in proc %d" error. See lammps documentation (https://docs.lammps.org/) for more information.
 		/// @note This function is not to be confused with fillDelidsLocalVec(). fillDelidsLocalVec() is only called when the user sets the delete_desorbed algorithm to gather_local, while this function (i.e., fillDelidsVec() ) is called if the user set the delete_desorbed algorithm to gather_all.
@@ -216,16 +216,113 @@ namespace PAPRECA{
 		MPI_Bcast( delids.data( ) , delids_num , MPI_INT , 0 , MPI_COMM_WORLD );
 	}
 
-	void deleteDesorbedAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &proc_id , const int &nprocs , double &film_height , ATOM2BONDS_MAP &atomID2bonds ){	
+	void expandDelidsFrontier( std::vector< LAMMPS_NS::tagint > &frontier , TAGINT_SET &visited , std::vector< LAMMPS_NS::tagint > &found_local , BondGraph &atomID2bonds ){
 		
-		/// This function is always called but performs computations only if the user has set a desorption height cutoff in the PAPRECA input file. The present function compares the z-coordinate of each atom with the desorption height cutoff. If any z-coordinate value is greater than or equal to the desorption height cutoff, the associated atom (along with its bonded atoms) is deleted. Currently, the user can select between two different algorithms: 1) gather_local (see fillDelidsLocalVec() function description/notes), and 2) gather_all (see fillDelidsVec() function description/notes). A comparison of the performance between the two algorithms is not currently available. However, as a quick note, it can be mentioned that gather_all is expected to be more memory intensive, since it calls the LAMMPS function lammps_gather_atoms_concat() to gather the coordinates of non-consecutive IDs on the master proc.
+		/// Called by fillDelidsFilteredVec(). Performs a breadth-first search through the bonds known to the current MPI process (i.e., the bonds of local and ghost atoms), starting from the atom IDs in the frontier vector. Every newly discovered atom ID is inserted in found_local.
+		/// @param[in,out] frontier atom IDs from which the search starts. The vector is emptied by this function.
+		/// @param[in,out] visited std::unordered_set< LAMMPS_NS::tagint > of atom IDs already discovered on the current MPI process.
+		/// @param[in,out] found_local vector of atom IDs discovered by the current MPI process.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of local and ghost atoms (see PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()).
+		/// @see PAPRECA::fillDelidsFilteredVec()
+		
+		for( size_t head = 0; head < frontier.size( ); ++head ){
+			
+			const BondRange bonds = atomID2bonds.getBonds( frontier[head] );
+			for( const auto &bond : bonds ){
+				
+				const LAMMPS_NS::tagint bondatom_id = bond.getBondAtom( );
+				if( !elementIsInUnorderedSet( visited , bondatom_id ) ){
+					visited.insert( bondatom_id );
+					found_local.push_back( bondatom_id );
+					frontier.push_back( bondatom_id ); //Expanded later in the same loop
+				}
+			}
+		}
+		
+		frontier.clear( );
+		
+	}
+	
+	void fillDelidsFilteredVec( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , BondGraph &atomID2bonds ){
+		
+		/// Called by deleteDesorbedAtoms() and only when the delete_desorbed algorithm is set to gather_filtered. Only MPI processes whose sub-domain extends above desorb_cut compare the z-coordinates of their local atoms with desorb_cut. Then, the bonded atoms of the marked atoms are collected by a distributed breadth-first search over the bonds of local and ghost atoms: each MPI process expands the atoms it knows, the newly discovered IDs are exchanged between MPI processes, and the search continues until no MPI process discovers a new atom ID.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @param[in] desorb_cut cutoff distance for atom deletion. Atoms whose z-coordinate is equal to or greater than desorb_cut are marked for deletion.
+		/// @param[in,out] delids vector of collected atom IDs (contains the same data, in the same order, on each MPI process).
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of local and ghost atoms (see PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()).
+		/// @see PAPRECA::deleteDesorbedAtoms(), PAPRECA::expandDelidsFrontier()
+		/// @note Contrary to fillDelidsVec(), no per-atom data are gathered. Only the IDs of atoms marked for deletion are communicated between MPI processes. Hence, the memory footprint does not scale with the total number of atoms.
+		/// @note The bond adjacency of ghost atoms is complete (see FixPAPRECA::build_bond_adjacency()). Hence, a bonded cluster crossing sub-domain boundaries is collected in as many search rounds as the number of MPI processes it spans (at most).
+		
+		TAGINT_SET visited; //Atom IDs discovered on the current proc (either locally or through communication)
+		TAGINT_SET delids_set; //Atom IDs already in delids (identical on all procs)
+		std::vector< LAMMPS_NS::tagint > frontier;
+		std::vector< LAMMPS_NS::tagint > found_local;
+		
+		//Sub-domains below desorb_cut cannot own desorbed atoms, so those procs skip the scan. The sub-domain bounds of triclinic boxes are only maintained in lamda coordinates (the z lamda coordinate maps linearly to z).
+		const double subhi_z = ( lmp->domain->triclinic ? lmp->domain->boxlo[2] + lmp->domain->prd[2] * lmp->domain->subhi_lamda[2] : lmp->domain->subhi[2] );
+		if( subhi_z >= desorb_cut ){
+			
+			double **atom_xyz = lmp->atom->x;
+			LAMMPS_NS::tagint *atom_ids = lmp->atom->tag;
+			for( int i = 0; i < lmp->atom->nlocal; ++i ){
+				if( atom_xyz[i][2] >= desorb_cut && !elementIsInUnorderedSet( visited , atom_ids[i] ) ){
+					visited.insert( atom_ids[i] );
+					found_local.push_back( atom_ids[i] );
+					frontier.push_back( atom_ids[i] );
+				}
+			}
+		}
+		
+		std::vector< int > recv_counts( nprocs );
+		std::vector< int > displ( nprocs );
+		std::vector< LAMMPS_NS::tagint > found_global;
+		
+		while( true ){
+			
+			expandDelidsFrontier( frontier , visited , found_local , atomID2bonds );
+			
+			//Exchange the atom IDs discovered in this round
+			const int found_local_size = found_local.size( );
+			MPI_Allgather( &found_local_size , 1 , MPI_INT , recv_counts.data( ) , 1 , MPI_INT , MPI_COMM_WORLD );
+			
+			int num_gathered = 0;
+			for( int i = 0; i < nprocs; ++i ){
+				displ[i] = num_gathered;
+				num_gathered += recv_counts[i];
+			}
+			if( num_gathered == 0 ){ break; } //No proc discovered a new atom ID, so the search is complete (every proc exits in the same round)
+			
+			found_global.resize( num_gathered );
+			MPI_Allgatherv( found_local.data( ) , found_local_size , MPI_LMP_TAGINT , found_global.data( ) , recv_counts.data( ) , displ.data( ) , MPI_LMP_TAGINT , MPI_COMM_WORLD );
+			found_local.clear( );
+			
+			for( const auto &id : found_global ){
+				
+				if( elementIsInUnorderedSet( delids_set , id ) ){ continue; } //Same atom discovered by more than one proc
+				delids_set.insert( id );
+				delids.push_back( id );
+				
+				if( !elementIsInUnorderedSet( visited , id ) ){ //Discovered by another proc. Continue the search from here if the current proc knows the bonds of that atom
+					visited.insert( id );
+					if( lmp->atom->map( id ) >= 0 ){ frontier.push_back( id ); }
+				}
+			}
+		}
+		
+	}
+
+	void deleteDesorbedAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &proc_id , const int &nprocs , double &film_height , BondGraph &atomID2bonds ){	
+		
+		/// This function is always called but performs computations only if the user has set a desorption height cutoff in the PAPRECA input file. The present function compares the z-coordinate of each atom with the desorption height cutoff. If any z-coordinate value is greater than or equal to the desorption height cutoff, the associated atom (along with its bonded atoms) is deleted. Currently, the user can select between two different algorithms: 1) gather_local (see fillDelidsLocalVec() function description/notes), 2) gather_all (see fillDelidsVec() function description/notes), and 3) gather_filtered (see fillDelidsFilteredVec() function description/notes). A comparison of the performance between the two algorithms is not currently available. However, as a quick note, it can be mentioned that gather_all is expected to be more memory intensive, since it calls the LAMMPS function lammps_gather_atoms_concat() to gather the coordinates of non-consecutive IDs on the master proc. The gather_filtered algorithm avoids gathering atoms (and the bonds of the whole system) altogether.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] proc_id ID of current MPI process.
 		/// @param[in] nprocs total number of MPI processes.
 		/// @param[in] film_height height at current PAPRECA step.
-		/// @param[in,out] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @see PAPRECA::fillDelidsLocalVec(), PAPRECA::fillDelidsVec()
+		/// @param[in,out] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @see PAPRECA::fillDelidsLocalVec(), PAPRECA::fillDelidsVec(), PAPRECA::fillDelidsFilteredVec()
 		/// @note The user is advised to refer to the LAMMPS developer documentation (https://docs.lammps.org/) to understand how lammps_gather_atoms_concant works (called by gather_all deletion algorithm).
 		
 		if( papreca_config.getDesorptionHeight( ) == -1 ){ return; } //Immediately exit this function if the desorption height is not set by the user (i.e., if the desorption height in papreca config is equal to the default value (-1). No need to delete atoms in that case.
@@ -233,9 +330,13 @@ namespace PAPRECA{
 			
 		//Regardless of the trimming method Update bondslist and atomic positions
 		atomID2bonds.clear( );
-		runLammps( lmp , 0 ); //invoke run 0 to update neibors lists before gathering and deleting atoms
+		refreshLammps( lmp , papreca_config ); //update neighbor lists before gathering and deleting atoms (skipped if the system did not change since the last refresh)
 		//For molecular systems bond sort id is enabled by default. Hence, to use atomIDd2bonds maps we need to update our atomID2bonds maps. For non molecular systems IT MIGHT BE OK TO NOT UPDATE atomID2bonds but we do it anyway for safety.
-		PAPRECA::Bond::initAtomID2BondsMap( lmp , proc_id , atomID2bonds );
+		if( papreca_config.getDesorptionStyle( ) == "gather_filtered" ){ //The distributed search only requires the bonds of local and ghost atoms (non-molecular systems have no bonds to collect).
+			if( lmp->atom->molecular == LAMMPS_NS::Atom::MOLECULAR ){ PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms( lmp , atomID2bonds ); }
+		}else{
+			PAPRECA::Bond::initAtomID2BondsMap( lmp , proc_id , atomID2bonds );
+		}
 		
 		
 		if( papreca_config.getDesorptionStyle( ) == "gather_local" ){ //Gather local means that we go through all atoms on all procs to find desorbed atoms. Then we gather all trim ids in the master proc and process (to avoid duplicate deletion ids).
@@ -251,8 +352,9 @@ namespace PAPRECA{
 				
 				gatherAndTrimDelIdsOnDriverProc( proc_id , nprocs , delids_local , delids_global );
 				if( delids_global.size( ) <= papreca_config.getDesorbDelMax( ) ){ //Only delete atoms if the number of delids is smaller than the permitted (by the used) maximum number of atoms that can be deleted at once.
-					deleteAtoms( lmp , delids_global , "no" , "no" );
-					resetMobileAtomsGroups( lmp , papreca_config );
+					deleteAtoms( lmp , delids_global , "no" , "no" , papreca_config.nativeExecutionIsActive( ) );
+					papreca_config.setLammpsSystemModified( );
+					if( !papreca_config.nativeExecutionIsActive( ) ){ resetMobileAtomsGroups( lmp , papreca_config ); } //Group bits are stored per atom, so deleted atoms leave their groups without any group maintenance
 				}
 			}
 			
@@ -265,15 +367,28 @@ namespace PAPRECA{
 			if( delids_num != 0 ){
 				broadcastDelidsFromMasterProc( lmp , proc_id , delids_num , delids );
 				if( delids_num <= papreca_config.getDesorbDelMax( ) ){
-					deleteAtoms( lmp , delids , "no" , "no" );
-					resetMobileAtomsGroups( lmp , papreca_config );
+					deleteAtoms( lmp , delids , "no" , "no" , papreca_config.nativeExecutionIsActive( ) );
+					papreca_config.setLammpsSystemModified( );
+					if( !papreca_config.nativeExecutionIsActive( ) ){ resetMobileAtomsGroups( lmp , papreca_config ); } //Group bits are stored per atom, so deleted atoms leave their groups without any group maintenance
 				}
 			}
+		}else if( papreca_config.getDesorptionStyle( ) == "gather_filtered" ){ //Gather filtered means that only procs above desorb_cut look for desorbed atoms, and only the IDs of atoms marked for deletion are communicated.
+			
+			std::vector< LAMMPS_NS::tagint > delids;
+			fillDelidsFilteredVec( lmp , nprocs , desorb_cut , delids , atomID2bonds );
+			
+			if( !delids.empty( ) && delids.size( ) <= static_cast< size_t >( papreca_config.getDesorbDelMax( ) ) ){ //delids is identical on all procs, so all procs take the same branch
+				deleteAtoms( lmp , delids , "no" , "no" , papreca_config.nativeExecutionIsActive( ) );
+				papreca_config.setLammpsSystemModified( );
+				if( !papreca_config.nativeExecutionIsActive( ) ){ resetMobileAtomsGroups( lmp , papreca_config ); } //Group bits are stored per atom, so deleted atoms leave their groups without any group maintenance
+			}
+			
 		}else if( papreca_config.getDesorptionStyle( ) == "LAMMPS_region" ){
 			
 			if( desorb_cut < lmp->domain->boxhi[2] ){
 				deleteAtomsInBoxRegion( lmp , lmp->domain->boxlo[0] , lmp->domain->boxhi[0] , lmp->domain->boxlo[1] , lmp->domain->boxhi[1] , desorb_cut , lmp->domain->boxhi[2] , "yes" , "no" );
-				resetMobileAtomsGroups( lmp , papreca_config );
+				papreca_config.setLammpsSystemModified( );
+				if( !papreca_config.nativeExecutionIsActive( ) ){ resetMobileAtomsGroups( lmp , papreca_config ); } //Group bits are stored per atom, so deleted atoms leave their groups without any group maintenance
 			}
 		
 		}else if( !papreca_config.getDesorptionStyle( ).empty( ) ){
@@ -283,11 +398,11 @@ namespace PAPRECA{
 	}
 
 	//Equilibration
-	void collectBondedAtoms4NveLimitedGroup( PaprecaConfig &papreca_config , ATOM2BONDS_MAP &atomID2bonds ){
+	void collectBondedAtoms4NveLimitedGroup( PaprecaConfig &papreca_config , BondGraph &atomID2bonds ){
 		
 		/// Collects (implicitly) bonded atoms to IDs already located in the nvelim_ids TAGINT_VEC
 		/// @param[in,out] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @note Here, all procs do identical operations to collect bonded atoms. The alternative would be to collect bonded atoms on master proc and then communicate information to remaining procs. This is not necessarily faster, but could be tested in the future.
 		/// @note This function occasionally collects the same atom ID twice. This does not lead to any errors since LAMMPS discards ID duplicates during group creation (i.e., nve_limited). However, would be nice to test in the future and understand why we collect certain IDs twice
 		
@@ -311,29 +426,43 @@ namespace PAPRECA{
 		
 	}
 	
-	void equilibrateNveLimitedAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double &time , ATOM2BONDS_MAP &atomID2bonds ){
+	void equilibrateNveLimitedAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double &time , BondGraph &atomID2bonds ){
 		
 		/// Performs a LAMMPS simulation on the fluid atom types (as defined in the PAPRECA input) with a separate nve/limit integration on specific (reacted atoms).
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in,out] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in,out] time current time.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::runLammps()
 
 		if( papreca_config.nveLimGroupsAreActive( ) && !papreca_config.nveLimGroupIsEmpty( ) ){
 			
 			
 			//Prepare for run
-			collectBondedAtoms4NveLimitedGroup( papreca_config , atomID2bonds );
-			resetMobileAtomsGroups4NveLimIntegration( lmp , papreca_config );
-			setupNveLimIntegrator( lmp , papreca_config );
+			if( papreca_config.localBondAdjacencyIsActive( ) ){ //atomID2bonds only stores the bonds of local/ghost atoms. Collecting bonded atoms requires the bonds of the whole system.
+				BondGraph atomID2bonds_global;
+				PAPRECA::Bond::initAtomID2BondsMap( lmp , getMPIRank( MPI_COMM_WORLD ) , atomID2bonds_global );
+				collectBondedAtoms4NveLimitedGroup( papreca_config , atomID2bonds_global );
+			}else{
+				collectBondedAtoms4NveLimitedGroup( papreca_config , atomID2bonds );
+			}
+			if( papreca_config.nveLimIsPersistent( ) ){ //The integrator is already installed. Group bits are set directly (if possible).
+				if( !setNveLimitedGroupNative( lmp , papreca_config.getNveLimIdsVec( ) ) ){ resetMobileAtomsGroups4NveLimIntegration( lmp , papreca_config ); }
+			}else{
+				resetMobileAtomsGroups4NveLimIntegration( lmp , papreca_config );
+				setupNveLimIntegrator( lmp , papreca_config );
+			}
 			
 			//Run for given steps
 			runLammps( lmp , papreca_config.getNveLimSteps( ) );
 			
 			
 			//Post run operations
-			removeNveLimIntegrator( lmp , papreca_config );
+			if( papreca_config.nveLimIsPersistent( ) ){ //Empty the nve_limited group, so the persistent integrator does not act on any atoms during the remaining MD stage.
+				if( !clearGroupNative( lmp , "nve_limited" ) ){ lmp->input->one( "group nve_limited clear" ); }
+			}else{
+				removeNveLimIntegrator( lmp , papreca_config );
+			}
 			papreca_config.clearNveLimGroup( ); //Clears atom IDs from PAPRECA's internal TAGINT_VEC and NOT from the actual group in LAMMPS
 			resetMobileAtomsGroups( lmp , papreca_config ); //We now call the normal reset atoms function that places all mobile atoms in group fluid.
 															//Note that, atoms will remain in the nve_limited group. However, since the nve/limit integrator is removed
@@ -345,15 +474,171 @@ namespace PAPRECA{
 		
 	}
 	
-	void equilibrateFluidAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double &time , const std::string &traj_type ,  ATOM2BONDS_MAP &atomID2bonds ){
+	void fillLocalRelaxIdsVec( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector< LAMMPS_NS::tagint > &relax_ids ){
+		
+		/// Collects the IDs of all fluid atoms lying within the local_relax radius of the points touched by events executed since the last MD stage. Each MPI process scans its local atoms, and the collected IDs are then gathered on all MPI processes.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] event_catalog object of the PAPRECA::EventCatalog class storing the relaxation points.
+		/// @param[in,out] relax_ids vector of collected atom IDs (identical on all MPI processes).
+		/// @see PAPRECA::equilibrateFluidAtoms(), PAPRECA::EventCatalog::getRelaxPoints()
+		/// @note Relaxation points are identical on all MPI processes, since they were gathered by PAPRECA::EventCatalog::gatherRelaxPoints() before this call. Only local atoms are scanned, so every atom is collected by exactly one MPI process.
+		
+		double **atom_xyz = ( double **)lammps_extract_atom( lmp , "x" );
+		int *atom_type = ( int *)lammps_extract_atom( lmp , "type" );
+		LAMMPS_NS::tagint *atom_ids = ( LAMMPS_NS::tagint *)lammps_extract_atom( lmp , "id" );
+		const int nlocal = *( ( int *)lammps_extract_global( lmp , "nlocal" ) );
+		const std::vector< int > &fluid_atomtypes = papreca_config.getFluidAtomTypes( );
+		const std::vector< ARRAY3D > &relax_points = event_catalog.getRelaxPoints( );
+		const double relax_sqr = papreca_config.getLocalRelaxRadius( ) * papreca_config.getLocalRelaxRadius( );
+		
+		std::vector< LAMMPS_NS::tagint > relax_ids_local;
+		for( int i = 0; i < nlocal; ++i ){
+			
+			if( std::find( fluid_atomtypes.begin( ) , fluid_atomtypes.end( ) , atom_type[i] ) == fluid_atomtypes.end( ) ){ continue; }
+			for( const auto &point : relax_points ){
+				if( get3DSqrDistWithPBC( lmp , atom_xyz[i] , point.data( ) ) <= relax_sqr ){
+					relax_ids_local.push_back( atom_ids[i] );
+					break;
+				}
+			}
+		}
+		
+		//Gather the collected IDs on all MPI processes (every process needs the full list to define the LAMMPS group).
+		const int relax_ids_local_size = relax_ids_local.size( );
+		std::vector< int > recv_counts( nprocs );
+		std::vector< int > displ( nprocs );
+		MPI_Allgather( &relax_ids_local_size , 1 , MPI_INT , recv_counts.data( ) , 1 , MPI_INT , MPI_COMM_WORLD );
+		
+		int num_gathered = 0;
+		for( int i = 0; i < nprocs; ++i ){
+			displ[i] = num_gathered;
+			num_gathered += recv_counts[i];
+		}
+		
+		relax_ids.resize( num_gathered );
+		MPI_Allgatherv( relax_ids_local.data( ) , relax_ids_local_size , MPI_LMP_TAGINT , relax_ids.data( ) , recv_counts.data( ) , displ.data( ) , MPI_LMP_TAGINT , MPI_COMM_WORLD );
+		
+	}
+	
+	void saveGroupPositions( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name , TAG2POS_MAP &positions ){
+		
+		/// Stores the coordinates of all local atoms of a LAMMPS group (keyed by atom ID).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] group_name name of LAMMPS group.
+		/// @param[in,out] positions map of atom IDs to coordinates (cleared before filling).
+		/// @see PAPRECA::getMaxGroupDisplacement()
+		
+		const int igroup = lmp->group->find( group_name );
+		if( igroup == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not find group " + group_name + " in saveGroupPositions function (equilibration.cpp)." ); }
+		const int groupbit = lmp->group->bitmask[igroup];
+		
+		double **atom_xyz = lmp->atom->x;
+		int *atom_mask = lmp->atom->mask;
+		LAMMPS_NS::tagint *atom_ids = lmp->atom->tag;
+		const int nlocal = lmp->atom->nlocal;
+		
+		positions.clear( );
+		for( int i = 0; i < nlocal; ++i ){
+			if( atom_mask[i] & groupbit ){ positions[atom_ids[i]] = { atom_xyz[i][0] , atom_xyz[i][1] , atom_xyz[i][2] }; }
+		}
+		
+	}
+	
+	double getMaxGroupDisplacement( LAMMPS_NS::LAMMPS *lmp , const TAG2POS_MAP &positions ){
+		
+		/// Calculates the maximum displacement of the atoms stored by PAPRECA::saveGroupPositions().
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] positions map of atom IDs to coordinates (as stored before the last trajectory chunk).
+		/// @return maximum displacement (in LAMMPS distance units) on all MPI processes. Infinity is returned if the displacement of any stored atom cannot be resolved.
+		/// @note Atoms that migrated to another MPI process during the chunk are resolved through their ghost copies (via the atom map). Displacements are calculated with the minimum image convention, so a chunk should not be long enough for atoms to travel half a box length.
+		
+		if( lmp->atom->map_style == 0 ){ return std::numeric_limits< double >::infinity( ); } //No atom map. Displacements cannot be resolved, so the trajectory is never considered converged (map_style is identical on all MPI processes, so all procs skip the reduction below).
+		
+		double **atom_xyz = lmp->atom->x;
+		
+		double disp_sqr_max_local = 0.0;
+		for( const auto &it : positions ){
+			const int iatom = lmp->atom->map( it.first );
+			if( iatom < 0 ){ //Atom travelled beyond the ghost cutoff of this MPI process
+				disp_sqr_max_local = std::numeric_limits< double >::infinity( );
+				break;
+			}
+			disp_sqr_max_local = std::max( disp_sqr_max_local , get3DSqrDistWithPBC( lmp , atom_xyz[iatom] , it.second.data( ) ) );
+		}
+		
+		double disp_sqr_max;
+		MPI_Allreduce( &disp_sqr_max_local , &disp_sqr_max , 1 , MPI_DOUBLE , MPI_MAX , MPI_COMM_WORLD );
+		
+		return sqrt( disp_sqr_max );
+		
+	}
+	
+	int runAdaptiveTrajectory( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &max_steps ){
+		
+		/// Runs a LAMMPS trajectory of at most max_steps in chunks (of adaptive_md_chunk steps). After each chunk, the convergence metric (as set in the adaptive_md command) is evaluated and the trajectory stops if the metric is smaller than or equal to the tolerance.
+		/// The available metrics are evaluated on the fluid group (i.e., only on the atoms around executed events, if local_relax is active):
+		/// 1) fmax: maximum force on fluid atoms at the end of the chunk,
+		/// 2) disp: maximum displacement of fluid atoms during the chunk,
+		/// 3) pe: absolute change of the total potential energy during the chunk (at least two chunks are run, since the potential energy is only known after a run).
+		/// @param[in,out] lmp pointer to LAMMPS object.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] max_steps maximum number of timesteps (i.e., trajectory duration).
+		/// @return number of timesteps actually run.
+		/// @see PAPRECA::equilibrateFluidAtoms(), PAPRECA::advanceSimClockFromLAMMPSSteps()
+		
+		const int chunk = papreca_config.getAdaptiveMDChunk( );
+		const std::string &metric = papreca_config.getAdaptiveMDMetric( );
+		const double &tol = papreca_config.getAdaptiveMDTolerance( );
+		
+		int steps_run = 0;
+		double pe_last = 0.0;
+		TAG2POS_MAP positions;
+		
+		while( steps_run < max_steps ){
+			
+			const int steps = std::min( chunk , max_steps - steps_run );
+			if( metric == "disp" ){ saveGroupPositions( lmp , "fluid" , positions ); }
+			runLammpsChunk( lmp , steps , steps_run == 0 );
+			steps_run += steps;
+			
+			double value;
+			if( metric == "fmax" ){
+				value = getMaxForceInGroup( lmp , "fluid" );
+			}else if( metric == "disp" ){
+				value = getMaxGroupDisplacement( lmp , positions );
+			}else if( metric == "pe" ){
+				const double pe = getPotentialEnergy( lmp );
+				value = ( steps_run == steps ? std::numeric_limits< double >::infinity( ) : fabs( pe - pe_last ) ); //No reference energy after the first chunk
+				pe_last = pe;
+			}else{
+				allAbortWithMessage( MPI_COMM_WORLD , "Unknown adaptive_md metric " + metric + " in runAdaptiveTrajectory function (equilibration.cpp)." );
+			}
+			
+			if( value <= tol ){ break; }
+			
+		}
+		
+		return steps_run;
+		
+	}
+	
+	void equilibrateFluidAtoms( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , PaprecaConfig &papreca_config , double &time , const std::string &traj_type , const bool &local_relax , EventCatalog &event_catalog , BondGraph &atomID2bonds ){
 		
 		/// Performs a LAMMPS simulation on the fluid atom types (as defined in the PAPRECA input). Then, updates the simulation clock by timestep*trajectory_duration (as defined by the user in the LAMMPS and PAPRECA inputs). Additionally, might perform minimizations before/after the LAMMPS trajectory (if an appropriate LAMMPS minimization command is defined by the user).
+		/// If local_relax is true, the trajectory only integrates the fluid atoms within the local_relax radius of the points touched since the last MD stage (see PAPRECA::fillLocalRelaxIdsVec()). All other atoms are held frozen (but still exert forces on the integrated atoms).
 		/// @param[in,out] lmp pointer to LAMMPS object.
+		/// @param[in] nprocs total number of MPI processes.
 		/// @param[in,out] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in,out] time current time.
 		/// @param[in] traj_type denoting type of trajectory to decide how many steps will be run in the LAMMPS MD run. Can either be "normal" or "long".
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] local_relax true if only the fluid atoms around the touched points are integrated, or false otherwise.
+		/// @param[in] event_catalog object of the PAPRECA::EventCatalog class storing the relaxation points.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::runLammps()
+		/// If adaptive_md is active, normal trajectories stop as soon as they converge (see PAPRECA::runAdaptiveTrajectory()) and the simulation clock is only advanced by the timesteps actually run.
+		/// @note The nve/limit stage (if any) and the minimizations are always performed on the whole system. The simulation clock is advanced by the full trajectory duration regardless of local_relax.
 		
 		
 		resetMobileAtomsGroups( lmp , papreca_config ); //Reset mobile atom groups (i.e., add/remove atoms from the fluid group so you can be ready to run LAMMPS.
@@ -364,22 +649,34 @@ namespace PAPRECA{
 		//Set up nve limited groups and run limited trajectory if required
 		equilibrateNveLimitedAtoms( lmp , papreca_config , time , atomID2bonds );
 		
+		//Restrict the fluid group to the atoms around the touched points (localized relaxation)
+		if( local_relax ){
+			std::vector< LAMMPS_NS::tagint > relax_ids;
+			fillLocalRelaxIdsVec( lmp , nprocs , papreca_config , event_catalog , relax_ids );
+			resetMobileAtomsGroups4LocalRelaxation( lmp , papreca_config , relax_ids );
+		}
+		
 		//Run trajectory based on trajectory type and advance simulation clock
 		if( traj_type == "long" ){
 			runLammps( lmp , papreca_config.getLongTrajDuration( ) );
+			advanceSimClockFromLAMMPS( papreca_config , time , traj_type );
+		}else if( traj_type == "normal" && papreca_config.adaptiveMDIsActive( ) ){
+			const int steps_run = runAdaptiveTrajectory( lmp , papreca_config , papreca_config.getTrajDuration( ) );
+			advanceSimClockFromLAMMPSSteps( papreca_config , time , steps_run );
 		}else if( traj_type == "normal" ){
 			runLammps( lmp , papreca_config.getTrajDuration( ) );
+			advanceSimClockFromLAMMPS( papreca_config , time , traj_type );
 		}else{
 			allAbortWithMessage( MPI_COMM_WORLD , "Unrecognized traj_type in equilibrateFluidAtoms function in equilibration.cpp)." );
 		}
-		advanceSimClockFromLAMMPS( papreca_config , time , traj_type );
+		if( local_relax ){ resetMobileAtomsGroups( lmp , papreca_config ); }
 
 		//Minimization (after trajectory)
 		if( !papreca_config.getMinimize2( ).empty( ) ){ lmp->input->one( papreca_config.getMinimize2( ).c_str( ) ); }
 		
 	}
 	
-	void equilibrate( LAMMPS_NS::LAMMPS *lmp , int &proc_id , const int &nprocs , double &time , PaprecaConfig &papreca_config , double &film_height , int &zero_rate , const int &KMC_loopid , ATOM2BONDS_MAP &atomID2bonds ){
+	void equilibrate( LAMMPS_NS::LAMMPS *lmp , int &proc_id , const int &nprocs , double &time , PaprecaConfig &papreca_config , double &film_height , int &zero_rate , const int &KMC_loopid , BondGraph &atomID2bonds , EventCatalog &event_catalog ){
 
 		/// This function performs a LAMMPS run on the current system configuration, every KMC_per_MD (as set by the user in the PAPRECA input file). Then, it deletes atoms whose z-coordinate is equal to or greater than the desorption height cutoff (defined in the PAPRECA input file).
 		/// @param[in,out] lmp pointer to LAMMPS object.
@@ -390,9 +687,11 @@ namespace PAPRECA{
 		/// @param[in] film_height current PAPRECA simulation height.
 		/// @param[in] zero_rate 0 if the total event rate at the current step is zero, or 1 otherwise.
 		/// @param[in] KMC_loopid current PAPRECA simulation step.
-		/// @param[in,out] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the points touched since the last MD stage (used for localized relaxation).
 		/// @see PAPRECA::equilibrateFluidAtoms(), PAPRECA::deleteDesorbedAtoms()
 		/// @note The function also calculates the execution times during the LAMMPS (MD) step (if the executionTimes file has been activated in the PAPRECA input file).
+		/// @note If local_relax is active, normal trajectories are localized around the points touched since the last MD stage. Long trajectories, trajectories on steps with zero total rate, and trajectories following events that could not be resolved to touched points are always global.
 		
 		
 		std::string traj_type;
@@ -412,8 +711,14 @@ namespace PAPRECA{
 		
 		//If we did not exit with traj_type "none", perform equilibration
 		papreca_config.setMDTimeStamp4ExecTimeFile( KMC_loopid );
-		equilibrateFluidAtoms( lmp , papreca_config , time , traj_type , atomID2bonds );
-		papreca_config.calcMDTime4ExecTimeFile( nprocs , KMC_loopid );
+		bool local_relax = false;
+		if( papreca_config.localRelaxIsActive( ) && traj_type == "normal" && !zero_rate ){
+			event_catalog.gatherRelaxPoints( nprocs ); //Touched atoms are only resolved to points on MPI processes that know them. All procs have to take the same decision below.
+			local_relax = event_catalog.relaxPointsAreResolved( );
+		}
+		equilibrateFluidAtoms( lmp , nprocs , papreca_config , time , traj_type , local_relax , event_catalog , atomID2bonds );
+		event_catalog.clearRelaxPoints( );
+		papreca_config.calcMDTime4ExecTimeFile( KMC_loopid );
 		deleteDesorbedAtoms( lmp , papreca_config , proc_id , nprocs , film_height , atomID2bonds );
 		
 	}
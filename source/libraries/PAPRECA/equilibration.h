@@ -26,6 +26,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 //System Headers
 #include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <limits>
+#include <cmath>
 #include <mpi.h>
 
 
@@ -38,24 +42,33 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 //KMC headers
 #include "bond.h"
+#include "event_catalog.h"
 #include "papreca_config.h"
 #include "lammps_wrappers.h"
 #include "sim_clock.h"
 #include "utilities.h"
 
 namespace PAPRECA{
+	
+	typedef std::unordered_map< LAMMPS_NS::tagint , ARRAY3D > TAG2POS_MAP;
 
 	//Delete desorbed atoms
-	void fillDelidsLocalVec( LAMMPS_NS::LAMMPS *lmp , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids_local , ATOM2BONDS_MAP &atomID2bonds );
+	void fillDelidsLocalVec( LAMMPS_NS::LAMMPS *lmp , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids_local , BondGraph &atomID2bonds );
 	bool delidsLocalVectorsAreEmpty( std::vector< LAMMPS_NS::tagint > &delids_local );
 	void gatherAndTrimDelIdsOnDriverProc( const int &proc_id , const int &nprocs , std::vector< LAMMPS_NS::tagint > &delids_local , std::vector< LAMMPS_NS::tagint > &delids_global );
-	int fillDelidsVec( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , ATOM2BONDS_MAP &atomID2bonds );
+	int fillDelidsVec( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , BondGraph &atomID2bonds );
 	void broadcastDelidsFromMasterProc( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &delids_num , std::vector< LAMMPS_NS::tagint > &delids );
+	void expandDelidsFrontier( std::vector< LAMMPS_NS::tagint > &frontier , TAGINT_SET &visited , std::vector< LAMMPS_NS::tagint > &found_local , BondGraph &atomID2bonds );
+	void fillDelidsFilteredVec( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , const double &desorb_cut , std::vector< LAMMPS_NS::tagint > &delids , BondGraph &atomID2bonds );
 		
 	//Equilibration
 	void equilibrateNveLimitedAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double &time );
-	void equilibrateFluidAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double &time , const unsigned long int &trajectory_duration);
-	void equilibrate( LAMMPS_NS::LAMMPS *lmp , int &proc_id , const int &nprocs , double &time , PaprecaConfig &papreca_config , double &film_height , int &zero_rate , const int &KMC_loopid , ATOM2BONDS_MAP &atomID2bonds );
+	void fillLocalRelaxIdsVec( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector< LAMMPS_NS::tagint > &relax_ids );
+	void saveGroupPositions( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name , TAG2POS_MAP &positions );
+	double getMaxGroupDisplacement( LAMMPS_NS::LAMMPS *lmp , const TAG2POS_MAP &positions );
+	int runAdaptiveTrajectory( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &max_steps );
+	void equilibrateFluidAtoms( LAMMPS_NS::LAMMPS *lmp , const int &nprocs , PaprecaConfig &papreca_config , double &time , const std::string &traj_type , const bool &local_relax , EventCatalog &event_catalog , BondGraph &atomID2bonds );
+	void equilibrate( LAMMPS_NS::LAMMPS *lmp , int &proc_id , const int &nprocs , double &time , PaprecaConfig &papreca_config , double &film_height , int &zero_rate , const int &KMC_loopid , BondGraph &atomID2bonds , EventCatalog &event_catalog );
 	
 }//end of PAPRECA namespace 
 
@@ -28,16 +28,17 @@ namespace PAPRECA{
 
 	//---------------------------------------PARENT Event class---------------------------------------
 	//Constructors/Destructors
-	Event::Event( ): rate( 0.0 ), type( "NONE" ){ }
-	Event::Event( const double &rate_in , const std::string &type_in ): rate( rate_in ), type( type_in ){ }
+	Event::Event( ): rate( 0.0 ), type( EVENT_NONE ){ }
+	Event::Event( const double &rate_in , const EVENT_TYPE &type_in ): rate( rate_in ), type( type_in ){ }
 	Event::~Event( ){ };
 	
 	//Member functions
 	void Event::assignRate( const double &rate_in ){ rate = rate_in; }
-	void Event::assignType( const std::string &type_in ){ type = type_in; }
+	void Event::assignType( const EVENT_TYPE &type_in ){ type = type_in; }
 	const double &Event::getRate( )const{ return rate; }
 	void Event::setRate( const double &rate_in ){ rate = rate_in; }
-	const std::string &Event::getType( )const{ return type; }
+	const EVENT_TYPE &Event::getType( )const{ return type; }
+	const char *Event::getTypeName( )const{ return getTypeName( type ); }
 	
 	//Static functions
 	void Event::fillRatesArr( double *event_rates , const std::vector< Event* > &events ){
@@ -98,35 +99,87 @@ namespace PAPRECA{
 	
 	void  Event::deleteAndClearLocalEvents( LAMMPS_NS::LAMMPS *lmp , std::vector<Event*> &events_local ){
 		
-		/// Deletes all local events (different on each MPI process) and clears the events_local vector of PAPRECA::Event objects.
+		/// Releases all events of events_local back to their pools (see PAPRECA::EventPool) and clears the events_local vector of PAPRECA::Event objects. Used when only some of the events of the current MPI process have to be deleted (e.g., by the PAPRECA::EventCatalog).
 		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] events_local vector containing PAPRECA::Event objects (created by Event::newEvent()).
+		/// @see Event::resetEventPoolsAndClearLocalEvents()
+		
+		for( const auto &event : events_local ){ releaseEvent( event ); }
+		
+		//Reset the vector and prepare for the next kMC step
+		events_local.clear( ); //Clear the vector
+
+	}
+	
+	void Event::resetEventPoolsAndClearLocalEvents( std::vector<Event*> &events_local ){
+		
+		/// Deletes all local events (different on each MPI process) and clears the events_local vector of PAPRECA::Event objects. All event pools are reset at once (i.e., in O(1) time), so this function invalidates ALL events created by Event::newEvent() on the current MPI process.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @note Must not be used if events are stored between PAPRECA steps (i.e., if a PAPRECA::EventCatalog is active). Use Event::deleteAndClearLocalEvents() instead.
 		
+		resetEventPools( );
+		events_local.clear( );
 		
-		for( const auto &event : events_local ){
-			
-			if( event->getType( ) == "RXN-BREAK" ){
-				BondBreak *bond_break = dynamic_cast<BondBreak*>( event );
-				delete bond_break;		
-			}else if( event->getType( ) == "RXN-FORM" ){
-				BondForm *bond_form = dynamic_cast<BondForm*>( event );
-				delete bond_form;	
-			}else if( event->getType( ) == "DEPO" ){
-				Deposition *deposition = dynamic_cast<Deposition*>( event );
-				delete deposition;			
-			}else if( event->getType( ) == "DIFF" ){
-				Diffusion *diffusion = dynamic_cast<Diffusion*>( event );
-				delete diffusion;
-			}else if( event->getType( ) == "MONO-DES" ){
-				MonoatomicDesorption *monodes = dynamic_cast<MonoatomicDesorption*>( event );
-				delete monodes;
-			}
+	}
+	
+	const char *Event::getTypeName( const EVENT_TYPE &type_in ){
+		
+		/// @param[in] type_in type of event.
+		/// @return printed name of event type (e.g., "DEPO"). Used in PAPRECA export files.
 		
+		switch( type_in ){
+			case EVENT_RXN: return "RXN";
+			case EVENT_RXN_BREAK: return "RXN-BREAK";
+			case EVENT_RXN_FORM: return "RXN-FORM";
+			case EVENT_DEPO: return "DEPO";
+			case EVENT_DIFF: return "DIFF";
+			case EVENT_MONO_DES: return "MONO-DES";
+			default: return "NONE";
 		}
 		
-		//Reset the vector and prepare for the next kMC step
-		events_local.clear( ); //Clear the vector
-
+	}
+	
+	//Event pools
+	void Event::releaseEvent( Event *event ){
+		
+		/// Returns a single event to the pool of its type (see PAPRECA::EventPool).
+		/// @param[in] event pointer to event created by Event::newEvent().
+		
+		switch( event->getType( ) ){
+			case EVENT_RXN_BREAK: getEventPool< BondBreak >( ).release( static_cast< BondBreak* >( event ) ); break;
+			case EVENT_RXN_FORM: getEventPool< BondForm >( ).release( static_cast< BondForm* >( event ) ); break;
+			case EVENT_DEPO: getEventPool< Deposition >( ).release( static_cast< Deposition* >( event ) ); break;
+			case EVENT_DIFF: getEventPool< Diffusion >( ).release( static_cast< Diffusion* >( event ) ); break;
+			case EVENT_MONO_DES: getEventPool< MonoatomicDesorption >( ).release( static_cast< MonoatomicDesorption* >( event ) ); break;
+			default: allAbortWithMessage( MPI_COMM_WORLD , "Attempted to release event of unknown type in Event::releaseEvent function (event.cpp)." );
+		}
+		
+	}
+	
+	void Event::resetEventPools( ){
+		
+		/// Makes all slots of all event pools available for reuse (see PAPRECA::EventPool::reset()).
+		
+		for( auto &pool : getEventPools< BondBreak >( ) ){ pool.reset( ); }
+		for( auto &pool : getEventPools< BondForm >( ) ){ pool.reset( ); }
+		for( auto &pool : getEventPools< Deposition >( ) ){ pool.reset( ); }
+		for( auto &pool : getEventPools< Diffusion >( ) ){ pool.reset( ); }
+		for( auto &pool : getEventPools< MonoatomicDesorption >( ) ){ pool.reset( ); }
+		
+	}
+	
+	void Event::initEventPools( const int &threads_num ){
+		
+		/// Allocates one pool per event type and OpenMP thread. Has to be called before any event is created.
+		/// @param[in] threads_num number of OpenMP threads used for event detection.
+		/// @note Events released by Event::releaseEvent() are returned to the pool of the calling thread. Slots are never moved between pools, so pointers to events remain valid.
+		
+		getEventPools< BondBreak >( ).resize( threads_num );
+		getEventPools< BondForm >( ).resize( threads_num );
+		getEventPools< Deposition >( ).resize( threads_num );
+		getEventPools< Diffusion >( ).resize( threads_num );
+		getEventPools< MonoatomicDesorption >( ).resize( threads_num );
+		
 	}
 	
 	//---------------------------------------END OF PARENT Event Class---------------------------------------
@@ -136,7 +189,7 @@ namespace PAPRECA{
 	
 	//---------------------------------------------Reaction class---------------------------------------------
 	//Child class constructor
-	Reaction::Reaction( const double &rate_in , const LAMMPS_NS::tagint &atom1id_in , const LAMMPS_NS::tagint &atom2id_in , const int &bond_type_in ): Event::Event( rate_in , "RXN" ) , atom1id( atom1id_in ) , atom2id( atom2id_in ) , bond_type( bond_type_in ){ }
+	Reaction::Reaction( const double &rate_in , const LAMMPS_NS::tagint &atom1id_in , const LAMMPS_NS::tagint &atom2id_in , const int &bond_type_in ): Event::Event( rate_in , EVENT_RXN ) , atom1id( atom1id_in ) , atom2id( atom2id_in ) , bond_type( bond_type_in ){ }
 	Reaction::~Reaction( ){ }
 	
 	//Functions
@@ -175,7 +228,7 @@ namespace PAPRECA{
 	//----------------------------------------------BondBreak class----------------------------------------------
 	//Constructors/Destructors
 	BondBreak::BondBreak( const double &rate_in , const LAMMPS_NS::tagint &atom1id_in , const LAMMPS_NS::tagint &atom2id_in , const int &bond_type_in , PredefinedReaction *break_template_in ): Reaction::Reaction( rate_in , atom1id_in , atom2id_in , bond_type_in ) , break_template( break_template_in ){
-		type += "-BREAK"; //Update initialized reaction type from RXN to RXN-BREAK
+		type = EVENT_RXN_BREAK; //Update initialized reaction type from RXN to RXN-BREAK
 	}
 	BondBreak::~BondBreak( ){ }
 	
@@ -191,7 +244,7 @@ namespace PAPRECA{
 	//-----------------------------------------------BondForm Class-----------------------------------------------
 	//Constructors/Destructors
 	BondForm::BondForm( const double &rate_in , const LAMMPS_NS::tagint &atom1id_in , const LAMMPS_NS::tagint &atom2id_in , const int &bond_type_in , PredefinedBondForm *form_template_in ): Reaction::Reaction( rate_in , atom1id_in , atom2id_in , bond_type_in ) , form_template( form_template_in ){
-		type += "-FORM"; //Update initialized reaction type from RXN to RXN-FORM
+		type = EVENT_RXN_FORM; //Update initialized reaction type from RXN to RXN-FORM
 	}
 	BondForm::~BondForm( ){ }
 	
@@ -205,7 +258,7 @@ namespace PAPRECA{
 	
 	//------------------------------------------CHILD Deposition Class------------------------------------------
 	//Constructors/Destructors
-	Deposition::Deposition( const double &rate_in , const double site_pos_in[3] , const double rot_pos_in[3] , const double &rot_theta_in , const int &mol_id_in , const std::string &mol_name_in , PredefinedDeposition *depo_template_in ) :  Event::Event( rate_in , "DEPO" ) , rot_theta( rot_theta_in ) , mol_id( mol_id_in ) , mol_name( mol_name_in ) , depo_template( depo_template_in ){
+	Deposition::Deposition( const double &rate_in , const double site_pos_in[3] , const double rot_pos_in[3] , const double &rot_theta_in , const int &mol_id_in , PredefinedDeposition *depo_template_in ) :  Event::Event( rate_in , EVENT_DEPO ) , rot_theta( rot_theta_in ) , mol_id( mol_id_in ) , depo_template( depo_template_in ){
 		copyDoubleArray3D( site_pos , site_pos_in );
 		copyDoubleArray3D( rot_pos , rot_pos_in );
 	}
@@ -216,7 +269,7 @@ namespace PAPRECA{
 	double *Deposition::getRotPos( ){ return rot_pos; };
 	const double &Deposition::getRotTheta( )const{ return rot_theta; };
 	const int &Deposition::getMolId( )const{ return mol_id; };
-	const std::string &Deposition::getMolName( )const{ return mol_name; };
+	const std::string &Deposition::getMolName( )const{ return depo_template->getAdsorbateName( ); }; //The adsorbate name is stored once in the predefined template instead of being copied into every detected event.
 	PredefinedDeposition *Deposition::getDepoTemplate( ){ return depo_template; }
 	//---------------------------------------END OF CHILD Deposition Class---------------------------------------
 	
@@ -225,7 +278,7 @@ namespace PAPRECA{
 	
 	//-------------------------------------------CHILD Diffusion CLASS-------------------------------------------
 	//Constructors/Destructors
-	Diffusion::Diffusion( const double &rate_in , const double vacancy_pos_in[3] , const double parent_pos_in[3] , const LAMMPS_NS::tagint &parent_id_in , const int &parent_type_in , const int &diffused_type_in , PredefinedDiffusionHop *diff_template_in ) : Event::Event( rate_in , "DIFF" ) , parent_id( parent_id_in ), parent_type( parent_type_in ) , diffused_type( diffused_type_in ) , diff_template( diff_template_in ){ 
+	Diffusion::Diffusion( const double &rate_in , const double vacancy_pos_in[3] , const double parent_pos_in[3] , const LAMMPS_NS::tagint &parent_id_in , const int &parent_type_in , const int &diffused_type_in , PredefinedDiffusionHop *diff_template_in ) : Event::Event( rate_in , EVENT_DIFF ) , parent_id( parent_id_in ), parent_type( parent_type_in ) , diffused_type( diffused_type_in ) , diff_template( diff_template_in ){ 
 		copyDoubleArray3D( vacancy_pos , vacancy_pos_in );
 		copyDoubleArray3D( parent_pos , parent_pos_in );
 	};
@@ -242,7 +295,7 @@ namespace PAPRECA{
 	
 	//-----------------------------------------CHILD MonoatomicDesorption Class-----------------------------------------
 	//Constructors/Destructors
-	MonoatomicDesorption::MonoatomicDesorption( const double &rate_in , const LAMMPS_NS::tagint &parent_id_in , const int &parent_type_in , PredefinedMonoatomicDesorption *des_template_in ) : Event::Event( rate_in , "MONO-DES" ) , parent_id( parent_id_in ) , parent_type( parent_type_in ) , monodes_template( des_template_in ){ }
+	MonoatomicDesorption::MonoatomicDesorption( const double &rate_in , const LAMMPS_NS::tagint &parent_id_in , const int &parent_type_in , PredefinedMonoatomicDesorption *des_template_in ) : Event::Event( rate_in , EVENT_MONO_DES ) , parent_id( parent_id_in ) , parent_type( parent_type_in ) , monodes_template( des_template_in ){ }
 	MonoatomicDesorption::~MonoatomicDesorption( ){ }
 	
 	//Functions
@@ -27,6 +27,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 //System Headers
 #include <array>
 #include <vector>
+#include <deque>
+#include <utility>
 #include <mpi.h>
 
 
@@ -43,6 +45,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 	
+	/// Types of PAPRECA::Event objects. Used for dispatch (instead of comparing strings and/or casting dynamically). The printed names of types are returned by PAPRECA::Event::getTypeName().
+	enum EVENT_TYPE{ EVENT_NONE , EVENT_RXN , EVENT_RXN_BREAK , EVENT_RXN_FORM , EVENT_DEPO , EVENT_DIFF , EVENT_MONO_DES };
+	
+	template< typename T > class EventPool;
+	
 	class Event{
 	
 		/// @class PAPRECA::Event
@@ -59,15 +66,16 @@ namespace PAPRECA{
 		
 			//Constructors/Destructors
 			Event( );
-			Event( const double &rate_in , const std::string &type_in );
+			Event( const double &rate_in , const EVENT_TYPE &type_in );
 			virtual ~Event( ); // Virtual destructor to ensure proper clean-up of derived classes
 			
 			//functions
 			void assignRate( const double &rate_in );
-			void assignType( const std::string &type_in );
+			void assignType( const EVENT_TYPE &type_in );
 			const double &getRate( ) const;
 			void setRate( const double &rate_in );
-			const std::string &getType( ) const;
+			const EVENT_TYPE &getType( ) const;
+			const char *getTypeName( ) const;
 			
 			//Static functions
 			static void fillRatesArr( double *event_rates , const std::vector< Event* > &events );
@@ -75,10 +83,22 @@ namespace PAPRECA{
 			static std::vector< double > getRatesVec( const std::vector< Event* > &events ); //This is a static function (i.e., is not bound to an instance of class Event). You can provide an events* vector here to get a (copy) rates vec.
 			static double getSumOfRates( const std::vector< Event* > &events ); //This function uses the getRatesVec function and calculates the sum of all rates
 			static void deleteAndClearLocalEvents( LAMMPS_NS::LAMMPS *lmp , std::vector<Event*> &events_local );
+			static void resetEventPoolsAndClearLocalEvents( std::vector<Event*> &events_local );
+			static const char *getTypeName( const EVENT_TYPE &type_in );
+			
+			//Event pools
+			template< typename T , typename... Args > static T *newEvent( Args&&... args );
+			static void releaseEvent( Event *event );
+			static void resetEventPools( );
+			static void initEventPools( const int &threads_num );
 			
 		protected:
 			double rate;
-			std::string type;
+			EVENT_TYPE type;
+			
+		private:
+			template< typename T > static std::vector< EventPool< T > > &getEventPools( );
+			template< typename T > static EventPool< T > &getEventPool( );
 	
 	};
 	
@@ -159,7 +179,7 @@ namespace PAPRECA{
 		public:
 		
 			//Child class constructor/destructor
-			Deposition( const double &rate_in , const double site_pos_in[3] , const double rot_pos_in[3] , const double &rot_theta_in , const int &mol_id_in , const std::string &mol_name_in , PredefinedDeposition *depo_template_in );
+			Deposition( const double &rate_in , const double site_pos_in[3] , const double rot_pos_in[3] , const double &rot_theta_in , const int &mol_id_in , PredefinedDeposition *depo_template_in );
 			~Deposition( );
 			
 			//Functions
@@ -176,7 +196,6 @@ namespace PAPRECA{
 			double rot_pos[3]; //Required by create_atoms command with the mol option, defines the centre of rotation of the inserted molecule (angle in degrees).
 			double rot_theta;
 			int mol_id;
-			std::string mol_name = "NONE";
 			
 			
 		private:
@@ -239,6 +258,78 @@ namespace PAPRECA{
 			PredefinedMonoatomicDesorption *monodes_template = NULL;	
 		
 	};
+	
+	
+	template< typename T >
+	class EventPool{
+		
+		/// @class PAPRECA::EventPool
+		/// @brief Pooled storage for PAPRECA::Event objects of a single type (e.g., PAPRECA::Deposition).
+		///
+		/// Detected events are constructed in previously allocated slots of the pool instead of being allocated on the heap (i.e., with new) one by one. Slots are stored in a std::deque, so pointers to events remain valid when the pool grows.
+		/// All slots can be reused at once through reset() (i.e., at the end of every PAPRECA step), or one by one through release() (i.e., for events stored in a PAPRECA::EventCatalog between PAPRECA steps).
+		
+		public:
+			
+			template< typename... Args > T *acquire( Args&&... args ){
+				
+				/// @param[in] args arguments forwarded to the constructor of T.
+				/// @return pointer to a constructed event of type T. The event is owned by the pool.
+				
+				if( !released.empty( ) ){ //Reuse a released slot first
+					T *event = released.back( );
+					released.pop_back( );
+					*event = T( std::forward< Args >( args )... );
+					return event;
+				}
+				
+				if( used < events.size( ) ){
+					events[used] = T( std::forward< Args >( args )... );
+				}else{
+					events.emplace_back( std::forward< Args >( args )... );
+				}
+				
+				return &events[used++];
+				
+			}
+			
+			void release( T *event ){ released.push_back( event ); } ///< Makes the slot of a single event available for reuse.
+			void reset( ){ used = 0; released.clear( ); } ///< Makes all slots available for reuse. Slots are kept allocated for the next PAPRECA step.
+			
+		private:
+			std::deque< T > events; ///< Slots of the pool. Only the first used slots are in use (excluding released slots).
+			size_t used = 0; ///< Number of slots handed out since the last reset.
+			std::vector< T* > released; ///< Slots released through release() that can be reused before new slots are handed out.
+		
+	};
+	
+	template< typename T > std::vector< EventPool< T > > &Event::getEventPools( ){
+		
+		/// @return the (per MPI process) pools of events of type T. There is one pool per OpenMP thread (see Event::initEventPools()).
+		
+		static std::vector< EventPool< T > > pools( 1 );
+		return pools;
+		
+	}
+	
+	template< typename T > EventPool< T > &Event::getEventPool( ){
+		
+		/// @return the pool of events of type T of the calling OpenMP thread. Hence, events can be created concurrently during threaded event detection (see PAPRECA::loopAtomsAndIdentifyEventsWithThreads()).
+		
+		return getEventPools< T >( )[getThreadID( )];
+		
+	}
+	
+	template< typename T , typename... Args > T *Event::newEvent( Args&&... args ){
+		
+		/// Constructs a new event of type T in the pool of type T (see PAPRECA::EventPool). Used instead of new when detecting events.
+		/// @param[in] args arguments forwarded to the constructor of T.
+		/// @return pointer to the new event.
+		/// @note Events created with this function must NOT be deleted. Use Event::deleteAndClearLocalEvents() or Event::resetEventPoolsAndClearLocalEvents() instead.
+		
+		return getEventPool< T >( ).acquire( std::forward< Args >( args )... );
+		
+	}
 
 }//end of PAPRECA namespace 
 
@@ -0,0 +1,409 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Definitions for the PAPRECA::EventCatalog class.
+
+#include "event_catalog.h"
+
+namespace PAPRECA{
+
+	//Constructors/Destructors
+	EventCatalog::EventCatalog( ){ }
+	EventCatalog::~EventCatalog( ){
+
+		//Events are stored in the event pools by the event detection functions (see event_detect.cpp and PAPRECA::Event::newEvent()). Hence, we have to release them here.
+		for( auto &it : atomID2events ){
+			for( Event *event : it.second ){ Event::releaseEvent( event ); }
+		}
+
+	}
+
+	//Activation
+	void EventCatalog::activate( ){ active = true; }
+	const bool &EventCatalog::isActive( ) const{ return active; }
+
+	//Rebuild control
+	const bool EventCatalog::fullRebuildIsRequired( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double &film_height ) const{
+
+		/// Decides whether all atoms have to be rescanned on the current PAPRECA step or if it is safe to rescan only the atoms in the vicinity of touched atoms.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] film_height film height at the current PAPRECA step.
+		/// @return true if a full rescan is required or false otherwise.
+		/// @note All checks depend on global quantities (i.e., quantities that are identical on all MPI processes). Hence, all MPI processes always reach the same decision.
+
+		if( rebuild_requested ){ return true; }
+
+		if( lmp->update->ntimestep != ntimestep_last ){ return true; } //The LAMMPS timestep only advances during MD stages (or minimizations). A run 0 does not advance the timestep.
+
+		for( int i = 0; i < 3; ++i ){
+			if( lmp->domain->boxlo[i] != boxlo_last[i] || lmp->domain->boxhi[i] != boxhi_last[i] ){ return true; } //e.g., after a call to adjustSimulationBoxZvacuum()
+		}
+
+		if( ( papreca_config.getHeightDepoScan( ) != -1 || papreca_config.getHeightDepoReject( ) != -1 ) && film_height != film_height_last ){ return true; } //Deposition candidates depend on the film height only if depoheights are set.
+
+		if( papreca_config.getSurfaceCoverageFile( ).isActive( ) || papreca_config.predefinedCatalogHasVariableStickingDepositions( ) ){ return true; } //Deposition tries/sites are zeroed after every step (see PaprecaConfig::calcStickingCoeffs()) so they have to be recounted from all atoms.
+
+		return false;
+
+	}
+
+	void EventCatalog::requestFullRebuild( ){ rebuild_requested = true; }
+
+	void EventCatalog::saveRebuildState( LAMMPS_NS::LAMMPS *lmp , const double &film_height ){
+
+		/// Stores the quantities used by EventCatalog::fullRebuildIsRequired() at the end of a catalog update.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] film_height film height at the current PAPRECA step.
+
+		rebuild_requested = false;
+		ntimestep_last = lmp->update->ntimestep;
+		for( int i = 0; i < 3; ++i ){
+			boxlo_last[i] = lmp->domain->boxlo[i];
+			boxhi_last[i] = lmp->domain->boxhi[i];
+		}
+		film_height_last = film_height;
+
+	}
+
+	//Touched atoms
+	void EventCatalog::markTouchedPoint( const double *point ){
+
+		/// Stores the coordinates of a point touched by an executed event. All local atoms within the neighbor cutoff of the point are rescanned on the next catalog update.
+		/// @param[in] point 3-element array of coordinates.
+
+		if( relax_tracking ){ relax_points.push_back( { point[0] , point[1] , point[2] } ); }
+		if( !active && !batch_tracking ){ return; }
+		touched_points.push_back( { point[0] , point[1] , point[2] } );
+
+	}
+
+	void EventCatalog::markTouchedAtoms( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint *atom_ids , const int &num_atoms ){
+
+		/// Stores the current coordinates of the atoms touched by an executed event.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] atom_ids array of touched atom IDs.
+		/// @param[in] num_atoms number of touched atom IDs.
+		/// @note This function has to be called BEFORE the event is executed (i.e., before the touched atoms are moved or deleted).
+		/// @note An atom is known (as local or ghost atom) to every MPI process owning atoms within the neighbor cutoff of that atom. MPI processes that cannot map the touched atom to a local index have no local atoms to rescan.
+
+		if( !active && !batch_tracking && !relax_tracking ){ return; }
+
+		if( lmp->atom->map_style == 0 ){ //No atom map (e.g., atomic systems without atom_modify map). Touched IDs cannot be resolved to coordinates, so we have to rescan everything.
+			requestFullRebuild( );
+			batch_broken = true;
+			relax_broken = true;
+			return;
+		}
+
+		double **atom_xyz = ( double **)lammps_extract_atom( lmp , "x" );
+		for( int i = 0; i < num_atoms; ++i ){
+			const int iatom = lmp->atom->map( atom_ids[i] ); //local or ghost index (or -1 if the atom is unknown to this MPI process).
+			if( iatom >= 0 ){ markTouchedPoint( atom_xyz[iatom] ); }
+		}
+
+	}
+
+	void EventCatalog::markDeletedAtoms( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint *atom_ids , const int &num_atoms ){
+
+		/// Stores the current coordinates of atoms that are about to be deleted by an executed event.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] atom_ids array of IDs of atoms to be deleted.
+		/// @param[in] num_atoms number of atoms to be deleted.
+		/// @note For atomic systems, the LAMMPS delete_atoms command re-assigns all atom IDs (compress yes). In that case, the catalog (which is keyed by atom IDs) is invalidated and a full rescan is requested.
+		/// @see PAPRECA::deleteAtoms()
+
+		if( !active && !batch_tracking && !relax_tracking ){ return; }
+
+		markTouchedAtoms( lmp , atom_ids , num_atoms );
+		if( lmp->atom->molecular == LAMMPS_NS::Atom::ATOMIC ){
+			requestFullRebuild( );
+			batch_broken = true;
+		}
+
+	}
+
+	void EventCatalog::markTouchedMolecule( LAMMPS_NS::LAMMPS *lmp , const double *site_pos , const char *mol_name ){
+
+		/// Stores the coordinates of all atoms of a molecule inserted at site_pos (see PAPRECA::insertMolecule()).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] site_pos coordinates of the molecule insertion site.
+		/// @param[in] mol_name name of LAMMPS molecule template.
+		/// @note Molecules are inserted without rotation, so the coordinates of molecule atoms are site_pos + dx (as in PAPRECA::getMolCoords()).
+
+		if( !active && !batch_tracking && !relax_tracking ){ return; }
+
+		markTouchedPoint( site_pos );
+
+		const int imol = lmp->atom->find_molecule( mol_name );
+		if( imol == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not find molecule template in markTouchedMolecule function (event_catalog.cpp)." ); }
+		LAMMPS_NS::Molecule *mol = lmp->atom->molecules[imol];
+
+		double atom_xyz[3];
+		for( int i = 0; i < mol->natoms; ++i ){
+			for( int j = 0; j < 3; ++j ){
+				atom_xyz[j] = site_pos[j] + mol->dx[i][j];
+			}
+			markTouchedPoint( atom_xyz );
+		}
+
+	}
+
+	void EventCatalog::fillDirtyAtomsVec( LAMMPS_NS::LAMMPS *lmp , std::vector< char > &dirty_atoms , const bool &full_rebuild ){
+
+		/// Marks the local atoms that have to be rescanned on the current PAPRECA step. Dirty atoms are: 1) atoms within the neighbor cutoff of a touched point, and 2) local atoms that are not in the catalog (e.g., inserted atoms or atoms that migrated from another MPI process).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] dirty_atoms vector of nlocal flags (1 if the local atom has to be rescanned or 0 otherwise).
+		/// @param[in] full_rebuild if true, all local atoms are marked as dirty.
+		/// @note The neighbor cutoff (i.e., force cutoff + skin) is used because all event detection functions only access atoms in the neighbor lists of the parent atom.
+
+		const int nlocal = *( ( int *)lammps_extract_global( lmp , "nlocal" ) );
+		dirty_atoms.assign( nlocal , full_rebuild ? 1 : 0 );
+
+		if( !full_rebuild ){
+
+			LAMMPS_NS::tagint *atom_ids = ( LAMMPS_NS::tagint *)lammps_extract_atom( lmp , "id" );
+			double **atom_xyz = ( double **)lammps_extract_atom( lmp , "x" );
+			const double cut_sqr = lmp->neighbor->cutneighmax * lmp->neighbor->cutneighmax;
+
+			for( int i = 0; i < nlocal; ++i ){
+
+				if( !mappingExists( atomID2events , atom_ids[i] ) ){
+					dirty_atoms[i] = 1;
+					continue;
+				}
+
+				for( const auto &point : touched_points ){
+					if( get3DSqrDistWithPBC( lmp , atom_xyz[i] , point.data( ) ) <= cut_sqr ){
+						dirty_atoms[i] = 1;
+						break;
+					}
+				}
+			}
+		}
+
+		touched_points.clear( );
+
+	}
+
+	//Event batching
+	void EventCatalog::startEventBatch( ){
+
+		/// Starts recording touched points for a new batch of events. Has to be called right after event detection (i.e., when events_local is up to date).
+		/// @see PAPRECA::continueEventBatch(), EventCatalog::removeBatchInvalidatedEvents()
+
+		batch_tracking = true;
+		batch_broken = false;
+		touched_points.clear( ); //If the catalog is active, touched points were already consumed by EventCatalog::fillDirtyAtomsVec() during detection.
+
+	}
+
+	const bool EventCatalog::removeBatchInvalidatedEvents( LAMMPS_NS::LAMMPS *lmp , std::vector< Event* > &events_local ){
+
+		/// Removes from events_local all events that might have been invalidated (or whose rates might have changed) by the events executed since the last EventCatalog::startEventBatch().
+		/// An event is removed if any atom it depends on lies within the neighbor cutoff of a touched point, or if any of its atoms is no longer known to the current MPI process. For depositions, the reach of the inserted molecule (i.e., depo_offset + bounding radius) is added to the neighbor cutoff.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @return false if the executed events could not be resolved to touched points (then, the batch has to end) or true otherwise.
+		/// @note Removed events are not deleted. They are still owned by the catalog (if active) or by the event pools.
+		/// @note Touched points are known to all MPI processes (events are executed everywhere, see PAPRECA::executeEventRecord()). Hence, ghost copies of touched atoms are handled consistently.
+
+		if( batch_broken ){ return false; }
+		if( touched_points.empty( ) ){ return true; }
+
+		const double cut = lmp->neighbor->cutneighmax;
+		double **atom_xyz = lmp->atom->x;
+
+		auto pointIsTouched = [&]( const double *pos , const double &reach ){
+			const double reach_sqr = reach * reach;
+			for( const auto &point : touched_points ){
+				if( get3DSqrDistWithPBC( lmp , pos , point.data( ) ) <= reach_sqr ){ return true; }
+			}
+			return false;
+		};
+
+		auto atomIsTouched = [&]( const LAMMPS_NS::tagint &atom_id ){
+			const int iatom = lmp->atom->map( atom_id );
+			if( iatom < 0 ){ return true; } //Deleted atom (or atom unknown to the current MPI process).
+			return pointIsTouched( atom_xyz[iatom] , cut );
+		};
+
+		auto eventIsInvalidated = [&]( Event *event ){
+			switch( event->getType( ) ){
+				case EVENT_DEPO:{
+					Deposition *depo = static_cast< Deposition* >( event );
+					PredefinedDeposition *depo_template = depo->getDepoTemplate( );
+					return pointIsTouched( depo->getSitePos( ) , cut + depo_template->getDepoOffset( ) + depo_template->getBoundingRadius( ) );
+				}
+				case EVENT_DIFF:{
+					Diffusion *diff = static_cast< Diffusion* >( event );
+					return atomIsTouched( diff->getParentId( ) ) || pointIsTouched( diff->getParentPos( ) , cut ) || pointIsTouched( diff->getVacancyPos( ) , cut );
+				}
+				case EVENT_RXN_FORM:
+				case EVENT_RXN_BREAK:{
+					Reaction *rxn = static_cast< Reaction* >( event );
+					return atomIsTouched( rxn->getAtom1ID( ) ) || atomIsTouched( rxn->getAtom2ID( ) );
+				}
+				case EVENT_MONO_DES:
+					return atomIsTouched( static_cast< MonoatomicDesorption* >( event )->getParentId( ) );
+				default:
+					allAbortWithMessage( MPI_COMM_WORLD , "Unknown event type " + std::to_string( event->getType( ) ) + " in removeBatchInvalidatedEvents function in event_catalog.cpp." );
+			}
+			return true;
+		};
+
+		events_local.erase( std::remove_if( events_local.begin( ) , events_local.end( ) , eventIsInvalidated ) , events_local.end( ) );
+
+		return true;
+
+	}
+
+	//Localized relaxation
+	void EventCatalog::startRelaxTracking( ){
+		
+		/// Starts recording the points touched by executed events for localized relaxation (see PAPRECA::equilibrateFluidAtoms()). Relaxation points are recorded regardless of whether the catalog is active and are only cleared after an MD stage.
+		/// @see EventCatalog::clearRelaxPoints()
+		
+		relax_tracking = true;
+		
+	}
+	
+	void EventCatalog::gatherRelaxPoints( const int &nprocs ){
+		
+		/// Gathers the relaxation points recorded by all MPI processes on every MPI process. Touched atoms are only resolved to coordinates on the MPI processes that know them (as local or ghost atoms), so the recorded points differ between MPI processes before this call. Has to be called on all MPI processes before relaxPointsAreResolved() and getRelaxPoints().
+		/// @param[in] nprocs total number of MPI processes.
+		/// @see PAPRECA::equilibrate(), PAPRECA::fillLocalRelaxIdsVec()
+		/// @note The same atom can be recorded by more than one MPI process (e.g., as a local atom and as a ghost atom). Duplicate points do not affect the relaxed region, so they are not removed.
+		
+		int broken_local = relax_broken;
+		int broken_global;
+		MPI_Allreduce( &broken_local , &broken_global , 1 , MPI_INT , MPI_LOR , MPI_COMM_WORLD );
+		relax_broken = broken_global;
+		
+		std::vector< double > points_local;
+		points_local.reserve( 3 * relax_points.size( ) );
+		for( const auto &point : relax_points ){
+			points_local.insert( points_local.end( ) , point.begin( ) , point.end( ) );
+		}
+		
+		const int points_local_size = points_local.size( );
+		std::vector< int > recv_counts( nprocs );
+		std::vector< int > displ( nprocs );
+		MPI_Allgather( &points_local_size , 1 , MPI_INT , recv_counts.data( ) , 1 , MPI_INT , MPI_COMM_WORLD );
+		
+		int num_gathered = 0;
+		for( int i = 0; i < nprocs; ++i ){
+			displ[i] = num_gathered;
+			num_gathered += recv_counts[i];
+		}
+		
+		std::vector< double > points_global( num_gathered );
+		MPI_Allgatherv( points_local.data( ) , points_local_size , MPI_DOUBLE , points_global.data( ) , recv_counts.data( ) , displ.data( ) , MPI_DOUBLE , MPI_COMM_WORLD );
+		
+		relax_points.resize( num_gathered / 3 );
+		for( size_t i = 0; i < relax_points.size( ); ++i ){
+			relax_points[i] = { points_global[3*i] , points_global[3*i+1] , points_global[3*i+2] };
+		}
+		
+	}
+	
+	const bool EventCatalog::relaxPointsAreResolved( ) const{
+		
+		/// @return true if all events executed since the last MD stage were resolved to relaxation points and at least one point was recorded, or false otherwise (then, the next MD stage has to be global).
+		/// @note The returned value is only identical on all MPI processes after gatherRelaxPoints().
+		
+		return( relax_tracking && !relax_broken && !relax_points.empty( ) );
+		
+	}
+	
+	const std::vector< ARRAY3D > &EventCatalog::getRelaxPoints( ) const{ return relax_points; }
+	
+	void EventCatalog::clearRelaxPoints( ){
+		
+		/// Clears the relaxation points. Has to be called after every MD stage (local or global).
+		
+		relax_points.clear( );
+		relax_broken = false;
+		
+	}
+	
+	//Events
+	std::vector< Event* > &EventCatalog::resetAtomEvents( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom_id ){
+
+		/// Deletes all events of an atom (if any) and returns its (now empty) events vector.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] atom_id ID of parent atom.
+		/// @return reference to the empty vector of PAPRECA::Event objects of the parent atom.
+
+		std::vector< Event* > &atom_events = atomID2events[atom_id]; //Inserts an empty vector if the atom is not in the catalog
+		Event::deleteAndClearLocalEvents( lmp , atom_events );
+		return atom_events;
+
+	}
+
+	std::vector< Event* > &EventCatalog::getAtomEvents( const LAMMPS_NS::tagint &atom_id ){ return atomID2events[atom_id]; }
+
+	void EventCatalog::exportLocalEvents( LAMMPS_NS::LAMMPS *lmp , std::vector< Event* > &events_local ){
+
+		/// Fills events_local with the events of all local atoms (in local index order). Catalog entries of atoms that are no longer owned by the current MPI process (i.e., deleted atoms or atoms that migrated to another process) are deleted.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @note The PAPRECA::Event objects are still owned by the catalog. Hence, events_local has to be cleared (and NOT released via Event::deleteAndClearLocalEvents() or Event::resetEventPoolsAndClearLocalEvents()) at the end of the PAPRECA step.
+
+		const int nlocal = *( ( int *)lammps_extract_global( lmp , "nlocal" ) );
+		LAMMPS_NS::tagint *atom_ids = ( LAMMPS_NS::tagint *)lammps_extract_atom( lmp , "id" );
+
+		events_local.clear( );
+		size_t entries_found = 0;
+		for( int i = 0; i < nlocal; ++i ){
+
+			auto it = atomID2events.find( atom_ids[i] );
+			if( it != atomID2events.end( ) ){
+				++entries_found;
+				events_local.insert( events_local.end( ) , it->second.begin( ) , it->second.end( ) );
+			}
+		}
+
+		if( entries_found == atomID2events.size( ) ){ return; } //All entries are owned by the current MPI process.
+
+		for( auto it = atomID2events.begin( ); it != atomID2events.end( ); ){
+
+			const int iatom = lmp->atom->map( it->first );
+			if( iatom < 0 || iatom >= nlocal ){
+				Event::deleteAndClearLocalEvents( lmp , it->second );
+				it = atomID2events.erase( it );
+			}else{
+				++it;
+			}
+		}
+
+	}
+
+	void EventCatalog::clear( LAMMPS_NS::LAMMPS *lmp ){
+
+		/// Deletes all events in the catalog.
+		/// @param[in] lmp pointer to LAMMPS object.
+
+		for( auto &it : atomID2events ){ Event::deleteAndClearLocalEvents( lmp , it.second ); }
+		atomID2events.clear( );
+
+	}
+
+}//end of namespace PAPRECA
@@ -0,0 +1,125 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Declarations for PAPRECA::EventCatalog class storing PAPRECA::Event objects between PAPRECA steps.
+
+#ifndef EVENT_CATALOG_H
+#define EVENT_CATALOG_H
+
+//System Headers
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <mpi.h>
+
+//LAMMPS headers
+#include "lammps.h"
+/// \cond
+#include "pointers.h"
+#include "atom.h"
+#include "domain.h"
+#include "neighbor.h"
+#include "update.h"
+#include "molecule.h"
+/// \endcond
+
+//kMC headers
+#include "event.h"
+#include "papreca_config.h"
+#include "lammps_wrappers.h"
+#include "utilities.h"
+
+namespace PAPRECA{
+
+	typedef std::unordered_map< LAMMPS_NS::tagint , std::vector< Event* > > ATOM2EVENTS_MAP;
+
+	class EventCatalog{
+
+		/// @class PAPRECA::EventCatalog
+		/// @brief Persistent catalog of PAPRECA::Event objects keyed by the ID of their parent atom.
+		///
+		/// The catalog is only used if incremental_detection is activated in the PAPRECA input file. In that case, the PAPRECA::Event objects of each local atom are kept between PAPRECA steps.
+		/// After the execution of an event, only atoms lying within the neighbor cutoff of the atoms touched by the executed event are rescanned.
+		/// A full rescan is performed on the first step, after every MD stage (i.e., if the LAMMPS timestep counter has advanced), after a change of the simulation box, and whenever the film height changes while deposition heights (depoheights command) are set.
+		/// A full rescan is also performed on every step if deposition tries/sites have to be counted (i.e., variable sticking coefficients or export_SurfaceCoverage), since those counters are reset after every PAPRECA step.
+		/// The touched points are also used to filter out events invalidated by previously executed events of the same batch (see PAPRECA::continueEventBatch()). This works regardless of whether the catalog is active.
+		/// Finally, the touched points are accumulated between MD stages to define the region relaxed by localized MD runs (see PAPRECA::equilibrateFluidAtoms()). This also works regardless of whether the catalog is active.
+
+		public:
+
+			//Constructors/Destructors
+			EventCatalog( );
+			~EventCatalog( );
+
+			//Activation
+			void activate( );
+			const bool &isActive( ) const;
+
+			//Rebuild control
+			const bool fullRebuildIsRequired( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double &film_height ) const;
+			void requestFullRebuild( );
+			void saveRebuildState( LAMMPS_NS::LAMMPS *lmp , const double &film_height );
+
+			//Touched atoms
+			void markTouchedPoint( const double *point );
+			void markTouchedAtoms( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint *atom_ids , const int &num_atoms );
+			void markDeletedAtoms( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint *atom_ids , const int &num_atoms );
+			void markTouchedMolecule( LAMMPS_NS::LAMMPS *lmp , const double *site_pos , const char *mol_name );
+			void fillDirtyAtomsVec( LAMMPS_NS::LAMMPS *lmp , std::vector< char > &dirty_atoms , const bool &full_rebuild );
+
+			//Event batching
+			void startEventBatch( );
+			const bool removeBatchInvalidatedEvents( LAMMPS_NS::LAMMPS *lmp , std::vector< Event* > &events_local );
+
+			//Localized relaxation
+			void startRelaxTracking( );
+			void gatherRelaxPoints( const int &nprocs );
+			const bool relaxPointsAreResolved( ) const;
+			const std::vector< ARRAY3D > &getRelaxPoints( ) const;
+			void clearRelaxPoints( );
+
+			//Events
+			std::vector< Event* > &resetAtomEvents( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom_id );
+			std::vector< Event* > &getAtomEvents( const LAMMPS_NS::tagint &atom_id );
+			void exportLocalEvents( LAMMPS_NS::LAMMPS *lmp , std::vector< Event* > &events_local );
+			void clear( LAMMPS_NS::LAMMPS *lmp );
+
+		private:
+
+			bool active = false; ///< true if incremental_detection was activated in the PAPRECA input file.
+			ATOM2EVENTS_MAP atomID2events; ///< maps the ID of each local atom to the PAPRECA::Event objects it is parent to. Atoms with no events are mapped to empty vectors, so newly-owned atoms can be recognized.
+			std::vector< ARRAY3D > touched_points; ///< coordinates of atoms touched (i.e., moved, deleted, inserted, or bonded) by executed events since the last update of the catalog.
+			bool batch_tracking = false; ///< true if touched points are recorded for event batching (see PAPRECA::continueEventBatch()), even if the catalog is not active.
+			bool batch_broken = false; ///< true if an event executed during the current batch could not be resolved to touched points (e.g., no atom map or atom IDs re-assigned). In that case, the batch has to end.
+			std::vector< ARRAY3D > relax_points; ///< coordinates of atoms touched by executed events since the last MD stage (only recorded if local_relax is active, see PAPRECA::equilibrateFluidAtoms()).
+			bool relax_tracking = false; ///< true if relaxation points are recorded.
+			bool relax_broken = false; ///< true if an event executed since the last MD stage could not be resolved to relaxation points (i.e., no atom map). In that case, the next MD stage has to be global.
+			bool rebuild_requested = true; ///< forces a full rescan on the next update (always true before the first PAPRECA step).
+			LAMMPS_NS::bigint ntimestep_last = -1; ///< LAMMPS timestep during the last update. Any MD stage advances the LAMMPS timestep and invalidates the catalog.
+			ARRAY3D boxlo_last = { 0.0 , 0.0 , 0.0 }; ///< lower bounds of the simulation box during the last update.
+			ARRAY3D boxhi_last = { 0.0 , 0.0 , 0.0 }; ///< upper bounds of the simulation box during the last update.
+			double film_height_last = 0.0; ///< film height during the last update.
+
+	};
+
+}//end of PAPRECA namespace
+
+
+#endif
@@ -24,8 +24,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 
+	static std::string detection_error; //First error recorded by PAPRECA::detectionAbortWithMessage() inside the threaded event detection region (see PAPRECA::loopAtomsAndIdentifyEventsWithThreads())
+
 	//Diffusion events
-	const bool feCandidateHas4PO4Neibs( PaprecaConfig &papreca_config , PredefinedDiffusionHop *diff_template , LAMMPS_NS::tagint *atom_ids , int *atom_types , int *neighbors , int &neighbors_num , ATOM2BONDS_MAP &atomID2bonds ){
+	const bool feCandidateHas4PO4Neibs( PaprecaConfig &papreca_config , PredefinedDiffusionHop *diff_template , LAMMPS_NS::tagint *atom_ids , int *atom_types , int *neighbors , int &neighbors_num , BondGraph &atomID2bonds ){
 	
 		/// Scans neighbors of a diffusion parent atom to check whether 4 distinct PO4 (phosphate) structures exist in the neighbors list. This function is only called when the custom PAPRECA::PredefinedDiffusionHop style: Fe_4PO4neib is active.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
@@ -34,7 +36,7 @@ namespace PAPRECA{
 		/// @param[in] atom_types LAMMPS atom types.
 		/// @param[in] neighbors LAMMPS array storing the IDs of neighbors of the current (parent) atom type.
 		/// @param[in] neighbors_num total number of neighbors.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @return true/false depending on whether at least 4 PO4 (phosphate) structures exist or not in the neighborhood of the diffusion parent candidate atom.
 		/// @see PAPRECA::getDiffEventsFromAtom()
 		
@@ -49,7 +51,7 @@ namespace PAPRECA{
 				
 			if( ( diff_template->getStyleAtomTypes( ) )[0] == neib_type ){ //the atom style types vector of custom Fe_4PO4neib diffusion events contains the P atom (we use its bond list to identify the PO4 neibs).
 				
-				BOND_VECTOR &bonds = atomID2bonds[ neib_id ]; //Get bonds of P neib
+				const BondRange bonds = atomID2bonds.getBonds( neib_id ); //Get bonds of P neib
 				if( bonds.size( ) == papreca_config.getMaxBondsFromSpecies( ( diff_template->getStyleAtomTypes( ) )[0] ) ){ 
 					++po4_neibs_num;	
 					if( po4_neibs_num >= 4 ){ return true; } //immediately return if you find at least 4 PO4 neibs
@@ -92,23 +94,23 @@ namespace PAPRECA{
 		double contaminant_dist = ( diff_template->getStyleConstants( ) )[0];
 		double contaminant_sqrdist = contaminant_dist * contaminant_dist;
 		
+		//Minimum image distances of all neighbors from the parent and candidate positions
+		thread_local MinImageBatch parent_batch , candidate_batch; //Buffers are reused between calls (see PAPRECA::MinImageBatch)
+		parent_batch.compute( lmp , parent_xyz , atom_xyz , neighbors , neighbors_num );
+		candidate_batch.compute( lmp , candidate_xyz , atom_xyz , neighbors , neighbors_num );
+		const double *parent_sqrdists = parent_batch.getSqrDists( );
+		const double *candidate_sqrdists = candidate_batch.getSqrDists( );
+		
 		//Scan through neighbours list to identify contaminants for the parent and candidate positions
 		for( int i = 0; i < neighbors_num; ++i ){
 				
 			int ineib = getMaskedNeibIndex( neighbors , i );
 			int neib_type = atom_types[ineib];
-			double *neib_xyz = atom_xyz[ineib];
-			LAMMPS_NS::tagint neib_id = atom_ids[ineib];
 
 			if( contaminant_type == neib_type ){ //This means that a contaminant has been detected
-			
 				
-				
-				double parent_cont_sqrdist = get3DSqrDistWithPBC( lmp , parent_xyz , neib_xyz );
-				if( parent_cont_sqrdist <= contaminant_sqrdist ){ ++parent_cont_num; }
-				
-				double candidate_cont_sqrdist = get3DSqrDistWithPBC( lmp , candidate_xyz , neib_xyz );
-				if( candidate_cont_sqrdist <= contaminant_sqrdist ){ ++candidate_cont_num; }
+				if( parent_sqrdists[i] <= contaminant_sqrdist ){ ++parent_cont_num; }
+				if( candidate_sqrdists[i] <= contaminant_sqrdist ){ ++candidate_cont_num; }
 				
 			}
 					
@@ -120,11 +122,12 @@ namespace PAPRECA{
 		
 	}
 	
-	void getDiffPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp  , PaprecaConfig &papreca_config , const double *iatom_xyz , double *candidate_xyz , PredefinedDiffusionHop *diff_template ){
+	void getDiffPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp  , PaprecaConfig &papreca_config , const LAMMPS_NS::tagint &iatom_id , const double *iatom_xyz , double *candidate_xyz , PredefinedDiffusionHop *diff_template ){
 	
 		/// Calculates the diffusion point (vacancy) coordinates for a given parent atom. Depending on the user settings, the diffusion point can be directly above the parent atom or at the surface of a sphere centered at the coordinates of the parent atom.
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] iatom_id ID of parent atom (used by the counter-based random number generator, see PaprecaConfig::getDetectionRanNums()).
 		/// @param[in] iatom_xyz coordinates of parent atom.
 		/// @param[in,out] candidate_xyz coordinates of diffusion point.
 		/// @param[in] diff_template Diffusion template (PAPRECA::PredefinedDiffusionHop) as initialized by the user (in the PAPRECA input file).
@@ -189,8 +192,8 @@ namespace PAPRECA{
 			candidate_xyz[2] = iatom_xyz[2];
 		}else if( diffvec_style == "sphere2D" || diffvec_style == "sphere3D" ){
 			
-			const double rnum1 = papreca_config.getUniformRanNum( );
-			const double rnum2 = papreca_config.getUniformRanNum( );
+			double rnum1 , rnum2;
+			papreca_config.getDetectionRanNums( iatom_id , RNG_STREAM_DIFFUSION , diff_template->getTemplateID( ) , rnum1 , rnum2 );
 				
 			double phi = 2.0 * M_PI * rnum1; //Gives a number between 0 and 2PI
 			double theta = 0.0;
@@ -206,7 +209,8 @@ namespace PAPRECA{
 			candidate_xyz[2] = iatom_xyz[2] + diff_dist * cos( theta );
 			
 		}else{
-			allAbortWithMessage( MPI_COMM_WORLD , "Unknown diffvec style " + diffvec_style + " in getDiffPointCandidateCoords( ) function of event_detect.cpp." );
+			detectionAbortWithMessage( "Unknown diffvec style " + diffvec_style + " in getDiffPointCandidateCoords( ) function of event_detect.cpp." );
+			copyDoubleArray3D( candidate_xyz , iatom_xyz ); //Only reached inside threaded detection. The detected events are discarded when the master thread aborts.
 		}
 		
 
@@ -246,10 +250,14 @@ namespace PAPRECA{
 		//This check has to be done in a separate call, since iatom is not in the neib list of iatom
 		if( atomsCollide( lmp , papreca_config , iatom_xyz , iatom_type , candidate_xyz , diffused_type ) ){ return true; }
 		
-		//Check for collisions between candidate_xyz and neib atoms of iatom
+		//Check for collisions between candidate_xyz and neib atoms of iatom (same check as in atomsCollide( ), but with the distances of all neibs calculated at once)
+		thread_local MinImageBatch batch; //Buffers are reused between calls (see PAPRECA::MinImageBatch)
+		batch.compute( lmp , candidate_xyz , pos , neighbors , neighbors_num );
+		const double *sqr_dists = batch.getSqrDists( );
+		
 		for( int i = 0; i < neighbors_num; ++i ){ //Check for collisions between parent atom (iatom) neibs and 
 			int ineib = getMaskedNeibIndex( neighbors , i ); //get Masked index from neib list
-			if( atomsCollide( lmp , papreca_config , pos[ineib] , type[ineib] , candidate_xyz , diffused_type ) ){
+			if( sqr_dists[i] < papreca_config.getSigmaSqrFromAtomTypes( type[ineib] , diffused_type ) ){
 				return true;
 			}
 		}
@@ -257,7 +265,7 @@ namespace PAPRECA{
 		return false;
 	}
 	
-	void getDiffEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void getDiffEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector< Event* > &events_local , BondGraph &atomID2bonds ){
 		
 		/// Checks if the current atom is candidate to diffusion events (a.k.a. PAPRECA::PredefinedDiffusionHop). Detected deposition events are inserted in the events_local vector of PAPRECA::Event objects (storing all events of the current MPI process).
 		/// @param[in] lmp pointer to LAMMPS object.
@@ -266,7 +274,7 @@ namespace PAPRECA{
 		/// @param[in] neighbors IDs of neighbors of the current atom.
 		/// @param[in] neighbors_num number of neighbors of the current atom.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::loopAtomsAndIdentifyEvents()
 		
 		
@@ -292,7 +300,7 @@ namespace PAPRECA{
 			for( PredefinedDiffusionHop *diff_template : diff_templates ){ //Scan all diffusion templates associated with this parent atom type and collect events
 			
 				double candidate_xyz[3];
-				getDiffPointCandidateCoords( lmp , papreca_config , iatom_xyz , candidate_xyz , diff_template );
+				getDiffPointCandidateCoords( lmp , papreca_config , iatom_id , iatom_xyz , candidate_xyz , diff_template );
 				
 				const int diffused_type = diff_template->getDiffusedAtomType( );
 				
@@ -312,10 +320,13 @@ namespace PAPRECA{
 						rate = diff_template->getRate( );
 					}
 					
-					if( rate <= 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Attempted to initialise diffusion event with invalid rate in getDiffEventsFromAtom function (event_detect.cpp)"); }
+					if( rate <= 0 ){
+						detectionAbortWithMessage( "Attempted to initialise diffusion event with invalid rate in getDiffEventsFromAtom function (event_detect.cpp)" );
+						continue; //Only reached inside threaded detection (see PAPRECA::detectionAbortWithMessage())
+					}
 							
 
-					Diffusion *diff = new Diffusion( rate , candidate_xyz , parent_xyz , iatom_id , iatom_type , diffused_type , diff_template );
+					Diffusion *diff = Event::newEvent< Diffusion >( rate , candidate_xyz , parent_xyz , iatom_id , iatom_type , diffused_type , diff_template );
 					events_local.push_back( diff );
 							
 				}
@@ -342,11 +353,12 @@ namespace PAPRECA{
 		return( ( ( papreca_config.getHeightDepoScan( ) == -1 ) || ( ( iatom_xyz[2] <= film_height + papreca_config.getHeightDepoScan( )  ) && ( iatom_xyz[2] >= film_height - papreca_config.getHeightDepoScan( ) ) ) ) ? true : false );
 	}
 	
-	void getDepoPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double *iatom_xyz ,  double *candidate_xyz , PredefinedDeposition *depo_template ){
+	void getDepoPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const LAMMPS_NS::tagint &iatom_id , double *iatom_xyz ,  double *candidate_xyz , PredefinedDeposition *depo_template ){
 		
 		/// Fills candidate_xyz array with the coordinates of the deposition candidate. The deposition candidate coordinates DO NOT coincide with the parent atom coordinates. Depending on the user input settings in PAPRECA input, the deposition candidate coordinates can either be directly above the parent atom or on the surface of the upper hemisphere centered at the parent atom coordinates.
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] iatom_id ID of parent atom (used by the counter-based random number generator, see PaprecaConfig::getDetectionRanNums()).
 		/// @param[in] iatom_xyz coordinates of parent atom.
 		/// @param[in,out] candidate_xyz coordinates of candidate point for the deposition event.
 		/// @param[in] depo_template Deposition template (PAPRECA::PredefinedDeposition) as initialized by the user (in the PAPRECA input file).
@@ -360,8 +372,8 @@ namespace PAPRECA{
 		
 		if( papreca_config.depoVecsAreRandom( ) ){
 			
-			const double rnum1 = papreca_config.getUniformRanNum( );
-			const double rnum2 = papreca_config.getUniformRanNum( );
+			double rnum1 , rnum2;
+			papreca_config.getDetectionRanNums( iatom_id , RNG_STREAM_DEPOSITION , depo_template->getTemplateID( ) , rnum1 , rnum2 );
 			
 			double phi = 2.0 * M_PI * rnum1; //Gives a number between 0 and 2PI.
 			double theta = 0.5 * M_PI * rnum2; //Gives a number between 0 and pi/2 (for phi between pi/2 and pi negative z coords would be produced, which is unwanted for the case of thin film growth (i.e., deposition on top of current film)
@@ -455,24 +467,53 @@ namespace PAPRECA{
 
 	}
 	
-	bool atomHasCollisionWithMolAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double *atom_xyz , const int &atom_type , const int &mol_natoms , double **mol_xyz , int *mol_atomtype ){
+	bool atomHasCollisionWithMolAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double *atom_xyz , const int &atom_type , const double *candidate_center , PredefinedDeposition *depo_template , const bool &use_cells ){
 
-		/// Checks if the parent event atom has collisions with any of the inserted molecule atoms.
+		/// Checks if a system atom has collisions with any of the inserted molecule atoms.
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
-		/// @param[in] atom_xyz coordinates of the parent atom.
-		/// @param[in] atom_type atom type of parent atom.
-		/// @param[in] mol_natoms total number of atoms in the inserted molecule.
-		/// @param[in] mol_xyz a mol_natomsx3 array storing the coordinates of all inserted molecule atoms.
-		/// @param[in] mol_atomtype array storing the atom types of all inserted molecule atoms.
+		/// @param[in] atom_xyz coordinates of the system atom.
+		/// @param[in] atom_type atom type of the system atom.
+		/// @param[in] candidate_center coordinates of the center of the candidate inserted molecule.
+		/// @param[in] depo_template Deposition template (PAPRECA::PredefinedDeposition) of the inserted molecule.
+		/// @param[in] use_cells if true, the system atom is only tested against template atoms in nearby collision cells (see PAPRECA::PredefinedDeposition::initCollisionCells()). If false, the system atom is tested against every template atom.
 		/// @return true or false if atom has collisions with molecule atoms or not, respectively.
-		/// @see PAPRECA::getDepoEventsFromAtom(), PAPRECA::atomsCollide(), PAPRECA::candidateDepoHasCollisions()
+		/// @see PAPRECA::getDepoEventsFromAtom(), PAPRECA::candidateDepoHasCollisions()
+		/// @note The system atom is first tested against the bounding sphere of the template (with a radius equal to the bounding radius plus the largest sigma between atom_type and the template atom types). This test is valid for any box, since the minimum image distance from the candidate center never exceeds the distance from any periodic image of a template atom plus the bounding radius.
+		/// @note use_cells=true requires the bounding radius plus the maximum sigma to fit in the periodic box (see PAPRECA::radiusFitsInPeriodicBox()), since the minimum image is only calculated once (relative to the candidate center).
 
+		//Bounding-sphere early reject
+		double dist[3];
+		get3DMinImageDisplacement( lmp , atom_xyz , candidate_center , dist );
+		if( dist[0] * dist[0] + dist[1] * dist[1] + dist[2] * dist[2] >= depo_template->getTypeReachSqr( atom_type ) ){ return false; }
+		
+		if( use_cells ){ return atomHasCollisionWithMolAtomsInCells( papreca_config , dist , atom_type , depo_template ); }
+		
+		return atomHasCollisionWithMolAtomsPairwise( lmp , papreca_config , atom_xyz , atom_type , candidate_center , depo_template );
+		
+	}
+	
+	bool atomHasCollisionWithMolAtomsPairwise( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double *atom_xyz , const int &atom_type , const double *candidate_center , PredefinedDeposition *depo_template ){
+		
+		/// Checks if a system atom has collisions with any of the inserted molecule atoms by calculating the minimum image distance from every template atom. Used when collision cells cannot be used (see PAPRECA::atomHasCollisionWithMolAtoms()).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] atom_xyz coordinates of the system atom.
+		/// @param[in] atom_type atom type of the system atom.
+		/// @param[in] candidate_center coordinates of the center of the candidate inserted molecule.
+		/// @param[in] depo_template Deposition template (PAPRECA::PredefinedDeposition) of the inserted molecule.
+		/// @return true or false if atom has collisions with molecule atoms or not, respectively.
+		
+		const double *mol_x = depo_template->getCoordsX( ) , *mol_y = depo_template->getCoordsY( ) , *mol_z = depo_template->getCoordsZ( );
+		int *mol_atomtype = depo_template->getAtomTypes( );
+		const int &mol_natoms = depo_template->getAtomsNum( );
+		double dist[3];
+		
 		for( int j = 0; j < mol_natoms; ++j ){
 			
-			if( atomsCollide( lmp , papreca_config , mol_xyz[j] , mol_atomtype[j] , atom_xyz , atom_type  ) ){
-				return true;	
-			}
+			const double mol_atom_xyz[3] = { candidate_center[0] + mol_x[j] , candidate_center[1] + mol_y[j] , candidate_center[2] + mol_z[j] };
+			get3DMinImageDisplacement( lmp , atom_xyz , mol_atom_xyz , dist );
+			if( dist[0] * dist[0] + dist[1] * dist[1] + dist[2] * dist[2] < papreca_config.getSigmaSqrFromAtomTypes( mol_atomtype[j] , atom_type ) ){ return true; }
 			
 		}
 		
@@ -480,6 +521,48 @@ namespace PAPRECA{
 		
 	}
 	
+	bool atomHasCollisionWithMolAtomsInCells( PaprecaConfig &papreca_config , const double *dist , const int &atom_type , PredefinedDeposition *depo_template ){
+		
+		/// Checks if a system atom has collisions with the inserted molecule atoms that lie in collision cells near the system atom (see PAPRECA::PredefinedDeposition::initCollisionCells()).
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] dist minimum image displacement of the system atom from the center of the candidate inserted molecule.
+		/// @param[in] atom_type atom type of the system atom.
+		/// @param[in] depo_template Deposition template (PAPRECA::PredefinedDeposition) of the inserted molecule.
+		/// @return true or false if atom has collisions with molecule atoms or not, respectively.
+		/// @see PAPRECA::atomHasCollisionWithMolAtoms(), PAPRECA::candidateDepoHasCollisions()
+		
+		const double *mol_x = depo_template->getCoordsX( ) , *mol_y = depo_template->getCoordsY( ) , *mol_z = depo_template->getCoordsZ( );
+		int *mol_atomtype = depo_template->getAtomTypes( );
+		
+		//Only template atoms in cells within the largest sigma (between atom_type and template atom types) of the system atom can collide with it
+		int cell_lo[3] , cell_hi[3];
+		if( !depo_template->getCollisionCellsRange( dist , depo_template->getTypeSigmaMax( atom_type ) , cell_lo , cell_hi ) ){ return false; }
+		
+		for( int iz = cell_lo[2]; iz <= cell_hi[2]; ++iz ){
+			for( int iy = cell_lo[1]; iy <= cell_hi[1]; ++iy ){
+				for( int ix = cell_lo[0]; ix <= cell_hi[0]; ++ix ){
+					
+					int cell_atoms_num;
+					const int *cell_atoms = depo_template->getCollisionCellAtoms( depo_template->getCollisionCellID( ix , iy , iz ) , cell_atoms_num );
+					
+					for( int i = 0; i < cell_atoms_num; ++i ){
+						
+						const int &j = cell_atoms[i];
+						const double dx = dist[0] - mol_x[j];
+						const double dy = dist[1] - mol_y[j];
+						const double dz = dist[2] - mol_z[j];
+						if( dx * dx + dy * dy + dz * dz < papreca_config.getSigmaSqrFromAtomTypes( mol_atomtype[j] , atom_type ) ){ return true; }
+						
+					}
+					
+				}
+			}
+		}
+		
+		return false;
+		
+	}
+	
 	
 	bool candidateDepoHasCollisions( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &nprocs , PaprecaConfig &papreca_config , int *neighbors , int neighbors_num , double *candidate_center , double *iatom_xyz , const int &iatom_type , PredefinedDeposition *depo_template ){
 		
@@ -495,42 +578,37 @@ namespace PAPRECA{
 		/// @param[in] iatom_type atom type of parent atom.
 		/// @param[in] depo_template Deposition template (PAPRECA::PredefinedDeposition) as initialized by the user (in the PAPRECA input file).
 		/// @return true or false if candidate deposition has collisions or not, respectively.
-		/// @see PAPRECA::getDepoEventsFromAtom(), PAPRECA::atomHasCollisionWithMolAtoms(), PAPRECA::atomsCollide()
+		/// @see PAPRECA::getDepoEventsFromAtom(), PAPRECA::atomHasCollisionWithMolAtoms(), PAPRECA::PredefinedDeposition::initCollisionCells()
 		/// @note This function assumes that any potential collision between the inserted molecule and existing atoms in the system can be detected using the parent atom neighbors. For very big molecules there is a chance that a molecule atom collides with existing atoms not included in the parent atom neighbor list. Hence, this function might require modifications in the future.
+		/// @note The parent atom neighbor list already acts as a binned spatial index of local and ghost atoms (it is rebuilt by LAMMPS every step). Hence, it is the template atoms that are binned (once, at input time) so that each neighbor is only tested against nearby template atoms.
 		
-		LAMMPS_NS::tagint *id = ( LAMMPS_NS::tagint *)lammps_extract_atom( lmp , "id" );
 		int *type = (int *) lammps_extract_atom( lmp , "type" );
 		double **pos = ( double **)lammps_extract_atom( lmp , "x" );
 		
-		//get mol information from mol name
-		double **mol_dx = depo_template->getCoords( );
-		int *mol_atomtype = depo_template->getAtomTypes( );
-		const int mol_natoms = depo_template->getAtomsNum( );
-		
-		//get candidate mol coordinates
-		double **mol_xyz = NULL;
-		initMolCoordsArr( &mol_xyz , mol_natoms );
-		getMolCoords( lmp , mol_xyz , mol_dx , mol_natoms , candidate_center );
+		const bool use_cells = depo_template->collisionCellsAreInitialized( ) && radiusFitsInPeriodicBox( lmp , depo_template->getBoundingRadius( ) + papreca_config.getSigmaMax( ) );
 
 		//Checking for collisions between the current atom (iatom) and the mol atoms has to be done in a separate function call(because the iatom coordinates are not in the iatom neighbor list).
-		if( atomHasCollisionWithMolAtoms( lmp , papreca_config , iatom_xyz , iatom_type , mol_natoms , mol_xyz , mol_atomtype ) ){
-			deleteMolCoordsArr( mol_xyz , mol_natoms );
-			return true;
-			
-		}
+		if( atomHasCollisionWithMolAtoms( lmp , papreca_config , iatom_xyz , iatom_type , candidate_center , depo_template , use_cells ) ){ return true; }
 		
-		//Check for collisions will all the neighbors of the parent atom!
-		for( int i = 0; i < neighbors_num; ++i ){ 
+		//Check for collisions will all the neighbors of the parent atom! The displacements of all neighbors from the candidate center are calculated at once and only neighbors within the bounding sphere of the template are checked further (same steps as in atomHasCollisionWithMolAtoms( )).
+		thread_local MinImageBatch batch; //Buffers are reused between calls (see PAPRECA::MinImageBatch)
+		batch.compute( lmp , candidate_center , pos , neighbors , neighbors_num );
+		const double *dx = batch.getDx( ) , *dy = batch.getDy( ) , *dz = batch.getDz( ) , *sqr_dists = batch.getSqrDists( );
+		
+		for( int i = 0; i < neighbors_num; ++i ){
+			
 			int ineib = getMaskedNeibIndex( neighbors , i ); //get Masked index from neib list
-			if( atomHasCollisionWithMolAtoms( lmp , papreca_config , pos[ineib] , type[ineib] , mol_natoms , mol_xyz , mol_atomtype ) ){
-				deleteMolCoordsArr( mol_xyz , mol_natoms );
+			if( sqr_dists[i] >= depo_template->getTypeReachSqr( type[ineib] ) ){ continue; } //Bounding-sphere early reject
+			
+			if( use_cells ){
+				const double dist[3] = { dx[i] , dy[i] , dz[i] };
+				if( atomHasCollisionWithMolAtomsInCells( papreca_config , dist , type[ineib] , depo_template ) ){ return true; }
+			}else if( atomHasCollisionWithMolAtomsPairwise( lmp , papreca_config , pos[ineib] , type[ineib] , candidate_center , depo_template ) ){
 				return true;
 			}
 			
 		}
 		
-		//If there are no collisions remember to delete the MolCoords array. We use that array just to check for collisions. The LAMMPS object stores the mol template information
-		deleteMolCoordsArr( mol_xyz , mol_natoms );
 		return false;
 		
 	}
@@ -570,22 +648,38 @@ namespace PAPRECA{
 			if( atomIsInDepoScanRange( papreca_config , iatom_xyz , film_height ) ){ //Check if atom is below scan range first. No need to do anything if it's above
 				
 				const DEPOSITIONS_VEC &depo_templates = *depo_templates_ptr;
+				const bool dedup_sites = papreca_config.depoSiteDedupIsActive( );
 				
 				for( PredefinedDeposition *depo_template : depo_templates ){ //Each atom might be linked to multiple deposition events. We need to loop trough them
 					
 					double candidate_center[3];
-					getDepoPointCandidateCoords( lmp , papreca_config , iatom_xyz , candidate_center , depo_template );
+					getDepoPointCandidateCoords( lmp , papreca_config , iatom_id , iatom_xyz , candidate_center , depo_template );
 					
 					if( depoCandidateIsBelowRejectionHeight( papreca_config , candidate_center , film_height ) ){ //reject depo candidates above a certain point
 					
 							if( depo_template->hasVariableStickingCoeff( ) || papreca_config.getSurfaceCoverageFile( ).isActive( ) ){ depo_template->incrementDepositionTries( ); }//No need to reset in the beginning. Variables are reset within the calcVariableStickingCoeff member function of PredefinedDeposition, immediately after the calculation of the sticking coefficient
 							
-							if( !candidateDepoHasCollisions( lmp , proc_id , nprocs , papreca_config , neighbors , neighbors_num , candidate_center , iatom_xyz , iatom_type , depo_template ) ){
+							//Candidates (almost) identical to a previously checked candidate of this pass inherit its collision check result (see PAPRECA::DepositionSiteGrid)
+							const DEPO_SITE_STATUS site_status = dedup_sites ? papreca_config.getDepoSiteGrid( ).findSite( lmp , depo_template->getTemplateID( ) , candidate_center ) : DEPO_SITE_NONE;
+							
+							if( site_status == DEPO_SITE_NONE ){
+								
+								const bool site_is_free = !candidateDepoHasCollisions( lmp , proc_id , nprocs , papreca_config , neighbors , neighbors_num , candidate_center , iatom_xyz , iatom_type , depo_template );
+								if( dedup_sites ){ papreca_config.getDepoSiteGrid( ).insertSite( depo_template->getTemplateID( ) , candidate_center , site_is_free ); }
+								
+								if( site_is_free ){
+									
+									double rot_pos[3] = { 0.0 , 0.0 , 1.0 }; //In this version we don't rotate the molecule at all, so just define a rotation axis and set theta to zero!
+									
+									Deposition *depo = Event::newEvent< Deposition >( depo_template->getRate( ) , candidate_center , rot_pos , 0.0 , 0 , depo_template );
+									events_local.push_back( depo );
+									if( depo_template->hasVariableStickingCoeff( ) || papreca_config.getSurfaceCoverageFile( ).isActive( ) ){ depo_template->incrementDepositionSites( ); }
+									
+								}
 								
-								double rot_pos[3] = { 0.0 , 0.0 , 1.0 }; //In this version we don't rotate the molecule at all, so just define a rotation axis and set theta to zero!
+							}else if( site_status == DEPO_SITE_FREE ){
 								
-								Deposition *depo = new Deposition( depo_template->getRate( ) , candidate_center , rot_pos , 0.0 , 0 , depo_template->getAdsorbateName( ) , depo_template );
-								events_local.push_back( depo );
+								//Duplicate of an already detected deposition event. Still counted as a free site, so that sticking coefficients and surface coverage do not change.
 								if( depo_template->hasVariableStickingCoeff( ) || papreca_config.getSurfaceCoverageFile( ).isActive( ) ){ depo_template->incrementDepositionSites( ); }
 								
 							}
@@ -651,7 +745,10 @@ namespace PAPRECA{
 		//For any other case we need to check for distances
 		double **atom_xyz = ( double **)lammps_extract_atom( lmp , "x" );//extract atom positions
 		const int &jatom = lmp->atom->map( jatom_id ); //atom->map() maps id to local index or returns -1 if the atom is not found locally.
-		if( jatom == -1 ) {allAbortWithMessage( MPI_COMM_WORLD , "Could not index bonded atom ID to local index in getBondBreakingEventsFromAtom function (event_detect.cpp)"); }
+		if( jatom == -1 ){
+			detectionAbortWithMessage( "Could not index bonded atom ID to local index in getBondBreakingEventsFromAtom function (event_detect.cpp)" );
+			return false; //Only reached inside threaded detection (see PAPRECA::detectionAbortWithMessage())
+		}
 		double *atom1_xyz = atom_xyz[iatom];
 		double *atom2_xyz = atom_xyz[jatom];
 		const double distance_sqr = get3DSqrDistWithPBC( lmp , atom1_xyz , atom2_xyz );
@@ -665,7 +762,7 @@ namespace PAPRECA{
 	}
 	
 		
-	void getBondBreakingEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void getBondBreakingEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , BondGraph &atomID2bonds ){
 
 		/// Scans all atoms in the current MPI process for PAPRECA::BondBreak (a.k.a. PAPRECA::PredefinedReaction) events. Discovered events are inserted in the events_local vector of PAPRECA::Event objects (storing all events of the current MPI process).
 		/// @param[in] lmp pointer to LAMMPS object.
@@ -674,7 +771,7 @@ namespace PAPRECA{
 		/// @param[in] neighbors array storing the IDs of LAMMPS neighbors of the candidate atom.
 		/// @param[in] neighbors_num total number of neighbors of the candidate atom.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::loopAtomsAndIdentifyEvents()
 		
 		
@@ -687,7 +784,7 @@ namespace PAPRECA{
 		const LAMMPS_NS::tagint iatom_id = atom_ids[iatom];
 		const LAMMPS_NS::tagint &molid = molids[iatom];
 		
-		BOND_VECTOR &bonds = atomID2bonds[ iatom_id ];
+		const BondRange bonds = atomID2bonds.getBonds( iatom_id );
 		
 		for ( const auto &bond : bonds ){
 			
@@ -703,7 +800,7 @@ namespace PAPRECA{
 						if( bondLengthIsWithinBreakLimits( lmp , break_template , iatom , jatom_id ) ){
 						
 							const double rate = break_template->getRate( );
-							BondBreak *bond_break = new BondBreak( rate , iatom_id , jatom_id , bond_type , break_template );
+							BondBreak *bond_break = Event::newEvent< BondBreak >( rate , iatom_id , jatom_id , bond_type , break_template );
 							events_local.push_back( bond_break ); //Polymorphism allows pushing back of children of Event class.
 							//But, we definitely need pointers to correctly manage the memory of the general events_local container, since Event children can have different sizes and this would create slicing issues
 						}
@@ -732,29 +829,29 @@ namespace PAPRECA{
 	}
 	
 	
-	const bool atomHasMaxBonds( PaprecaConfig &papreca_config , ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int atom_type ){
+	const bool atomHasMaxBonds( PaprecaConfig &papreca_config , BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int atom_type ){
 
 		/// Determines the total number of bonds for an atom by retrieving its PAPRECA::Bond objects vector. Then compares it to the user defined species max bonds.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @param[in] atom_id ID of atom.
 		/// @param[in] atom_type type of current atom.
 		/// @return true if the size of PAPRECA::Bond objects vector is greater or equal to the user defined species max bonds.
 
 		
-		return( ( atomID2bonds[atom_id].size( ) >= papreca_config.getMaxBondsFromSpecies( atom_type ) ) ? true : false );
+		return( ( atomID2bonds.getBondsNum( atom_id ) >= papreca_config.getMaxBondsFromSpecies( atom_type ) ) ? true : false );
 		
 	}
 	
-	bool bondBetweenAtomsExists( ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom1_id , const LAMMPS_NS::tagint &atom2_id ){ //Just search on the bond list of one of the atoms to see if you can find the other one
+	bool bondBetweenAtomsExists( BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom1_id , const LAMMPS_NS::tagint &atom2_id ){ //Just search on the bond list of one of the atoms to see if you can find the other one
 
 		/// The PAPRECA::Bond objects vector is retrieved from the atomID2bonds container for two atoms to determine if the two atoms are already bonded.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @param[in] atom1_id ID of the first atom.
 		/// @param[in] atom2_id ID of the second atom.
 		/// @return true or false depending on whether there is an existing bond between the two atoms or not, respectively.
 		
-		BOND_VECTOR &bonds = atomID2bonds[ atom1_id ];
+		const BondRange bonds = atomID2bonds.getBonds( atom1_id );
 		for( const auto &bond : bonds ){
 		
 			const LAMMPS_NS::tagint bond_atom = bond.getBondAtom( );
@@ -772,26 +869,26 @@ namespace PAPRECA{
 
 	}
 	
-	const bool atomCandidatesAreLone( const LAMMPS_NS::tagint atom1_id , const LAMMPS_NS::tagint atom2_id , ATOM2BONDS_MAP &atomID2bonds ){
+	const bool atomCandidatesAreLone( const LAMMPS_NS::tagint atom1_id , const LAMMPS_NS::tagint atom2_id , BondGraph &atomID2bonds ){
 		
 		/// Checks if two atoms are lone (i.e., if they do not have any bonds). This is done by retrieving the PAPRECA:Bond objects vector for each atom from the atomID2bonds container.
 		/// @param[in] atom1_id ID of the first atom.
 		/// @param[in] atom2_id ID of the second atom.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @return true if both atoms are lone (not bonded to any other atom) or false if one or both atoms contain atoms (i.e., if the size of their PAPRECA::Bond objects vector is non-zero.
 		
 
 		
-		return( ( atomID2bonds[atom1_id].size( ) == 0 && atomID2bonds[atom2_id].size( ) == 0 ) ? true : false );
+		return( ( atomID2bonds.getBondsNum( atom1_id ) == 0 && atomID2bonds.getBondsNum( atom2_id ) == 0 ) ? true : false );
 
 	}
 	
 	
-	const bool atomHasMaxBondTypes( PaprecaConfig &papreca_config , ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int &atom_type , const int &bond_type ){
+	const bool atomHasMaxBondTypes( PaprecaConfig &papreca_config , BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int &atom_type , const int &bond_type ){
 		
 		/// Checks if the number of bonds of a specific bond type for the current atom is greater or equal than the user defined max bond types of species. This is done by retrieving the PAPRECA::Bond objects vector of the current atom from the atomID2bonds map.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @param[in] atom_id id of current atom.
 		/// @param[in] atom_type of current atom.
 		/// @param[in] bond_type to be checked
@@ -801,7 +898,7 @@ namespace PAPRECA{
 		
 		if(  bonds_max != -1 ){ //If the mapping exists search. Otherwise, return false immediately
 			int bonds_cur = 0;
-			BOND_VECTOR &bonds = atomID2bonds[atom_id];
+			const BondRange bonds = atomID2bonds.getBonds( atom_id );
 			for( const auto &bond : bonds ){
 				if( bond.getBondType( ) == bond_type ){ ++bonds_cur; }
 				if( bonds_cur >= bonds_max ){ return true; }
@@ -813,7 +910,7 @@ namespace PAPRECA{
 	}
 	
 	
-	void getBondFormEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void getBondFormEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , BondGraph &atomID2bonds ){
 
 		/// Scans a half neighbor list and detect bond formation (a.k.a. PAPRECA::PredefinedBondForm). Detected events are inserted in events_local vector, which is a container of PAPRECA::Event object and stores the events detected on the current MPI process.
 		/// @param[in] lmp pointer to LAMMPS object.
@@ -822,7 +919,7 @@ namespace PAPRECA{
 		/// @param[in] neighbors IDs of neighbors of the current atom.
 		/// @param[in] neighbors_num number of neighbors of the current atom.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::loopAtomsAndIdentifyEvents()
 		
 		if( !papreca_config.predefinedCatalogHasBondFormEvents( ) ){ return; }
@@ -841,8 +938,12 @@ namespace PAPRECA{
 		
 		double *iatom_xyz = atom_xyz[iatom];
 		const int iatom_type = atom_types[iatom];
-			
+		if( !papreca_config.atomTypeHasCatalogFlag( iatom_type , CATALOG_BOND_FORM ) ){ return; } //iatom cannot form bonds with any neighbor type
 		
+		//Minimum image distances of all neighbors from iatom
+		thread_local MinImageBatch batch; //Buffers are reused between calls (see PAPRECA::MinImageBatch)
+		batch.compute( lmp , iatom_xyz , atom_xyz , neighbors , neighbors_num );
+		const double *sqr_dists = batch.getSqrDists( );
 		
 		for( int j = 0; j < neighbors_num; ++j ){ //Scan all neibs of iatom (parent atom) on the half list
 		
@@ -851,13 +952,11 @@ namespace PAPRECA{
 			//Get neib properties
 			const LAMMPS_NS::tagint jneib_id = atom_ids[jneib];
 			const LAMMPS_NS::tagint jneib_mol = atom_mol[jneib];
-			double *jneib_xyz = atom_xyz[jneib];
 			const int jneib_type = atom_types[jneib];
 			
 		
 			
-			INT_PAIR type_pair( iatom_type , jneib_type );
-			PredefinedBondForm *form_template = papreca_config.getBondFormFromAtomTypesPair( type_pair ); //The inverse pair is already in the catalog so no need to search twice
+			PredefinedBondForm *form_template = papreca_config.getBondFormFromAtomTypes( iatom_type , jneib_type ); //The inverse pair is already in the catalog so no need to search twice
 				
 			if( form_template ){ //This indicates that the bond is formable (i.e., form_template is not NULL).
 				
@@ -871,10 +970,10 @@ namespace PAPRECA{
 							
 					const double bond_sqr_dist = form_template->getBondDistSqr( );
 					
-					double pair_sqr_dist = get3DSqrDistWithPBC( lmp  , iatom_xyz , jneib_xyz ); //Run Custom minimum image distance function with periodicity along the x-, and y-directions (but now on the y-direction).
+					const double &pair_sqr_dist = sqr_dists[j]; //Minimum image distance (see PAPRECA::MinImageBatch)
 					if( pair_sqr_dist <= bond_sqr_dist ){ //If pair distance smaller than bonding distance add forming event to local events table
 						const double rate = form_template->getRate( );
-						BondForm *bond_form = new BondForm( rate , iatom_id , jneib_id , bond_type , form_template );
+						BondForm *bond_form = Event::newEvent< BondForm >( rate , iatom_id , jneib_id , bond_type , form_template );
 						events_local.push_back( bond_form );					
 					}
 				}
@@ -884,14 +983,14 @@ namespace PAPRECA{
 	}
 	
 	//Monoatomic Desorption events
-	void getMonoDesEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void getMonoDesEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , std::vector< Event* > &events_local , BondGraph &atomID2bonds ){
 		
 		/// Checks if the parent atom is candidate to monoatomic desorption events (a.k.a. PAPRECA::PredefinedMonoatomicDesorption). Detected events are inserted in events_local vector, which is a container of PAPRECA::Event object and stores the events detected on the current MPI process.
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] iatom local index of current atom.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::loopAtomsAndIdentifyEvents()
 		
 		if( !papreca_config.predefinedCatalogHasMonoDesEvents( ) ){ return; }
@@ -900,7 +999,7 @@ namespace PAPRECA{
 		int *atom_types = ( int *)lammps_extract_atom( lmp , "type" );//extract atom types
 		
 		const LAMMPS_NS::tagint iatom_id = atom_ids[iatom];
-		BOND_VECTOR &bonds = atomID2bonds[iatom_id]; //retrieve unordered set from map, if map already exists
+		const BondRange bonds = atomID2bonds.getBonds( iatom_id ); //retrieve bonds of current atom (empty if the atom has no bonds)
 		
 		const LAMMPS_NS::tagint iatom_type = atom_types[iatom];
 		
@@ -912,7 +1011,7 @@ namespace PAPRECA{
 				if( bonds.empty( ) ){ //Currently, only LONE (non-bonded) single atom desorption is supported. This line checks if the current atom has bonds with other atoms.
 					const double rate = monodes_template->getRate( );
 					const int parent_type = monodes_template->getParentAtomType( );
-					MonoatomicDesorption *monodes = new MonoatomicDesorption( rate , iatom_id , parent_type , monodes_template );
+					MonoatomicDesorption *monodes = Event::newEvent< MonoatomicDesorption >( rate , iatom_id , parent_type , monodes_template );
 					events_local.push_back( monodes );
 				}
 			
@@ -922,7 +1021,28 @@ namespace PAPRECA{
 	}
 	
 	//General functions
-	void  loopAtomsAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds , double &film_height ){
+	void detectionAbortWithMessage( const std::string &message ){
+		
+		/// Reports an error raised by the per-atom event detection functions. Outside OpenMP parallel regions this simply calls PAPRECA::allAbortWithMessage().
+		/// Inside the parallel region of PAPRECA::loopAtomsAndIdentifyEventsWithThreads() the (first) message is only recorded, because MPI is initialized with MPI_THREAD_FUNNELED and worker threads must not call MPI. The master thread aborts after the threads join.
+		/// @param[in] message error message.
+		/// @note Callers must return (or skip the current event) after calling this function, since it returns inside parallel regions.
+		
+		#ifdef _OPENMP
+		if( omp_in_parallel( ) ){
+			#pragma omp critical( papreca_detection_error )
+			{
+				if( detection_error.empty( ) ){ detection_error = message; }
+			}
+			return;
+		}
+		#endif
+		
+		allAbortWithMessage( MPI_COMM_WORLD , message );
+		
+	}
+	
+	void  loopAtomsAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height ){
 	
 		/// 1) Calculates film height (if that is requested by the user). 2) Discovers events and inserts them in the PAPRECA::Event objects vector (storing all events detected on the current MPI process). PAPRECA::BondBreak, PAPRECA::Deposition, PAPRECA::MonoatomicDesorption, and PAPRECA::Diffusion are discovered through a full neighbors list. PAPRECA::BondForm are detected using a half-neighbors list. This is done because bondbreak, deposition, monoatomic desorption, and diffusion events perform collision checks which require full neighbor lists (because we need to know all the neighbors of each atom). On the other hand, it is more efficient to check for PAPRECA:BondForm events using a half neighbors list that include each neighbor pair once.
 		/// @param[in] lmp pointer to LAMMPS object.
@@ -931,12 +1051,19 @@ namespace PAPRECA{
 		/// @param[in] KMC_loopid current PAPRECA step.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @param[in,out] film_height film height at current PAPRECA step.
 		/// @see PAPRECA::calcFilmHeight(), PAPRECA::getBondBreakingEventsFromAtom(), PAPRECA::getDepoEventsFromAtom(), PAPRECA::getDiffEventsFromAtom(), PAPRECA::getMonoDesEventsFromAtom(), PAPRECA::getBondFormEventsFromAtom()
 		/// @note The user is advised to consult the LAMMPS documentation (https://docs.lammps.org/) for more information about neighbors lists as well as details related to the lammps_neighlist_num_elements andlammps_neighlist_element_neighbors functions used to retrieve the neighbor lists containers.
 		
 		calcFilmHeight( lmp , proc_id , KMC_loopid ,  papreca_config , film_height );
+		papreca_config.setRanNumStep( KMC_loopid );
+		papreca_config.resetDepoSiteGrids( lmp );
+		
+		if( papreca_config.getDetectionThreadsNum( ) > 1 ){
+			loopAtomsAndIdentifyEventsWithThreads( lmp , proc_id , nprocs , papreca_config , events_local , atomID2bonds , film_height );
+			return;
+		}
 		
 		int neiblist_id = lammps_find_fix_neighlist( lmp , "papreca" , 1 ); //Get neighbors list with ID 1 (full list as in the papreca fix)
 		if( neiblist_id == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Lammps could not find full neib list from fix papreca (fix papreca all papreca) command. Please ensure that the fix papreca command is present in your LAMMPS input file." ); }
@@ -973,4 +1100,127 @@ namespace PAPRECA{
 		
 	}
 
+	void loopAtomsAndIdentifyEventsWithThreads( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height ){
+		
+		/// Threaded (OpenMP) version of the atom loops of PAPRECA::loopAtomsAndIdentifyEvents() (used if detection_threads > 1 in the PAPRECA input file). The full and half neighbor lists are split into contiguous chunks of atoms (one per thread).
+		/// Each thread inserts the detected events in its own buffer, creates events in its own event pools (see Event::initEventPools()), counts deposition tries/sites on its own counters (see PAPRECA::PredefinedDeposition::mergeThreadCounters()), and draws random numbers from its own stream (see PaprecaConfig::seedThreadRanNumGenerators()).
+		/// The buffers are appended to events_local in thread order. Hence, events_local is ordered exactly as in serial detection.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] proc_id ID of current MPI process.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in] film_height film height at current PAPRECA step.
+		/// @note The random numbers drawn by threads depend on the number of threads. Hence, results are reproducible for the same random seed, number of MPI processes, and number of detection threads. With counter_rng active, the random numbers do not depend on the number of threads (see PaprecaConfig::getDetectionRanNums()).
+		/// @see PAPRECA::loopAtomsAndIdentifyEvents()
+		
+		#ifdef _OPENMP
+		const int threads_num = papreca_config.getDetectionThreadsNum( );
+		if( !papreca_config.counterRNGIsActive( ) ){ papreca_config.seedThreadRanNumGenerators( lmp ); } //Thread streams are not used with counter-based random numbers. Skipping the seeding keeps the main stream independent of the number of threads.
+		
+		const int full_list_id = lammps_find_fix_neighlist( lmp , "papreca" , 1 ); //Get neighbors list with ID 1 (full list as in the papreca fix)
+		const int half_list_id = lammps_find_fix_neighlist( lmp , "papreca" , 2 ); //Get neighbors list with ID 2 (half list as in the papreca fix)
+		if( full_list_id == -1 || half_list_id == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Lammps could not find full/half neib lists from fix papreca (fix papreca all papreca) command. Please ensure that the fix papreca command is present in your LAMMPS input file." ); }
+		const int full_atoms_num = lammps_neighlist_num_elements( lmp , full_list_id );
+		const int half_atoms_num = lammps_neighlist_num_elements( lmp , half_list_id );
+		
+		std::vector< std::vector< Event* > > full_events( threads_num ) , half_events( threads_num ); //Thread-local event buffers
+		
+		#pragma omp parallel num_threads( threads_num )
+		{
+			std::vector< Event* > &full_events_thread = full_events[omp_get_thread_num( )];
+			std::vector< Event* > &half_events_thread = half_events[omp_get_thread_num( )];
+			int iatom = -1 , neighbors_num = -1 , *neighbors = NULL;
+			
+			//Static scheduling assigns a contiguous chunk of atoms to each thread (always the same chunk for the same number of atoms and threads)
+			#pragma omp for schedule( static )
+			for( int i = 0; i < full_atoms_num; ++i ){
+				lammps_neighlist_element_neighbors( lmp , full_list_id , i , &iatom , &neighbors_num , &neighbors );
+				getBondBreakingEventsFromAtom( lmp , papreca_config , iatom , neighbors , neighbors_num , full_events_thread , atomID2bonds );
+				getDepoEventsFromAtom( lmp  , papreca_config , proc_id , nprocs , iatom , neighbors , neighbors_num  , film_height , full_events_thread );
+				getDiffEventsFromAtom( lmp , papreca_config , iatom , neighbors , neighbors_num , full_events_thread , atomID2bonds );
+				getMonoDesEventsFromAtom( lmp , papreca_config , iatom , full_events_thread , atomID2bonds );
+			}
+			
+			#pragma omp for schedule( static )
+			for( int i = 0; i < half_atoms_num; ++i ){
+				lammps_neighlist_element_neighbors( lmp , half_list_id , i , &iatom , &neighbors_num , &neighbors );
+				getBondFormEventsFromAtom( lmp , papreca_config , iatom , neighbors , neighbors_num , half_events_thread , atomID2bonds );
+			}
+		}
+		
+		if( !detection_error.empty( ) ){ allAbortWithMessage( MPI_COMM_WORLD , detection_error ); } //Errors recorded by worker threads (see PAPRECA::detectionAbortWithMessage())
+		
+		//Merge thread-local buffers and counters in thread order
+		for( const auto &events_thread : full_events ){ events_local.insert( events_local.end( ) , events_thread.begin( ) , events_thread.end( ) ); }
+		for( const auto &events_thread : half_events ){ events_local.insert( events_local.end( ) , events_thread.begin( ) , events_thread.end( ) ); }
+		papreca_config.mergeDepositionThreadCounters( );
+		#else
+		allAbortWithMessage( MPI_COMM_WORLD , "Threaded event detection (detection_threads > 1) requires PAPRECA to be compiled with OpenMP support." );
+		#endif
+		
+	}
+
+	void updateEventCatalogAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height ){
+		
+		/// Incremental alternative to PAPRECA::loopAtomsAndIdentifyEvents() (used when incremental_detection is activated in the PAPRECA input file). 1) Calculates film height (if that is requested by the user). 2) Rescans only the local atoms whose events might have been affected by the previously executed event(s) and updates their entries in the PAPRECA::EventCatalog. 3) Fills events_local with the PAPRECA::Event objects of all local atoms.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] proc_id ID of current MPI process.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @param[in] KMC_loopid current PAPRECA step.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] film_height film height at current PAPRECA step.
+		/// @see PAPRECA::loopAtomsAndIdentifyEvents(), PAPRECA::EventCatalog
+		/// @note The PAPRECA::Event objects in events_local are owned by event_catalog. Hence, events_local has to be cleared (and NOT released through Event::deleteAndClearLocalEvents() or Event::resetEventPoolsAndClearLocalEvents()) at the end of the PAPRECA step.
+		/// @note Each event is stored in the catalog entry of its parent atom. Bond formation events are stored in the entry of the atom with the smaller ID in the pair (scanned on the full neighbors list), so every pair has exactly one entry on exactly one MPI process regardless of how LAMMPS orders local atoms. Both atoms of a modified pair lie within the neighbor cutoff of each other, so the pair is always rescanned when either atom is touched.
+		
+		calcFilmHeight( lmp , proc_id , KMC_loopid ,  papreca_config , film_height );
+		papreca_config.setRanNumStep( KMC_loopid );
+		
+		const bool full_rebuild = event_catalog.fullRebuildIsRequired( lmp , papreca_config , film_height );
+		if( full_rebuild ){ event_catalog.clear( lmp ); }
+		
+		std::vector< char > dirty_atoms;
+		event_catalog.fillDirtyAtomsVec( lmp , dirty_atoms , full_rebuild );
+		
+		LAMMPS_NS::tagint *atom_ids = ( LAMMPS_NS::tagint *)lammps_extract_atom( lmp , "id" ); //extract atom ids
+		for( size_t i = 0; i < dirty_atoms.size( ); ++i ){
+			if( dirty_atoms[i] ){ event_catalog.resetAtomEvents( lmp , atom_ids[i] ); }
+		}
+		
+		int neiblist_id = lammps_find_fix_neighlist( lmp , "papreca" , 1 ); //Get neighbors list with ID 1 (full list as in the papreca fix)
+		if( neiblist_id == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Lammps could not find full neib list from fix papreca (fix papreca all papreca) command. Please ensure that the fix papreca command is present in your LAMMPS input file." ); }
+		int iatom = -1 , neighbors_num = -1 , *neighbors = NULL;
+		
+		int atoms_num = lammps_neighlist_num_elements( lmp , neiblist_id );
+		std::vector< int > form_neighbors; //Neighbors of iatom with larger IDs (i.e., the pairs keyed by iatom for bond formation events)
+		
+		//Loop over full list (dirty atoms only)
+		for ( int i = 0; i < atoms_num; ++i ){
+			lammps_neighlist_element_neighbors( lmp , neiblist_id , i , &iatom , &neighbors_num , &neighbors );
+			if( !dirty_atoms[iatom] ){ continue; }
+			std::vector< Event* > &atom_events = event_catalog.getAtomEvents( atom_ids[iatom] );
+			getBondBreakingEventsFromAtom( lmp , papreca_config , iatom , neighbors , neighbors_num , atom_events , atomID2bonds );
+			getDepoEventsFromAtom( lmp  , papreca_config , proc_id , nprocs , iatom , neighbors , neighbors_num  , film_height , atom_events );
+			getDiffEventsFromAtom( lmp , papreca_config , iatom , neighbors , neighbors_num , atom_events , atomID2bonds );
+			getMonoDesEventsFromAtom( lmp , papreca_config , iatom , atom_events , atomID2bonds );
+			
+			//Bond formation events are keyed by the atom with the smaller ID in the pair. Contrary to the pairs of the half neighbors list, this does not depend on the order of local atoms (which changes when LAMMPS sorts or migrates atoms).
+			form_neighbors.clear( );
+			for( int j = 0; j < neighbors_num; ++j ){
+				if( atom_ids[getMaskedNeibIndex( neighbors , j )] > atom_ids[iatom] ){ form_neighbors.push_back( neighbors[j] ); }
+			}
+			int form_neighbors_num = form_neighbors.size( );
+			getBondFormEventsFromAtom( lmp , papreca_config , iatom , form_neighbors.data( ) , form_neighbors_num , atom_events , atomID2bonds );
+		}
+		
+		event_catalog.exportLocalEvents( lmp , events_local );
+		event_catalog.saveRebuildState( lmp , film_height );
+		
+	}
+
 } //End of PAPRECA Namespace
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 //System Headers
 #include <vector>
+#include <string>
 #include <mpi.h>
 
 
@@ -38,6 +39,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 //KMC headers
 #include "event.h"
 #include "event_list.h"
+#include "event_catalog.h"
 #include "bond.h"
 #include "papreca_config.h"
 #include "lammps_wrappers.h"
@@ -47,39 +49,44 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace PAPRECA{
 
 	//Diffusion events
-	const bool feCandidateHas4PO4Neibs( PaprecaConfig &papreca_config , PredefinedDiffusionHop *diff_template , LAMMPS_NS::tagint *atom_ids , int *atom_types , int *neighbors , int &neighbors_num , ATOM2BONDS_MAP &atomID2bonds );
+	const bool feCandidateHas4PO4Neibs( PaprecaConfig &papreca_config , PredefinedDiffusionHop *diff_template , LAMMPS_NS::tagint *atom_ids , int *atom_types , int *neighbors , int &neighbors_num , BondGraph &atomID2bonds );
 	const double getRate4ContaminantsDiffEvent( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , PredefinedDiffusionHop *diff_template , LAMMPS_NS::tagint *atom_ids , int *atom_types , double **atom_xyz , int *neighbors , int &neighbors_num , double *candidate_xyz , double *parent_xyz );
-	void getDiffPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp  , PaprecaConfig &papreca_config , const double *iatom_xyz , double *candidate_xyz , PredefinedDiffusionHop *diff_template );
+	void getDiffPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp  , PaprecaConfig &papreca_config , const LAMMPS_NS::tagint &iatom_id , const double *iatom_xyz , double *candidate_xyz , PredefinedDiffusionHop *diff_template );
 	const bool candidateDiffHasCollisions( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int *neighbors , int &neighbors_num , double *candidate_xyz , const int &diffused_type , const double *iatom_xyz , const int &iatom_type );
-	void getDiffEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds );
+	void getDiffEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector< Event* > &events_local , BondGraph &atomID2bonds );
 	
 	//Deposition events
 	const bool atomIsInDepoScanRange( PaprecaConfig &papreca_config , double *iatom_xyz , double &film_height );
-	void getDepoPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double *iatom_xyz ,  double *candidate_xyz , PredefinedDeposition *depo_template );
+	void getDepoPointCandidateCoords( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const LAMMPS_NS::tagint &iatom_id , double *iatom_xyz ,  double *candidate_xyz , PredefinedDeposition *depo_template );
 	const bool depoCandidateIsBelowRejectionHeight( PaprecaConfig &papreca_config , double *candidate_xyz , const double &film_height );
 	void getMolCoords( LAMMPS_NS::LAMMPS *lmp , double **mol_xyz , double **mol_dx , const int &mol_natoms , double *candidate_center );
 	void initMolCoordsArr( double ***mol_xyz , const int &mol_natoms );
 	void deleteMolCoordsArr( double **mol_xyz , const int &mol_natoms );
-	bool atomHasCollisionWithMolAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , double *atom_xyz , const int &atom_type , const int &mol_natoms , double **mol_xyz , int *mol_atomtype );
+	bool atomHasCollisionWithMolAtoms( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double *atom_xyz , const int &atom_type , const double *candidate_center , PredefinedDeposition *depo_template , const bool &use_cells );
+	bool atomHasCollisionWithMolAtomsPairwise( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const double *atom_xyz , const int &atom_type , const double *candidate_center , PredefinedDeposition *depo_template );
+	bool atomHasCollisionWithMolAtomsInCells( PaprecaConfig &papreca_config , const double *dist , const int &atom_type , PredefinedDeposition *depo_template );
 	bool candidateDepoHasCollisions( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &nprocs , PaprecaConfig &papreca_config , int *neighbors , int neighbors_num , double *candidate_center , double *iatom_xyz , const int &iatom_type , PredefinedDeposition *depo_template );
 	void getDepoEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &iatom , int *neighbors , int &neighbors_num , double &film_height , std::vector< Event* > &events_local );
 	
 	//Bond-Breaking and formation events
 	const bool headAtomIsCatalyzed( PredefinedReaction *reaction_template , int *atom_types , int *neighbors , int &neighbors_num );
 	const bool bondLengthIsWithinBreakLimits( LAMMPS_NS::LAMMPS *lmp , PredefinedBondForm *bonding_template , const int &iatom , const LAMMPS_NS::tagint &jatom_id );
-	void getBondBreakingEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds );
+	void getBondBreakingEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , BondGraph &atomID2bonds );
 	const bool atomsBelong2TheSameMol( const LAMMPS_NS::tagint &iatom_mol , const LAMMPS_NS::tagint &jneib_mol );
-	const bool atomHasMaxBonds( PaprecaConfig &papreca_config , ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int atom_type );
-	bool bondBetweenAtomsExists( ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom1_id , const LAMMPS_NS::tagint &atom2_id );
-	const bool atomCandidatesAreLone( const LAMMPS_NS::tagint atom1_id , const LAMMPS_NS::tagint atom2_id , ATOM2BONDS_MAP &atomID2bonds );
-	const bool atomHasMaxBondTypes( PaprecaConfig &papreca_config , ATOM2BONDS_MAP &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int &atom_type , const int &bond_type );
-	void getBondFormEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds );
+	const bool atomHasMaxBonds( PaprecaConfig &papreca_config , BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int atom_type );
+	bool bondBetweenAtomsExists( BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom1_id , const LAMMPS_NS::tagint &atom2_id );
+	const bool atomCandidatesAreLone( const LAMMPS_NS::tagint atom1_id , const LAMMPS_NS::tagint atom2_id , BondGraph &atomID2bonds );
+	const bool atomHasMaxBondTypes( PaprecaConfig &papreca_config , BondGraph &atomID2bonds , const LAMMPS_NS::tagint &atom_id , const int &atom_type , const int &bond_type );
+	void getBondFormEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , int *neighbors , int &neighbors_num , std::vector<Event*> &events_local , BondGraph &atomID2bonds );
 	
 	//Monoatomic Desorption events
-	void getMonoDesEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds );
+	void getMonoDesEventsFromAtom( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , const int &iatom , std::vector< Event* > &events_local , BondGraph &atomID2bonds );
 	
 	//General Functions
-	void loopAtomsAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , ATOM2BONDS_MAP &atomID2bonds , double &film_height );
+	void detectionAbortWithMessage( const std::string &message );
+	void loopAtomsAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height );
+	void loopAtomsAndIdentifyEventsWithThreads( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height );
+	void updateEventCatalogAndIdentifyEvents( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , int &nprocs , const int &KMC_loopid , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector<Event*> &events_local , BondGraph &atomID2bonds , double &film_height );
 		
 
 }//end of PAPRECA namespace 
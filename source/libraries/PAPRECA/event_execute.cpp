@@ -24,73 +24,181 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 	
-	//Formation events
-	void fillFormTransferDataArr( BondForm *bond_form , int *form_data ){
+	//Event records
+	void fillBondFormRecord( BondForm *bond_form , EventRecord &record ){
 		
-		/// Serializes (prepares) data for calls to MPI function related to the execution of PAPRECA::BondForm events.
+		/// Serializes (prepares) a PAPRECA::BondForm event for communication to all MPI processes.
 		/// @param[in] bond_form PAPRECA::BondForm event to be executed.
-		/// @param[in,out] form_data 2-element array of int data.
-		/// @note form_data[0] stores the bond type. form_data[0] tells us if we need to delete atoms after bond form or not (1 delete/0 don't delete).
-		/// @see PAPRECA::deserializeFormTransferDataArr(), PAPRECA::executeBondForm()
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note record.tagints[0] and record.tagints[1] store the IDs of the bonded atoms. record.ints[0] stores the bond type. record.ints[1] tells us if we need to delete atoms after bond form or not (1 delete/0 don't delete).
+		/// @see PAPRECA::executeBondForm()
 		
-		form_data[0] = bond_form->getBondType( );
+		record.tagints[0] = bond_form->getAtom1ID( );
+		record.tagints[1] = bond_form->getAtom2ID( );
+		record.ints[0] = bond_form->getBondType( );
 		
 		PredefinedBondForm *form_template = bond_form->getFormTemplate( );
-		form_data[1] = form_template->isDeleteAtoms( );
+		record.ints[1] = form_template->isDeleteAtoms( );
+		
+	}
+	
+	void fillBondBreakRecord( BondBreak *bond_break , EventRecord &record ){
+		
+		/// Serializes (prepares) a PAPRECA::BondBreak event for communication to all MPI processes.
+		/// @param[in] bond_break PAPRECA::BondBreak event to be executed.
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note record.tagints[0] and record.tagints[1] store the IDs of the bonded atoms. record.ints[0] stores the bond type.
+		/// @see PAPRECA::executeBondBreak()
+		
+		record.tagints[0] = bond_break->getAtom1ID( );
+		record.tagints[1] = bond_break->getAtom2ID( );
+		record.ints[0] = bond_break->getBondType( );
+		
+	}
+	
+	void fillDepositionRecord( Deposition *depo , EventRecord &record ){
+		
+		/// Serializes (prepares) a PAPRECA::Deposition event for communication to all MPI processes.
+		/// @param[in] depo PAPRECA::Deposition event to be executed.
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note record.doubles[0], record.doubles[1], record.doubles[2] are the deposition site coordinates (x,y, and z). record.doubles[3], record.doubles[4], record.doubles[5] are the coordinates of the center of rotation of the molecule. record.doubles[6] is the angle of rotation. record.doubles[7] is the insertion velocity. record.template_id is the ID of the PAPRECA::PredefinedDeposition template (used to retrieve the adsorbate name on all MPI processes).
+		/// @see PAPRECA::executeDeposition()
+		
+		copyDoubleArray3D( record.doubles , depo->getSitePos( ) );
+		copyDoubleArray3D( record.doubles , depo->getRotPos( ) , 3 , 5 , 0 , 2 );
+		record.doubles[6] = depo->getRotTheta( );
+		record.doubles[7] = depo->getDepoTemplate( )->getInsertionVel( );
+		record.template_id = depo->getDepoTemplate( )->getTemplateID( );
+		
+	}
+	
+	void fillDiffusionRecord( Diffusion *diff , EventRecord &record ){
+		
+		/// Serializes (prepares) a PAPRECA::Diffusion event for communication to all MPI processes.
+		/// @param[in] diff PAPRECA::Diffusion event to be executed.
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note record.tagints[0] is the parent atom ID. record.ints[0] contains the parent type and record.ints[1] contains the diffused type. record.doubles[0], record.doubles[1], record.doubles[2] contain the x,y, and z coordinates of the diffusion point (vacancy). record.doubles[3], record.doubles[4], and record.doubles[5] contain the xyz coordinates of the parent atom. record.doubles[6] contains the insertion velocity. record.template_id is the ID of the PAPRECA::PredefinedDiffusionHop template (used to retrieve the diffvec and diffusion styles on all MPI processes).
+		/// @see PAPRECA::executeDiffusion()
+		
+		record.tagints[0] = diff->getParentId( );
+		record.ints[0] = diff->getParentType( );
+		record.ints[1] = diff->getDiffusedType( );
+		copyDoubleArray3D( record.doubles , diff->getVacancyPos( ) ); //We can use the copyDoubleArray3D (utilities.h/cpp) function here as it only copies the first 3 elements of the vector (default start/end arguments).
+		copyDoubleArray3D( record.doubles , diff->getParentPos( ) , 3 , 5 , 0 , 2 );
+		record.doubles[6] = diff->getDiffTemplate( )->getInsertionVel( );
+		record.template_id = diff->getDiffTemplate( )->getTemplateID( );
+		
+	}
+	
+	void fillMonoatomicDesorptionRecord( MonoatomicDesorption *monodes , EventRecord &record ){
+		
+		/// Serializes (prepares) a PAPRECA::MonoatomicDesorption event for communication to all MPI processes.
+		/// @param[in] monodes PAPRECA::MonoatomicDesorption event to be executed.
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note record.tagints[0] is the ID of the desorbed atom. record.ints[0] is the parent type.
+		/// @see PAPRECA::executeMonoatomicDesorption()
+		
+		record.tagints[0] = monodes->getParentId( );
+		record.ints[0] = monodes->getParentType( );
+		
 	}
 	
-	void deserializeFormTransferDataArr( int *form_data , int &bond_type , int &delete_atoms ){
+	void fillEventRecord( Event *event , EventRecord &record ){
+		
+		/// Serializes (prepares) the selected PAPRECA::Event for communication to all MPI processes. Casts the event to the correct child type and calls the relevant fill function.
+		/// @param[in] event PAPRECA::Event selected (to be executed).
+		/// @param[in,out] record PAPRECA::EventRecord to be filled.
+		/// @note This function is only called on the MPI process that detected the event.
+		/// @see PAPRECA::broadcastEventRecord()
+		
+		record.type = event->getType( );
+		
+		switch( record.type ){
+			case EVENT_RXN_FORM:
+				fillBondFormRecord( static_cast< BondForm* >( event ) , record );
+				break;
+			case EVENT_RXN_BREAK:
+				fillBondBreakRecord( static_cast< BondBreak* >( event ) , record );
+				break;
+			case EVENT_DEPO:
+				fillDepositionRecord( static_cast< Deposition* >( event ) , record );
+				break;
+			case EVENT_DIFF:
+				fillDiffusionRecord( static_cast< Diffusion* >( event ) , record );
+				break;
+			case EVENT_MONO_DES:
+				fillMonoatomicDesorptionRecord( static_cast< MonoatomicDesorption* >( event ) , record );
+				break;
+			default:
+				allAbortWithMessage( MPI_COMM_WORLD , "Unknown event type " + std::to_string( record.type ) + " in fillEventRecord function in event_execute.cpp." );
+		}
 		
-		/// Deserializes (post-processes) data after calls to MPI function related to the execution of PAPRECA::BondForm events.
-		/// @param[in] form_data 2-element array of serialized (in fillFormTransferDataArr() function) data.
-		/// @param[in,out] bond_type type of bond.
-		/// @param[in,out] delete_atoms 0 if atoms are not deleted after the execution of the bond formation event, or 1 if atoms are deleted.
-		/// @see PAPRECA::fillFormTransferDataArr(), PAPRECA::executeBondForm()
+	}
+	
+	void broadcastEventRecord( EventRecord &record , const int &event_proc ){
+		
+		/// Communicates the PAPRECA::EventRecord of the selected event from the MPI process that detected the event to all other MPI processes, using a single MPI_Bcast.
+		/// @param[in,out] record PAPRECA::EventRecord. Filled on event_proc (see PAPRECA::fillEventRecord()) and overwritten on all other MPI processes.
+		/// @param[in] event_proc MPI process that detected the selected event.
+		/// @note The record is communicated as raw bytes. This is safe because all MPI processes run the same executable (i.e., the layout of PAPRECA::EventRecord and the size of LAMMPS_NS::tagint are identical on all MPI processes). It also avoids separate broadcasts for tagints, ints, doubles, and strings.
 		
-		bond_type = form_data[0];
-		delete_atoms = form_data[1];
+		MPI_Bcast( &record , sizeof( EventRecord ) , MPI_BYTE , event_proc , MPI_COMM_WORLD );
 		
 	}
 	
-	void executeBondForm( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event ){
+	const bool eventRecordDeletesAtoms( PaprecaConfig &papreca_config , const EventRecord &record ){
 		
-		/// Executes PAPRECA::BondForm event. This is done by 1) communicating information from the MPI process that detected the event to all other MPI processes, and 2) calling formBond() and potentially deleteAtoms() after the appropriate data have been communicated.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] record PAPRECA::EventRecord of an event (already communicated to all MPI processes).
+		/// @return true if the execution of the record deletes atoms (i.e., monoatomic desorptions, bond formations with delete_atoms, and move_del diffusions), false otherwise.
+		/// @see PAPRECA::getExecutableRecordsNum()
+		
+		switch( record.type ){
+			case EVENT_MONO_DES:
+				return true;
+			case EVENT_RXN_FORM:
+				return record.ints[1];
+			case EVENT_DIFF:
+				return papreca_config.getDiffusionTemplate( record.template_id )->getDiffusionStyle( ) == "move_del";
+			default:
+				return false;
+		}
+		
+	}
+	
+	//Formation events
+	void executeBondForm( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog ){
+		
+		/// Executes PAPRECA::BondForm event by calling formBond() and potentially deleteAtoms(), on all MPI processes.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
-		/// @param[in] event_proc MPI process calling the function (i.e., proc that detected this event).
-		/// @param[in] selected_event PAPRECA::Event selected (to be executed). Casted to the correct type (i.e., PAPRECA::BondForm) before execution.
+		/// @param[in] event_proc MPI process that detected this event.
+		/// @param[in] record PAPRECA::EventRecord of the selected event (already communicated to all MPI processes). See PAPRECA::fillBondFormRecord() for the layout.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class. Atoms touched by the executed event are marked so their events are rescanned in the next PAPRECA step (only if incremental_detection is active).
 		/// @see PAPRECA::formBond(), PAPRECA::deleteAtoms()
 		
 		LAMMPS_NS::tagint atom_ids[2];
-		atom_ids[0] = -1;
-		atom_ids[1] = -2;
-		int form_data[2];
-		int bond_type = -3;
-		int delete_atoms = -4;
+		atom_ids[0] = record.tagints[0];
+		atom_ids[1] = record.tagints[1];
+		const int &bond_type = record.ints[0];
+		const int &delete_atoms = record.ints[1];
 		
-		if( proc_id == event_proc ){ //retrieve information in event_proc !EXTRA CAUTION HERE: The selected_event pointer is NULL for all other procs EXCEPT for the event proc
-			
-			BondForm *bond_form = dynamic_cast<BondForm*>( selected_event ); //Cast as BondForm to access member variables of bond form
-			
-			atom_ids[0] = bond_form->getAtom1ID( );
-			atom_ids[1] = bond_form->getAtom2ID( );
-			fillFormTransferDataArr( bond_form , form_data );
-			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  \n Executing bond formation event from proc %d, BOND_TYPE=%d , ATOM1_ID=%d , ATOM2_ID=%d \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , form_data[0] , atom_ids[0] , atom_ids[1] );
+		if( proc_id == event_proc ){
+			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  \n Executing bond formation event from proc %d, BOND_TYPE=%d , ATOM1_ID=%d , ATOM2_ID=%d \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , bond_type , atom_ids[0] , atom_ids[1] );
 		}
-		
-		
-		//Here we use 2 separate MPI_Bcasts for safety, since tagint adotps either sizeof( int_32 ) or sizeof( int_64 ) during compilation and casting everything as MPI_INT types might cause runtime errors or undefined behavior.
-		MPI_Bcast( atom_ids , 2 , MPI_LMP_TAGINT , event_proc , MPI_COMM_WORLD ); //Using 2 different casts because there is a difference between LMP_TAGINT and MPI_INT types.
-		MPI_Bcast( form_data , 2 , MPI_INT , event_proc , MPI_COMM_WORLD );
-		deserializeFormTransferDataArr( form_data , bond_type , delete_atoms );
 
-		formBond( lmp , atom_ids[0] , atom_ids[1] , bond_type ); //Now we can safely call this on all procs, since all procs know the important event details (i.e., atom1id, atom2id, bond_type )
+		if( delete_atoms ){
+			event_catalog.markDeletedAtoms( lmp , atom_ids , 2 );
+		}else{
+			event_catalog.markTouchedAtoms( lmp , atom_ids , 2 );
+		}
+		
+		formBond( lmp , atom_ids[0] , atom_ids[1] , bond_type , papreca_config.nativeExecutionIsActive( ) ); //Now we can safely call this on all procs, since all procs know the important event details (i.e., atom1id, atom2id, bond_type )
 		if( proc_id == 0 ){ papreca_config.getLogFile( ).appendBondForm( KMC_loopid , time , atom_ids[0] , atom_ids[1] , bond_type ); }
 		
 		if( delete_atoms ){ //This means that we have to deal with the bond formation even between 2 lone oxygens
 		
-			deleteAtoms( lmp , atom_ids , 2 , "no" , "no" );
+			deleteAtoms( lmp , atom_ids , 2 , "no" , "no" , papreca_config.nativeExecutionIsActive( ) );
 		
 		}else{
 			//Configure internal nve/limit integrator if selected by user in the PAPRECA input file
@@ -104,38 +212,30 @@ namespace PAPRECA{
 	}
 	
 	//Bond-breaking events
-	void executeBondBreak( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event , ATOM2BONDS_MAP &atomID2bonds ){
+	void executeBondBreak( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , BondGraph &atomID2bonds , EventCatalog &event_catalog ){
 		
-		/// Executes PAPRECA::Bondbreak event. This is done by 1) communicating information from the MPI process that detected the event to all other MPI processes, and 2) calling deleteBond() after the appropriate data have been communicated.
+		/// Executes PAPRECA::Bondbreak event by calling deleteBond() on all MPI processes.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
-		/// @param[in] event_proc MPI process calling the function (i.e., proc that detected this event).
-		/// @param[in] selected_event selected (for execution) PAPRECA::Event. Casted to the correct type (i.e., PAPRECA::BondBreak) before execution.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] event_proc MPI process that detected this event.
+		/// @param[in] record PAPRECA::EventRecord of the selected event (already communicated to all MPI processes). See PAPRECA::fillBondBreakRecord() for the layout.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class. Atoms touched by the executed event are marked so their events are rescanned in the next PAPRECA step (only if incremental_detection is active).
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
 		/// @see PAPRECA::deleteBond()
 		
 		LAMMPS_NS::tagint atom_ids[2];
-		atom_ids[0] = -1;
-		atom_ids[1] = -2;//Initialize those values at something non realistic for all procs
-		int bond_type = -3;
+		atom_ids[0] = record.tagints[0];
+		atom_ids[1] = record.tagints[1];
+		const int &bond_type = record.ints[0];
 		
-		
-		if( proc_id == event_proc ){ //retrieve information in event_proc !EXTRA CAUTION HERE: The selected_event pointer is NULL for all other procs EXCEPT for event proc
-			
-			BondBreak *bond_break = dynamic_cast<BondBreak*>( selected_event ); //Cast as BondBreak to access member variables of bond break
-			
-			atom_ids[0] = bond_break->getAtom1ID( );
-			atom_ids[1] = bond_break->getAtom2ID( );
-			bond_type = bond_break->getBondType( );
+		if( proc_id == event_proc ){
 			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n Executing bond break event from proc %d, bond_type=%d , atom1_id = %d , atom2_id = %d \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , bond_type , atom_ids[0] , atom_ids[1] );
 		}
 		
-		MPI_Bcast( atom_ids , 2 , MPI_LMP_TAGINT , event_proc , MPI_COMM_WORLD ); //Proc selection was done on proc event_proc so now we need to communicate the event_proc to all procs
-		MPI_Bcast( &bond_type , 1 , MPI_INT , event_proc , MPI_COMM_WORLD ); //Cast bond type separately to avoid data type runtime errors
+		event_catalog.markTouchedAtoms( lmp , atom_ids , 2 );
 		
 		//Breakbond is part of lammps_wrappers
-		deleteBond( lmp , atom_ids[0] , atom_ids[1] , 1 ); //Now we can safely call this on all procs, since all procs know the important event details (i.e., atom1id, atom2id ). Delete special if you are using fix_shake and/or you want to recompute the pairwise lists.
+		deleteBond( lmp , atom_ids[0] , atom_ids[1] , 1 , papreca_config.nativeExecutionIsActive( ) ); //Now we can safely call this on all procs, since all procs know the important event details (i.e., atom1id, atom2id ). Delete special if you are using fix_shake and/or you want to recompute the pairwise lists.
 		
 		//Configure internal nve/limit integrator if selected by user in the PAPRECA input file
 		if( papreca_config.nveLimGroupsAreActive( ) ){ //Meaning that the nve limit option was set in the input file
@@ -148,110 +248,39 @@ namespace PAPRECA{
 		
 	}
 
-
-	void fillDepoDataTransfArr( double *depo_data , Deposition *depo ){
-		
-		/// Serializes (prepares) data for calls to MPI function related to the execution of PAPRECA::Deposition events.
-		/// @param[in,out] depo_data 8-element array of double data for transfer.
-		/// @param[in] depo PAPRECA::Deposition event to be executed.
-		/// @note depo_data[0], depo_data[1], depo_data[2] are the deposition site coordinates (x,y, and z). depo_data[3], depo_data[4], depo_data[5] are the coordinates of the center of rotation of the molecule. depo_data[6] is the angle of rotation. depo_data[7] is the insertion velocity.
-		/// @see PAPRECA::deserializeDepoTransfData(), PAPRECA::executeDeposition()
-		
-		for( int i = 0; i < 3; ++i ){
-				
-			depo_data[i] = depo->getSitePos( )[i];
-				
-		}
-			
-		for( int i = 3; i < 6; ++i ){
-				
-			depo_data[i] = depo->getRotPos( )[i-3];
-				
-		}
-			
-		depo_data[6] = depo->getRotTheta( );
-		depo_data[7] = depo->getDepoTemplate( )->getInsertionVel( );
-
-	}
-	
-	void deserializeDepoTransfData( double *depo_data , double *site_pos , double *rot_pos , double &rot_theta , double &insertion_vel ){
-		
-		/// Deserializes (post-processes) data after calls to MPI function related to the execution of PAPRECA::Deposition events.
-		/// @param[in] depo_data 8-element array of serialized (in fillDepoDataTransfArr() function) data.
-		/// @param[in,out] site_pos array containing the coordinates of the center-of-mass of the inserted molecule/atom.
-		/// @param[in,out] rot_pos array containing the coordinates of the center-of-rotation of the inserted molecule.
-		/// @param[in,out] rot_theta angle of rotation of inserted molecule
-		/// @param[in,out] insertion_vel velocity of inserted molecule.
-		/// @see PAPRECA::fillDepoDataTransfArr(), PAPRECA::executeDeposition()
-		
-		for( int i = 0; i < 3; ++i ){
-				
-			site_pos[i] = depo_data[i]; //Get the pos array from the first three values of depo_data
-				
-		}
-			
-		for( int i = 3; i < 6; ++i ){
-				
-			rot_pos[i-3] = depo_data[i]; //Get the rotation from positions 3-6
-				
-		}
-		
-		rot_theta = depo_data[6]; //Get the rotation angle theta from position 7 in the depo_data matrix
-		insertion_vel = depo_data[7]; //Get the insertion velocity from the last position
-		
-		
-	}
-	
-	void executeDeposition( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event ){
+	//Deposition events
+	void executeDeposition( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog ){
 		
-		/// Executes PAPRECA::Deposition event. This is done by 1) communicating information from the MPI process that detected the event to all other MPI processes, and 2) calling insertMolecule() after the appropriate data have been communicated.
+		/// Executes PAPRECA::Deposition event by calling insertMolecule() on all MPI processes.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
-		/// @param[in] event_proc MPI process calling the function (i.e., proc that detected this event).
-		/// @param[in] selected_event PAPRECA::Event selected (to be executed). Casted to the correct type (i.e., PAPRECA::Deposition) before execution.
-		/// @see PAPRECA::insertMolecule(), PAPRECA::resetMobileAtomsGroups()
-		
-		double depo_data[8];
-		char mol_name[1024] = "NONE";
-		int n_mol_name = -1;
-		
-		double site_pos[3];
-		double rot_pos[3];
-		double rot_theta;
-		double insertion_vel;
+		/// @param[in] event_proc MPI process that detected this event.
+		/// @param[in] record PAPRECA::EventRecord of the selected event (already communicated to all MPI processes). See PAPRECA::fillDepositionRecord() for the layout.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class. Atoms touched by the executed event are marked so their events are rescanned in the next PAPRECA step (only if incremental_detection is active).
+		/// @see PAPRECA::insertMolecule(), PAPRECA::resetMobileAtomsGroups(), PAPRECA::initCreatedAtomsNative()
+		
+		double site_pos[3] , rot_pos[3];
+		copyDoubleArray3D( site_pos , record.doubles );
+		copyDoubleArray3D( rot_pos , record.doubles , 0 , 2 , 3 , 5 );
+		const double &rot_theta = record.doubles[6];
+		const double &insertion_vel = record.doubles[7];
+		const char *mol_name = papreca_config.getDepositionTemplate( record.template_id )->getAdsorbateName( ).c_str( ); //The adsorbate name is retrieved from the (identical on all procs) deposition template, so no strings have to be communicated
 		
-		if( proc_id == event_proc ){ //Go to depo event proc
-		
-			Deposition *depo = dynamic_cast<Deposition*>( selected_event ); //Cast as deposition to access member variables of deposition
-			fillDepoDataTransfArr( depo_data , depo );
-			
-			strcpy( mol_name , depo->getMolName( ).c_str( ) ); //Get adsorbate name
-			n_mol_name = strlen( mol_name ) + 1; //Get string size of adsorbate name
-			
-			printf( " ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n Executing deposition event from proc %d, MOL_NAME=%s center_pos=(%f,%f,%f) \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , mol_name , depo_data[0] , depo_data[1] , depo_data[2] );
-			
-			
-			
+		if( proc_id == event_proc ){
+			printf( " ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n Executing deposition event from proc %d, MOL_NAME=%s center_pos=(%f,%f,%f) \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , mol_name , site_pos[0] , site_pos[1] , site_pos[2] );
 		}
 		
-		//Now cast the doubles
-		MPI_Bcast( depo_data , 8 , MPI_DOUBLE , event_proc , MPI_COMM_WORLD );
-		
-		//Finally, BCast the char (first needs casting of n_mol_name to get char size)
-		MPI_Bcast( &n_mol_name , 1 , MPI_INT , event_proc , MPI_COMM_WORLD );
-		MPI_Bcast( mol_name , n_mol_name , MPI_CHAR , event_proc , MPI_COMM_WORLD );
-		
-		//Now deserialize the data on all procs (from the transferred vector) for use with the deposit function
-		deserializeDepoTransfData( depo_data , site_pos , rot_pos , rot_theta , insertion_vel );
-		
 		//Now we are ready to call the insertMolecule function from the lammps_wrappers header, on all procs.
+		const int first_created = lmp->atom->nlocal; //Inserted atoms are appended to the owned atoms
 		insertMolecule( lmp , site_pos , rot_pos , rot_theta , 0 , mol_name );
+		event_catalog.markTouchedMolecule( lmp , site_pos , mol_name );
 		
 		if( proc_id == 0 ){ papreca_config.getLogFile( ).appendDeposition( KMC_loopid , time , site_pos , rot_pos , rot_theta , insertion_vel , mol_name ); }
 
-		if( insertion_vel != 0.0 ){
+		if( insertion_vel != 0.0 && papreca_config.nativeExecutionIsActive( ) && initCreatedAtomsNative( lmp , first_created , papreca_config.getFluidAtomTypes( ) , insertion_vel ) ){
+			return; //Group bits and velocities of the inserted atoms were set directly
+		}else if( insertion_vel != 0.0 ){
 			lmp->input->one( "group new_mol subtract all fluid frozen" ); //This method is used to "select" all newly inserted atoms to a group. This allows to assign velocities. Since the newly inserted atom IS NOT IN ANY GROUP AT THIS MOMENT, you can subtract  fluid+frozen from all to get the new molecule atoms.
 			std::string input_str = "velocity new_mol set NULL NULL " + std::to_string(insertion_vel) + " units box"; //NULL for x-y velocities means that we only the vertical velocities are set.
 			lmp->input->one( input_str.c_str( ) );
@@ -262,129 +291,46 @@ namespace PAPRECA{
 	}
 	
 	//Diffusion events
-	void fillIntegerDiffDataTransfArray( int *diff_intdata , PredefinedDiffusionHop *diff_template , Diffusion *diff ){
-		
-		/// Serializes (prepares) integer data for calls to MPI function related to the execution of PAPRECA::Diffusion events.
-		/// @param[in,out] diff_intdata 4-element array of integer data for transfer.
-		/// @param[in] diff_template pointer to PAPRECA::PredefinedDiffusionHop object (parent template to diff object)
-		/// @param[in] diff PAPRECA::Diffusion event to be executed.
-		/// @note diff_intdata[0] contains the parent type. diff_intdata[1] contains the diffused type. diff_intdata[2] is the length of diffvec_style string. diff_intedata[3] is the length of the diffusion_style string.
-		/// @see PAPRECA::deserializeIntegerDiffDataArr(), PAPRECA::executeDiffusion()
-		
-		diff_intdata[0] = diff->getParentType( );
-		diff_intdata[1] = diff->getDiffusedType( );
-		diff_intdata[2] = diff_template->getDiffvecStyle( ).size( );
-		diff_intdata[3] = diff_template->getDiffusionStyle( ).size( );
-		
-	}
-	
-	void fillDoubleDiffDataTransfArray( double *diff_doubledata , Diffusion *diff ){
-		
-		/// Serializes (prepares) double data for calls to MPI function related to the execution of PAPRECA::Diffusion events.
-		/// @param[in,out] diff_doubledata 7-element array of double data for transfer.
-		/// @param[in] diff PAPRECA::Diffusion event to be executed.
-		/// @note diff_doubledata[0], diff_doubledata[1], diff_doubledata[2] contain the x,y, and z coordinates of the diffusion point (vacancy). diff_doubledata[3], diff_doubledata[4], and diff_doubledata[5] contain the xyz coordinates of the parent atom. diff_doubledata[6] contains the insertion velocity.
-		/// @see PAPRECA::deserializeDoubleDiffDataArr(), PAPRECA::executeDiffusion()
-		
-		copyDoubleArray3D( diff_doubledata , diff->getVacancyPos( ) ); //We can use the copyDoubleArray3D (utilities.h/cpp) function here as it only copies the first 3 elements of the vector (default start/end arguments).
-		copyDoubleArray3D( diff_doubledata , diff->getParentPos( ) , 3 , 5 , 0 , 2 );
-		diff_doubledata[6] = diff->getDiffTemplate( )->getInsertionVel( ); //The last double position contains the insertion velocity
-		
-	}
-	
-	void deserializeIntegerDiffDataArr( int *diff_intdata , int &parent_type , int &diffused_type , int &diffvec_style_len , int &diffusion_style_len ){
-		
-		/// Deserializes (post-processes) integer data after calls to MPI function related to the execution of PAPRECA::Diffusion events.
-		/// @param[in] diff_intdata 4-element array of serialized (in fillIntegerDiffDataTransfArray() function) data.
-		/// @param[in,out] parent_type atom type of parent atom.
-		/// @param[in,out] diffused_type atom type of diffused atom.
-		/// @param[in,out] diffvec_style_len length of diffvec_style array
-		/// @param[in,out] diffusion_style_len length of diffvec_style array
-		/// @see PAPRECA::fillIntegerDiffDataTransfArray(), PAPRECA::executeDiffusion()
-		
-		parent_type = diff_intdata[0];
-		diffused_type = diff_intdata[1];
-		diffvec_style_len = diff_intdata[2];
-		diffusion_style_len = diff_intdata[3];
-		
-	}
-	
-	void deserializeDoubleDiffDataArr( double *diff_doubledata , double *vac_pos , double *parent_pos , double &insertion_vel ){
-
-		/// Deserializes (post-processes) double data after calls to MPI function related to the execution of PAPRECA::Diffusion events.
-		/// @param[in] diff_doubledata 7-element array of serialized (in fillDoubleDiffDataTransfArray() function) data.
-		/// @param[in,out] vac_pos coordinates of vacancy.
-		/// @param[in,out] parent_pos coordinates of parent atom
-		/// @param[in,out] insertion_vel velocity of diffused atom.
-		/// @see PAPRECA::fillDoubleDiffDataTransfArray(), PAPRECA::executeDiffusion()
-		
-		copyDoubleArray3D( vac_pos , diff_doubledata );
-		copyDoubleArray3D( parent_pos , diff_doubledata , 0 , 2 , 3 , 5 );
-		insertion_vel = diff_doubledata[6];
-	}
-
-	void executeDiffusion( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event ){
+	void executeDiffusion( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog ){
 		
-		/// Executes PAPRECA::Diffusion event. This is done by 1) communicating information from the MPI process that detected the event to all other MPI processes, and 2) calling diffuseAtom() after the appropriate data have been communicated.
+		/// Executes PAPRECA::Diffusion event by calling diffuseAtom() on all MPI processes.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
-		/// @param[in] event_proc MPI process calling the function (i.e., proc that detected this event).
-		/// @param[in] selected_event PAPRECA::Event selected (to be executed). Casted to the correct type (i.e., PAPRECA::Diffusion) before execution.
-		/// @see PAPRECA::diffuseAtom(), PAPRECA::resetMobileAtomsGroups()
-		
-		double vac_pos[3] , parent_pos[3] , insertion_vel;
-		LAMMPS_NS::tagint parent_id = -1;
-		int diff_intdata[4]; //This array stores the parent_type, diffused_type, diffvecs_style_len, and diffusion_style_len in positions 0, 1, 2, and 3, respectively.
-		double diff_doubledata[7]; //This array stores the vac_pos in positions 0-2, parent_pos in positions 3-5, and the insertion velocity in position 6
+		/// @param[in] event_proc MPI process that detected this event.
+		/// @param[in] record PAPRECA::EventRecord of the selected event (already communicated to all MPI processes). See PAPRECA::fillDiffusionRecord() for the layout.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class. Atoms touched by the executed event are marked so their events are rescanned in the next PAPRECA step (only if incremental_detection is active).
+		/// @see PAPRECA::diffuseAtom(), PAPRECA::resetMobileAtomsGroups(), PAPRECA::initCreatedAtomsNative()
+		
+		double vac_pos[3] , parent_pos[3];
+		LAMMPS_NS::tagint parent_id = record.tagints[0];
+		const int &parent_type = record.ints[0];
+		const int &diffused_type = record.ints[1];
+		copyDoubleArray3D( vac_pos , record.doubles );
+		copyDoubleArray3D( parent_pos , record.doubles , 0 , 2 , 3 , 5 );
+		const double &insertion_vel = record.doubles[6];
+		
+		//The style strings are retrieved from the (identical on all procs) diffusion template, so no strings have to be communicated
+		PredefinedDiffusionHop *diff_template = papreca_config.getDiffusionTemplate( record.template_id );
+		const std::string &diffvec_style = diff_template->getDiffvecStyle( );
+		const std::string &diffusion_style = diff_template->getDiffusionStyle( );
 		
-		int parent_type , diffused_type , diffvec_style_len , diffusion_style_len;
-		std::string diffvec_style , diffusion_style;
-		
-		//Retrieve data from event proc
 		if( proc_id == event_proc ){
-			
-			Diffusion *diff = dynamic_cast<Diffusion*>( selected_event ); //Cast as diffusion to access member variables of diffusion
-			PredefinedDiffusionHop *diff_template = diff->getDiffTemplate( );
-			
-			//Strings
-			diffvec_style = diff_template->getDiffvecStyle( ); 
-			diffusion_style = diff_template->getDiffusionStyle( );
-			
-			//Tagints
-			parent_id = diff->getParentId( ); //This is a tagint, hence, it is communicated separately from the other ints
-			
-			//Ints and doubles
-			fillIntegerDiffDataTransfArray( diff_intdata , diff_template , diff );
-			fillDoubleDiffDataTransfArray( diff_doubledata , diff );
-			
-			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n Executing diffusion event from proc %d, parent_id=%d , vac_pos=(%f,%f,%f) \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , parent_id , diff_doubledata[0] , diff_doubledata[1] , diff_doubledata[2] );
+			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n Executing diffusion event from proc %d, parent_id=%d , vac_pos=(%f,%f,%f) \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , parent_id , vac_pos[0] , vac_pos[1] , vac_pos[2] );
 		}
 		
-		//BCast and deserialize different data types if required
-		//tagints
-		MPI_Bcast( &parent_id , 1 , MPI_LMP_TAGINT , event_proc , MPI_COMM_WORLD );
-		
-		//doubles
-		MPI_Bcast( diff_doubledata , 7 , MPI_DOUBLE , event_proc , MPI_COMM_WORLD );
-		deserializeDoubleDiffDataArr( diff_doubledata , vac_pos , parent_pos , insertion_vel );
-
-		//integers
-		MPI_Bcast( diff_intdata , 4 , MPI_INT , event_proc , MPI_COMM_WORLD );
-		deserializeIntegerDiffDataArr( diff_intdata , parent_type , diffused_type , diffvec_style_len , diffusion_style_len );
-		
-		//strings
-		diffvec_style.resize( diffvec_style_len ); //Ensure that all strings have the same length before broadcasting 
-		MPI_Bcast( diffvec_style.data( ) , diffvec_style_len , MPI_CHAR , event_proc , MPI_COMM_WORLD );
-		diffusion_style.resize( diffusion_style_len );
-		MPI_Bcast( diffusion_style.data( ) , diffusion_style_len , MPI_CHAR , event_proc , MPI_COMM_WORLD );
+		//Mark parent and vacancy sites before the parent atom is moved or deleted
+		event_catalog.markTouchedPoint( parent_pos );
+		event_catalog.markTouchedPoint( vac_pos );
+		if( diffusion_style == "move_del" ){ event_catalog.markDeletedAtoms( lmp , &parent_id , 1 ); }
 		
 		//Now safely call the relevant lammps_wrappers function
-		diffuseAtom( lmp , vac_pos , parent_pos , parent_id , parent_type , diffusion_style , diffused_type );
+		const int first_created = diffuseAtom( lmp , vac_pos , parent_pos , parent_id , parent_type , diffusion_style , diffused_type , papreca_config.nativeExecutionIsActive( ) );
 		if( proc_id == 0 ){ papreca_config.getLogFile( ).appendDiffusion( KMC_loopid , time , vac_pos , parent_id , parent_type , insertion_vel , diffvec_style , diffusion_style , diffused_type ); }
 		
-		if( insertion_vel != 0.0 ){
+		if( insertion_vel != 0.0 && papreca_config.nativeExecutionIsActive( ) && initCreatedAtomsNative( lmp , first_created , papreca_config.getFluidAtomTypes( ) , insertion_vel ) ){
+			return; //Group bits and velocities of the created atom (if any) were set directly
+		}else if( insertion_vel != 0.0 ){
 			lmp->input->one( "group new_atom subtract all fluid frozen" ); //Same as deposition insertion velocities. Probably an overkill to select a single atom using a subtract group. Can be made faster/better in future versions.
 			std::string input_str = "velocity new_atom set NULL NULL " + std::to_string(insertion_vel) + " units box";
 			lmp->input->one( input_str.c_str( ) );
@@ -395,35 +341,27 @@ namespace PAPRECA{
 	}
 	
 	//Monoatomic desorption events
-	void executeMonoatomicDesorption( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event ){
+	void executeMonoatomicDesorption( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog ){
 		
-		/// Executes PAPRECA::MonoatomicDesorption event. This is done by 1) communicating information from the MPI process that detected the event to all other MPI processes, and 2) calling deleteAtoms() after the appropriate data have been communicated.
+		/// Executes PAPRECA::MonoatomicDesorption event by calling deleteAtoms() on all MPI processes.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
-		/// @param[in] event_proc MPI process calling the function (i.e., proc that detected this event).
-		/// @param[in] selected_event PAPRECA::Event selected (to be executed). Casted to the correct type (i.e., PAPRECA::MonoatomicDesorption) before execution.
+		/// @param[in] event_proc MPI process that detected this event.
+		/// @param[in] record PAPRECA::EventRecord of the selected event (already communicated to all MPI processes). See PAPRECA::fillMonoatomicDesorptionRecord() for the layout.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class. Atoms touched by the executed event are marked so their events are rescanned in the next PAPRECA step (only if incremental_detection is active).
 		/// @see PAPRECA::deleteAtoms(), PAPRECA::resetMobileAtomsGroups()
 		
-		
 		LAMMPS_NS::tagint atom_ids[1];
-		atom_ids[0] = -1;
-		int parent_type = -2;
-		
-		if( proc_id == event_proc ){ //retrieve information in event_proc !EXTRA CAUTION HERE: The selected_event pointer is NULL for all other procs EXCEPT for the event proc
+		atom_ids[0] = record.tagints[0];
+		const int &parent_type = record.ints[0];
 		
-			MonoatomicDesorption *monodes = dynamic_cast<MonoatomicDesorption*>( selected_event ); //Cast as BondForm to access member variables of bond form
-			atom_ids[0] = monodes->getParentId( );
-			parent_type = monodes->getParentType( );
-			
+		if( proc_id == event_proc ){
 			printf( "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~EVENTS INFO~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~  \n Executing monoatomic desorption event from proc %d, PARENT_TYPE=%d , ATOM_ID=%d \n~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ \n \n" , proc_id , parent_type , atom_ids[0] );
 		}
 		
-		MPI_Bcast( atom_ids , 1 , MPI_LMP_TAGINT , event_proc , MPI_COMM_WORLD );
-		MPI_Bcast( &parent_type , 1 , MPI_INT , event_proc , MPI_COMM_WORLD );
-		
 		//In this version all detected MonoAtomicDesorption events involve lone (non-bonded) atoms. This means that we can now simply delete the atomID to perform a "desorption" event.
-		deleteAtoms( lmp , atom_ids , 1 , "no" , "no" );
+		event_catalog.markDeletedAtoms( lmp , atom_ids , 1 );
+		deleteAtoms( lmp , atom_ids , 1 , "no" , "no" , papreca_config.nativeExecutionIsActive( ) );
 		if( proc_id == 0 ){ papreca_config.getLogFile( ).appendMonoatomicDesorption( KMC_loopid , time , atom_ids[0] , parent_type ); }
 		
 	}
@@ -449,58 +387,69 @@ namespace PAPRECA{
 		
 	}
 
-	void executeEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , const int &event_num , char *event_type , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds ){
+	void executeEventRecord( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , BondGraph &atomID2bonds , EventCatalog &event_catalog ){
 		
-		/// Casts event type from parent MPI process to all other processes and then executes event. Currently, only PAPRECA::BondForm, PAPRECA::BondBreak, PAPRECA::Deposition, PAPRECA::Diffusion, PAPRECA::MonoatomicDesorption events are supported.
+		/// Executes a (previously communicated) PAPRECA::EventRecord on all MPI processes. Calls the proper execution function depending on the event type.
+		/// @param[in,out] lmp pointer to LAMMPS object.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] proc_id ID of current MPI process.
+		/// @param[in] event_proc ID of proc that discovered the event.
+		/// @param[in] record PAPRECA::EventRecord of the event. Has to be identical on all MPI processes.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps (only used if incremental_detection is active).
+		/// @see PAPRECA::executeEvent(), PAPRECA::selectAndExecuteSublatticeEvents()
+		
+		switch( record.type ){ //call proper function for execution depending on the event type.
+			case EVENT_RXN_FORM:
+				executeBondForm( lmp , papreca_config , KMC_loopid , time , proc_id , event_proc , record , event_catalog );
+				break;
+			case EVENT_RXN_BREAK:
+				executeBondBreak( lmp , papreca_config , KMC_loopid , time , proc_id , event_proc , record , atomID2bonds , event_catalog );
+				break;
+			case EVENT_DEPO:
+				executeDeposition( lmp , KMC_loopid , time , papreca_config , proc_id , event_proc , record , event_catalog );
+				break;
+			case EVENT_DIFF:
+				executeDiffusion( lmp , KMC_loopid , time , papreca_config , proc_id , event_proc , record , event_catalog );
+				break;
+			case EVENT_MONO_DES:
+				executeMonoatomicDesorption( lmp , papreca_config , KMC_loopid , time , proc_id , event_proc , record , event_catalog );
+				break;
+			default:
+				allAbortWithMessage( MPI_COMM_WORLD , "Unknown event type " + std::to_string( record.type ) + " in executeEventRecord function in event_execute.cpp." );
+		}
+		
+	}
+
+	void executeEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const int &event_num , char *event_type , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog ){
+		
+		/// Serializes the selected event on the parent MPI process, communicates it to all other processes (single MPI_Bcast), and then executes the event. Currently, only PAPRECA::BondForm, PAPRECA::BondBreak, PAPRECA::Deposition, PAPRECA::Diffusion, PAPRECA::MonoatomicDesorption events are supported.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] proc_id ID of current MPI process.
-		/// @param[in] nprocs total number of MPI processes.
 		/// @param[in] event_proc ID of proc that discovered the event.
-		/// @param[in] event_num local (on the MPI process that discovered the event) event index (in the PAPRECA::Event objects vector).
+		/// @param[in] event_num local (on the MPI process that discovered the event) event index (in the PAPRECA::Event objects vector). Only meaningful on event_proc.
 		/// @param[in,out] event_type type of selected event.
 		/// @param[in] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
-		/// @see lammps_wrappers.h and lammps_wrappers.cpp
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps (only used if incremental_detection is active).
+		/// @see lammps_wrappers.h and lammps_wrappers.cpp, PAPRECA::EventRecord
 		/// @note Information should be communicated among the processes before the execution of an event. This happens because to execute an event we need to call lammps_command or lmp->input->one. lammps_command and lmp->input->one functions have to be called simultaneously by all MPI processes (otherwise the program will hang).
-		/// @note This function will almost certainly require a few changes if the user decides to modify the existing classes of events (bond form/break, deposition, diffusion) or add a new class of events. If changes are made the user will have to find a way to communicate data between procs (similar solutions as the solutions above can be used, of course).
-
-		Event *selected_event = NULL; //Initialize this to NULL for all procs
-		int n_event_type = -1;
+		/// @note This function will almost certainly require a few changes if the user decides to modify the existing classes of events (bond form/break, deposition, diffusion) or add a new class of events. New events should be serialized in a PAPRECA::EventRecord (see PAPRECA::fillEventRecord()) and executed in PAPRECA::executeEventRecord().
 
-		if( proc_id == event_proc ){ //Go to event proc
-			selected_event = events_local[event_num]; //Point at the selected event on the event_proc
-			strcpy( event_type , selected_event->getType( ).c_str( ) );//get event type on event_proc
-			n_event_type = strlen( event_type ) + 1;
-		}
+		EventRecord record;
 		
-		//Now the event_proc knows the type of event and needs to broadcast it to all other procs.
-		MPI_Bcast( &n_event_type , 1 , MPI_INT , event_proc , MPI_COMM_WORLD ); //Cast the char length first (this is to enable the next MPI_Bcast of the actual string).
-		MPI_Bcast( event_type , n_event_type , MPI_CHAR , event_proc , MPI_COMM_WORLD ); //Then cast the type of event.
-		
-		//Careful when you use the functions below. We initialized selected event as NULL. So, at this point ONLY the event_proc points to something that is not NULL!!!
-		//We pass selected event in the function so careful!!
-		
-		if( !strcmp( event_type , "RXN-FORM" ) ){ //call proper function for execution depending on the event type. strcmp compares 2 strings and gives 0 if they are equal.
-			executeBondForm( lmp , papreca_config , KMC_loopid , time , proc_id , nprocs , event_proc , selected_event );	
-		}else if( !strcmp( event_type , "RXN-BREAK" ) ){
-			executeBondBreak( lmp , papreca_config , KMC_loopid , time , proc_id , nprocs , event_proc , selected_event , atomID2bonds );
-		}else if( !strcmp( event_type , "DEPO" ) ){
-			executeDeposition( lmp , KMC_loopid , time , papreca_config , proc_id , nprocs , event_proc , selected_event );
-		}else if( !strcmp( event_type , "DIFF" ) ){
-			executeDiffusion( lmp , KMC_loopid , time , papreca_config , proc_id , nprocs , event_proc , selected_event );
-		}else if( !strcmp( event_type , "MONO-DES" ) ){
-			executeMonoatomicDesorption( lmp , papreca_config , KMC_loopid , time , proc_id , nprocs , event_proc , selected_event );
-		}else{
-			std::string unknown_type( event_type );
-			allAbortWithMessage( MPI_COMM_WORLD , "Unknown event type " + unknown_type + " in executeEvent function in papreca.cpp." );
-		}
+		if( proc_id == event_proc ){ fillEventRecord( events_local[event_num] , record ); } //The selected event only exists on the event_proc
+		broadcastEventRecord( record , event_proc ); //Now all procs know the type and details of the selected event
+		strcpy( event_type , Event::getTypeName( static_cast< EVENT_TYPE >( record.type ) ) ); //The printed type name is used in PAPRECA export files.
+		
+		executeEventRecord( lmp , KMC_loopid , time , papreca_config , proc_id , event_proc , record , atomID2bonds , event_catalog );
 		
 	}
 	
-	int selectAndExecuteEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds , double &film_height ){
+	int selectAndExecuteEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog , double &film_height ){
 		
-		/// Gets total event rate by gathering all local rates (i.e., sum of rates on a single MPI process). Then, selects an event MPI process using the N-FOLD way. Afterwards, an event is chosen from the selected MPI process and executed on all procs.
+		/// Gets total event rate by reducing all local rates (i.e., sum of rates on a single MPI process). Then, selects an event MPI process using the N-FOLD way (see PAPRECA::selectEventProc()). Afterwards, an event is chosen from the selected MPI process and executed on all procs.
 		/// @param[in,out] lmp pointer to LAMMPS object.
 		/// @param[in] KMC_loopid current PAPRECA step.
 		/// @param[in,out] time current time.
@@ -509,74 +458,317 @@ namespace PAPRECA{
 		/// @param[in] nprocs total number of MPI processes.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
-		/// @param[in] atomID2bonds PAPRECA::ATOM2BONDS_MAP container (i.e., std::unordered_map< LAMMPS_NS::tagint parent_atomID , std::vector< PAPRECA::Bond > >). The atomID2bonds container provides direct access to all the bonds of the parent atom.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps (only used if incremental_detection is active).
 		/// @param[in] film_height current height.
 		/// @note Currently, we discover events on all MPI processes. However, KMC events are not executed in parallel as only one event from one MPI processes is fired at a time. We plan to introduce parallel event execution in subsequent versions of PAPRECA. Additional code will have to be written to prevent errors in neighboring events (e.g., execution of 2 deposition events that overlap, breaking of the same bond twice, etc.). Of course, executing events in parallel is expected to elevate the scalability and boost the efficiency of the code even further.
 		/// @note See this paper for more information regarding the classic N-FOLD way and the selection of events: https://www.sciencedirect.com/science/article/pii/S0927025623004159
+		/// @note The rates of all MPI processes are never gathered. Each MPI process obtains its window in the cumulative rate with MPI_Exscan and the total rate is obtained with MPI_Allreduce. Random numbers are only drawn on proc 0 and communicated (along with the zero rate flag and the advanced time) with a single MPI_Bcast. The MPI process owning the target identifies itself locally (see PAPRECA::selectEventProc()) and the selected event is then communicated from the event proc with a single MPI_Bcast (see PAPRECA::executeEvent()).
 		
 		strcpy( event_type , "NONE" );//Starts with NONE and returned as NONE ONLY and ONLY if on event is selected (i.e., if the rate is zero). In any other case this variable will hold the event type.
 		int zero_rate = 0; //Starts with zero and becomes 1 if the rate is zero. Then used to exit function prematurely and avoid segmentation faults.
 		
 		double rate_local = getLocalRate( events_local , papreca_config ); //That is the total rate of a specific proc
-		double *proc_rates = new double[nprocs];
-		MPI_Gather( &rate_local , 1 , MPI_DOUBLE , proc_rates , 1 , MPI_DOUBLE , 0 , MPI_COMM_WORLD ); //Gather all values from all procs in master proc (0).
 		
-		//Get Event proc
-		int event_proc = -1; //Initialize this to -1 to understand if something failed. Also, if all rates are 0, this will stay at -1 and you'll know that at the current step there are no detected events
-		
-		if( proc_id == 0 ){ //Select the event_proc on proc 0
-			double proc_rates_sum = doubleArrSum( proc_rates , nprocs ); //Get cumulative rate from all procs to be used in stochastic event selection
+		//Every proc gets the sum of rates of all procs with lower IDs (i.e., the lower limit of its window in the cumulative rate) without gathering the rates of all procs on proc 0.
+		double rate_prefix = 0.0;
+		MPI_Exscan( &rate_local , &rate_prefix , 1 , MPI_DOUBLE , MPI_SUM , MPI_COMM_WORLD );
+		if( proc_id == 0 ){ rate_prefix = 0.0; } //The MPI_Exscan result is undefined on proc 0
+		
+		//The total rate and the last proc with a non-zero rate are reduced with a single collective
+		StepStats rate_stats;
+		const int rates_sum_stat = rate_stats.registerStat( STAT_SUM );
+		const int last_active_stat = rate_stats.registerStat( STAT_MAX );
+		rate_stats.setLocalValue( rates_sum_stat , rate_local );
+		rate_stats.setLocalValue( last_active_stat , ( rate_local > 0.0 ? proc_id : -1 ) );
+		rate_stats.reduce( MPI_COMM_WORLD );
+		
+		double target = 0.0 , rnum = 0.0;
+		if( proc_id == 0 ){ //Draw all random numbers on proc 0
+			double proc_rates_sum = rate_stats.getGlobalValue( rates_sum_stat ); //Get cumulative rate from all procs to be used in stochastic event selection
 			if( proc_rates_sum <= 0.0 ){
-				//Signal all other procs that total rate is zero and exit function immediately to avoid segmentation faults! (i.e., due to division by zero in dt calculation and in the selectProcessStochastically function.
+				//Signal all other procs that total rate is zero and exit function immediately to avoid segmentation faults! (i.e., due to division by zero in dt calculation and in the event selection.
 				zero_rate = 1;
 			}else{
 				advanceSimClockFromKMC( papreca_config , proc_rates_sum , time ); //Advance clock but only when the total rate is non-zero! Otherwise you will divide by 0 and your time will become inf.
-				double rnum = papreca_config.getUniformRanNum( ); //Draw random number on proc 0
-				event_proc = selectProcessStochastically( proc_rates , nprocs , rnum , proc_rates_sum );
+				target = papreca_config.getUniformRanNum( ) * proc_rates_sum; //Draw random number on proc 0 and scale it by the total rate to select the event proc
+				
+				/*Draw rnum on driver proc and cast it to other procs to select event. Refrain from drawing random numbers on any other proc rather than the driver proc because this will lead to non repeatable results. Explanation: The same atoms might end up on different domains. This doesn't mean that the decomposition is different. It just means that the same decomposition might assign different proc numbers to the same domains. Now, the driver proc always selects random numbers to advance the simulation clock and select the event proc. This means that the random number sequence on the driver proc is on a different stage (i.e., will give you a different rnum) on the driver proc compared to all other procs. Because the proc numbering changes, we won't always get the same number of events executed on proc 0. Hence, we will probably get different random numbers and start having different results between different runs, even if these runs were initialized from the same random seed.*/
+				rnum = papreca_config.getUniformRanNum( );
 			}
 			
 			printStepInfo( papreca_config , KMC_loopid , time , film_height , proc_rates_sum );
 		}
 		
-		
-		delete [] proc_rates;
-		MPI_Bcast( &zero_rate , 1 , MPI_INT , 0 , MPI_COMM_WORLD ); //Now all procs know if the total rate is zero and skip the following statement to exit function prematurely
+		//Communicate the random numbers drawn on proc 0 with a single MPI_Bcast. Because time is advanced on the master proc, the time value is communicated here as well.
+		double selection_data[4] = { static_cast< double >( zero_rate ) , target , rnum , time };
+		MPI_Bcast( selection_data , 4 , MPI_DOUBLE , 0 , MPI_COMM_WORLD );
+		zero_rate = static_cast< int >( selection_data[0] );
 		if( zero_rate ){ return zero_rate; } //Immediately exit if the rate is zero on all procs. No need to go through event selection or execute an event in this case.
+		target = selection_data[1];
+		rnum = selection_data[2];
+		time = selection_data[3];
 		
-			
-		MPI_Bcast( &event_proc , 1 , MPI_INT , 0 , MPI_COMM_WORLD ); //Proc selection was done on proc 0 so now we need to communicate the event_proc to all procs
-			
-		/*Draw rnum on driver proc and cast it to other procs to select event. Refrain from drawing random numbers on any other proc rather than the driver proc because this will lead to non repeatable results. Explanation: The same atoms might end up on different domains. This doesn't mean that the decomposition is different. It just means that the same decomposition might assign different proc numbers to the same domains. Now, the driver proc always selects random numbers to advance the simulation clock and select the event proc. This means that the random number sequence on the driver proc is on a different stage (i.e., will give you a different rnum) on the driver proc compared to all other procs. Because the proc numbering changes, we won't always get the same number of events executed on proc 0. Hence, we will probably get different random numbers and start having different results between different runs, even if these runs were initialized from the same random seed.*/
-		double rnum;
-		if( proc_id == 0 ){ rnum = papreca_config.getUniformRanNum( ); }
-		MPI_Bcast( &rnum , 1 , MPI_DOUBLE , 0 , MPI_COMM_WORLD );
+		//Every proc checks locally if the target falls in its window. The owner is then communicated to all procs (see PAPRECA::selectEventProc()).
+		int event_proc = selectEventProc( rate_local , rate_prefix , target , static_cast< int >( rate_stats.getGlobalValue( last_active_stat ) ) , proc_id , nprocs );
+		if( event_proc == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not select event proc in selectAndExecuteEvent function (papreca.cpp)." ); }
 
-		//Get kMC process on Event Proc
+		//Get kMC process on Event Proc. The event_num is only used on the event_proc, so it is not communicated. The selected event is communicated to all other procs in executeEvent.
 		int event_num = -1;
 		if( proc_id == event_proc ){ //Now go to the event proc to select a kMC event
 			double *event_rates = new double[events_local.size( )];
 			Event::fillRatesArr( event_rates , events_local );
-			double event_rates_sum = doubleArrSum( event_rates , events_local.size( ) );
-			event_num = selectProcessStochastically( event_rates , events_local.size( ) , rnum , event_rates_sum );
+			RateTree event_rates_tree; //O(n) build and O(log n) selection (instead of sorting all event rates)
+			event_rates_tree.build( event_rates , events_local.size( ) );
+			event_num = event_rates_tree.selectIndex( rnum );
 			delete [] event_rates;
 		}
-			
-		MPI_Bcast( &event_num , 1 , MPI_INT , event_proc , MPI_COMM_WORLD ); //Proc selection was done on proc event_proc so now we need to communicate the event_proc to all procs
-		//The above Bcast might be unnecessary, since we will only access event_num INSIDE event_proc and event_num does indeed have the current value inside the event_proc. Could possibly omit, but kept here for consistency.
 		
+		executeEvent( lmp , KMC_loopid , time , papreca_config , proc_id , event_proc , event_num , event_type , events_local , atomID2bonds , event_catalog );
+		papreca_config.setLammpsSystemModified( ); //LAMMPS neighbor lists have to be refreshed before the next event detection.
+		
+		return zero_rate;//; //This tells you if the rate was zero on this step. Even though proc0 calculates the total rate, the information is communicated to all other procs (through MPI_Bcast).
+						  //Hence, if the rate is zero (i.e., no detected events), then zero_rate would be 1 in all procs and returned properly to the main function.
+		
+		
+	}
+	
+	
+	//Synchronous sublattice kMC
+	const int getEventSublatticeColor( LAMMPS_NS::LAMMPS *lmp , Event *event , const double *sector_mid ){
+		
+		/// Returns the sublattice color (i.e., sector of the local subdomain) of a PAPRECA::Event. The local subdomain is split into 2x2 sectors along the x- and y-directions. The color of an event is the sector of its parent atom (or deposition site).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] event PAPRECA::Event detected on the current MPI process.
+		/// @param[in] sector_mid x and y coordinates of the center of the local subdomain.
+		/// @return sublattice color (0-3) of the event.
+		/// @see PAPRECA::selectAndExecuteSublatticeEvents()
+		
+		const double *pos = NULL;
+		LAMMPS_NS::tagint atom_id = -1;
+		
+		switch( event->getType( ) ){
+			case EVENT_DEPO:
+				pos = static_cast< Deposition* >( event )->getSitePos( );
+				break;
+			case EVENT_DIFF:
+				pos = static_cast< Diffusion* >( event )->getParentPos( );
+				break;
+			case EVENT_RXN_FORM:
+			case EVENT_RXN_BREAK:
+				atom_id = static_cast< Reaction* >( event )->getAtom1ID( );
+				if( lmp->atom->map( atom_id ) < 0 ){ atom_id = static_cast< Reaction* >( event )->getAtom2ID( ); }
+				break;
+			case EVENT_MONO_DES:
+				atom_id = static_cast< MonoatomicDesorption* >( event )->getParentId( );
+				break;
+			default:
+				allAbortWithMessage( MPI_COMM_WORLD , "Unknown event type " + std::to_string( event->getType( ) ) + " in getEventSublatticeColor function in event_execute.cpp." );
+		}
+		
+		if( !pos ){
+			const int iatom = lmp->atom->map( atom_id );
+			if( iatom < 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not find atom " + std::to_string( atom_id ) + " of detected event in getEventSublatticeColor function in event_execute.cpp." ); }
+			pos = lmp->atom->x[iatom];
+		}
+		
+		return ( pos[0] >= sector_mid[0] ) + 2 * ( pos[1] >= sector_mid[1] );
+		
+	}
+	
+	const int getExecutableRecordsNum( PaprecaConfig &papreca_config , const std::vector< EventRecord > &records , const bool &atomic_system ){
+		
+		/// Returns the number of (leading) records of all MPI processes that can be executed (in proc order) on the same PAPRECA step of synchronous sublattice kMC.
+		/// All records are filled before any of them is executed. In atomic systems, deleting atoms re-assigns all atom IDs (see PAPRECA::deleteAtoms()), so the atom IDs stored in the records after a deleting record might point to the wrong atoms (or to atoms that no longer exist). Hence, execution stops after the first record that deletes atoms. The remaining records are treated as null events.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] records PAPRECA::EventRecord objects of all MPI processes (in proc order).
+		/// @param[in] atomic_system true if the LAMMPS system is atomic (i.e., non-molecular).
+		/// @return number of records to be executed.
+		/// @see PAPRECA::selectAndExecuteSublatticeEvents(), PAPRECA::eventRecordDeletesAtoms()
+		
+		const int records_num = records.size( );
+		if( !atomic_system ){ return records_num; }
+		
+		for( int i = 0; i < records_num; ++i ){
+			if( eventRecordDeletesAtoms( papreca_config , records[i] ) ){ return i + 1; }
+		}
+		
+		return records_num;
+		
+	}
+	
+	int selectAndExecuteSublatticeEvents( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog , double &film_height ){
+		
+		/// Synchronous sublattice alternative of PAPRECA::selectAndExecuteEvent(). Every MPI process can fire one event per PAPRECA step, so the number of executed events scales with the number of MPI processes.
+		/// The local subdomain of each MPI process is split into 2x2 sectors (colors) along the x- and y-directions (see PAPRECA::getEventSublatticeColor()). On each PAPRECA step a color is randomly selected and every MPI process selects an event from its sector of that color.
+		/// Sectors of the same color are separated by (at least) one sector. An event changes atoms up to the event reach from its parent atom (see PAPRECA::PaprecaConfig::initEventReachMax()) and is detected from atoms up to the neighbor cutoff (force cutoff + skin) from its parent atom. Hence, events fired by different MPI processes do not interfere, as long as the sector width is at least twice the sum of the neighbor cutoff and the maximum event reach.
+		/// Every MPI process fires its event with probability R_sector/R_max (otherwise a null event is executed), where R_sector is the rate of its sector and R_max is the maximum sector rate of all MPI processes. The clock is advanced by -ln(rnum)/(4*R_max).
+		/// @param[in,out] lmp pointer to LAMMPS object.
+		/// @param[in] KMC_loopid current PAPRECA step.
+		/// @param[in,out] time current time.
+		/// @param[in,out] event_type type of the first executed event.
+		/// @param[in] proc_id ID of current MPI process.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @param[in] atomID2bonds PAPRECA::BondGraph object storing the bonds of atoms in compressed sparse row format. The atomID2bonds object provides direct access to all the bonds of the parent atom.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps (only used if incremental_detection is active).
+		/// @param[in] film_height current height.
+		/// @return 1 if the total rate is zero, or 0 otherwise.
+		/// @note If the sectors are too narrow (or the simulation box is triclinic) the step falls back to PAPRECA::selectAndExecuteEvent() (i.e., one event per PAPRECA step).
+		/// @note In atomic systems, atom IDs are re-assigned when atoms are deleted. Hence, only the events up to (and including) the first event that deletes atoms are executed (see PAPRECA::getExecutableRecordsNum()).
+		/// @note All random numbers (clock, color, and one acceptance/selection pair per MPI process) are drawn on proc 0 in a fixed order and scattered to all MPI processes. Hence, runs are repeatable for the same random seed and the same number of MPI processes. However, results depend on the domain decomposition.
+		/// @note See Shim and Amar (2005), Phys. Rev. B 71, 125432 and Martinez et al. (2008), J. Comput. Phys. 227, 3804 for more information regarding synchronous sublattice kMC.
+		
+		const int colors_num = 4;
+		
+		//Sector geometry. Sectors are checked before any rate is calculated, so the standard selection can be used if the sectors are too narrow.
+		double sector_mid[2] = { 0.0 , 0.0 };
+		double sector_width = 0.0;
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		if( !domain->triclinic ){
+			for( int i = 0; i < 2; ++i ){ sector_mid[i] = 0.5 * ( domain->sublo[i] + domain->subhi[i] ); }
+			sector_width = 0.5 * std::min( domain->subhi[0] - domain->sublo[0] , domain->subhi[1] - domain->sublo[1] );
+		}
+		double sector_width_min = 0.0;
+		MPI_Allreduce( &sector_width , &sector_width_min , 1 , MPI_DOUBLE , MPI_MIN , MPI_COMM_WORLD );
+		if( sector_width_min < 2.0 * ( lmp->neighbor->cutneighmax + papreca_config.getEventReachMax( ) ) ){
+			return selectAndExecuteEvent( lmp , KMC_loopid , time , event_type , proc_id , nprocs , papreca_config , events_local , atomID2bonds , event_catalog , film_height );
+		}
+		
+		strcpy( event_type , "NONE" );
+		int zero_rate = 0;
+		
+		double rate_local = getLocalRate( events_local , papreca_config ); //Also scales the rates of deposition events by their sticking coefficients
+		
+		//Sector rates
+		std::vector< int > event_colors( events_local.size( ) );
+		double sector_rates[colors_num] = { 0.0 , 0.0 , 0.0 , 0.0 };
+		for( size_t i = 0; i < events_local.size( ); ++i ){
+			event_colors[i] = getEventSublatticeColor( lmp , events_local[i] , sector_mid );
+			sector_rates[event_colors[i]] += events_local[i]->getRate( );
+		}
+		
+		StepStats rate_stats;
+		const int rates_sum_stat = rate_stats.registerStat( STAT_SUM );
+		const int sector_max_stat = rate_stats.registerStat( STAT_MAX );
+		rate_stats.setLocalValue( rates_sum_stat , rate_local );
+		rate_stats.setLocalValue( sector_max_stat , *std::max_element( sector_rates , sector_rates + colors_num ) );
+		rate_stats.reduce( MPI_COMM_WORLD );
+		const double sector_rate_max = rate_stats.getGlobalValue( sector_max_stat );
+		
+		//Draw all random numbers on proc 0 and scatter them. Each proc receives the zero rate flag, the color, the time, and its acceptance/selection random numbers.
+		const int selection_size = 5;
+		std::vector< double > scatter_data;
 		if( proc_id == 0 ){
-			//Immediately abort with an error if no event proc could  be selected.
-			if( event_proc == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not select event proc in selectAndExecuteEvent function (papreca.cpp)." ); }
 			
+			scatter_data.assign( selection_size * nprocs , 0.0 );
+			int color = 0;
+			if( sector_rate_max <= 0.0 ){
+				zero_rate = 1;
+			}else{
+				advanceSimClockFromKMC( papreca_config , colors_num * sector_rate_max , time );
+				color = std::min( static_cast< int >( papreca_config.getUniformRanNum( ) * colors_num ) , colors_num - 1 );
+				for( int i = 0; i < nprocs; ++i ){
+					scatter_data[selection_size*i+3] = papreca_config.getUniformRanNum( ); //acceptance
+					scatter_data[selection_size*i+4] = papreca_config.getUniformRanNum( ); //selection
+				}
+			}
+			for( int i = 0; i < nprocs; ++i ){
+				scatter_data[selection_size*i] = zero_rate;
+				scatter_data[selection_size*i+1] = color;
+				scatter_data[selection_size*i+2] = time;
+			}
+			
+			printStepInfo( papreca_config , KMC_loopid , time , film_height , rate_stats.getGlobalValue( rates_sum_stat ) );
 		}
 		
-		executeEvent( lmp , KMC_loopid , time , papreca_config , proc_id , nprocs , event_proc , event_num , event_type , events_local , atomID2bonds );
+		double selection_data[selection_size];
+		MPI_Scatter( scatter_data.data( ) , selection_size , MPI_DOUBLE , selection_data , selection_size , MPI_DOUBLE , 0 , MPI_COMM_WORLD );
+		zero_rate = static_cast< int >( selection_data[0] );
+		if( zero_rate ){ return zero_rate; }
+		const int color = static_cast< int >( selection_data[1] );
+		time = selection_data[2];
 		
-		//Because time is advanced on the master proc, the time value has to be BCasted to all other procs now, before exiting (if the rate is zero you don't have to bcast and the function will exit on the previous return
-		MPI_Bcast( &time , 1 , MPI_DOUBLE , 0 , MPI_COMM_WORLD );
-		return zero_rate;//; //This tells you if the rate was zero on this step. Even though proc0 calculates the total rate, the information is communicated to all other procs (through MPI_Bcast).
-						  //Hence, if the rate is zero (i.e., no detected events), then zero_rate would be 1 in all procs and returned properly to the main function.
+		//Fire an event from the sector of the selected color with probability sector_rate/sector_rate_max
+		EventRecord record;
+		if( sector_rates[color] > 0.0 && selection_data[3] * sector_rate_max < sector_rates[color] ){
+			
+			std::vector< int > sector_events;
+			std::vector< double > sector_event_rates;
+			for( size_t i = 0; i < events_local.size( ); ++i ){
+				if( event_colors[i] == color ){
+					sector_events.push_back( i );
+					sector_event_rates.push_back( events_local[i]->getRate( ) );
+				}
+			}
+			
+			RateTree event_rates_tree;
+			event_rates_tree.build( sector_event_rates.data( ) , sector_event_rates.size( ) );
+			fillEventRecord( events_local[sector_events[event_rates_tree.selectIndex( selection_data[4] )]] , record );
+		}
+		
+		//All procs execute the events of all procs (in proc order). In atomic systems, execution stops after the first event that deletes atoms (see PAPRECA::getExecutableRecordsNum()).
+		std::vector< EventRecord > records( nprocs );
+		MPI_Allgather( &record , sizeof( EventRecord ) , MPI_BYTE , records.data( ) , sizeof( EventRecord ) , MPI_BYTE , MPI_COMM_WORLD );
+		const int records_num = getExecutableRecordsNum( papreca_config , records , lmp->atom->molecular == LAMMPS_NS::Atom::ATOMIC );
+		
+		bool events_executed = false;
+		for( int i = 0; i < records_num; ++i ){
+			if( records[i].type == EVENT_NONE ){ continue; }
+			if( !events_executed ){ strcpy( event_type , Event::getTypeName( static_cast< EVENT_TYPE >( records[i].type ) ) ); }
+			executeEventRecord( lmp , KMC_loopid , time , papreca_config , proc_id , i , records[i] , atomID2bonds , event_catalog );
+			events_executed = true;
+		}
+		if( events_executed ){ papreca_config.setLammpsSystemModified( ); } //LAMMPS neighbor lists have to be refreshed before the next event detection.
+		
+		return zero_rate;
+		
+	}
+	
+	//Event batching
+	void releaseLocalEvents( std::vector< Event* > &events_local , EventCatalog &event_catalog ){
+		
+		/// Clears events_local at the end of an event detection pass.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @param[in] event_catalog object of the PAPRECA::EventCatalog class storing the PAPRECA::Event objects of local atoms between PAPRECA steps (only used if incremental_detection is active).
+		
+		if( event_catalog.isActive( ) ){
+			events_local.clear( ); //Events are owned (and deleted) by the event catalog
+		}else{
+			Event::resetEventPoolsAndClearLocalEvents( events_local ); //Events are stored in the event pools, which are reset at once
+		}
+		
+	}
+	
+	const bool continueEventBatch( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector< Event* > &events_local , const int &KMC_loopid , const int &batch_events ){
+		
+		/// Decides whether the current PAPRECA step can select and execute an event from the events detected on a previous PAPRECA step (i.e., without refreshing LAMMPS and rescanning atoms).
+		/// Events lying within the neighbor cutoff of the atoms touched by the previously executed events of the batch are removed from events_local (see EventCatalog::removeBatchInvalidatedEvents()). The rates of all remaining events are unaffected by the executed events, so the kinetics are identical to a full detection pass, apart from new events created in the vicinity of executed events. Those are only detected when the batch ends.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in,out] event_catalog object of the PAPRECA::EventCatalog class storing the touched points of the current batch.
+		/// @param[in,out] events_local vector containing all the PAPRECA::Event objects for a specific MPI process.
+		/// @param[in] KMC_loopid current PAPRECA step.
+		/// @param[in] batch_events number of PAPRECA steps that executed events from the current detection pass.
+		/// @return true if the batch continues or false if a new detection pass is required.
+		/// @note The batch ends after kmc_batch PAPRECA steps, after any MD stage, or if no event survives on any MPI process. All MPI processes always reach the same decision.
+		
+		if( !papreca_config.eventBatchingIsActive( ) || batch_events <= 0 || batch_events >= papreca_config.getKMCBatchSize( ) ){ return false; }
+		
+		const int previous_step = KMC_loopid - 1;
+		if( previous_step % papreca_config.getKMCperMD( ) == 0 || previous_step % papreca_config.getKMCperLongMD( ) == 0 ){ return false; } //MD stages move all fluid atoms.
+		
+		const bool batch_valid = event_catalog.removeBatchInvalidatedEvents( lmp , events_local );
+		
+		StepStats batch_stats;
+		const int events_stat = batch_stats.registerStat( STAT_MAX );
+		const int broken_stat = batch_stats.registerStat( STAT_MAX );
+		batch_stats.setLocalValue( events_stat , ( events_local.empty( ) ? 0.0 : 1.0 ) );
+		batch_stats.setLocalValue( broken_stat , ( batch_valid ? 0.0 : 1.0 ) );
+		batch_stats.reduce( MPI_COMM_WORLD );
 		
+		return batch_stats.getGlobalValue( events_stat ) > 0.0 && batch_stats.getGlobalValue( broken_stat ) == 0.0;
 		
 	}
 	
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 //System Headers
 #include <vector>
+#include <algorithm>
 #include <mpi.h>
 
 
@@ -39,6 +40,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "bond.h"
 #include "event.h"
 #include "event_list.h"
+#include "event_catalog.h"
 #include "event_select.h"
 #include "sim_clock.h"
 #include "papreca_config.h"
@@ -47,33 +49,59 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 	
+	struct EventRecord{
+		
+		/// @struct PAPRECA::EventRecord
+		/// @brief Fixed-layout (serialized) copy of the selected PAPRECA::Event. The record is filled on the MPI process that detected the event and communicated to all other MPI processes with a single MPI_Bcast (see PAPRECA::broadcastEventRecord()).
+		/// @note Strings are never communicated. PAPRECA::PredefinedDeposition and PAPRECA::PredefinedDiffusionHop templates are communicated through their template IDs, which are identical on all MPI processes. The layout of each event type is documented in the respective fill function (e.g., PAPRECA::fillBondFormRecord()).
+		
+		int type = EVENT_NONE; ///< PAPRECA::EVENT_TYPE of the selected event.
+		int template_id = -1; ///< template ID of the PAPRECA::PredefinedDeposition or PAPRECA::PredefinedDiffusionHop of the selected event (-1 for all other event types).
+		int ints[2] = { -1 , -1 }; ///< integer data (i.e., atom types, bond types, flags).
+		LAMMPS_NS::tagint tagints[2] = { -1 , -1 }; ///< atom IDs.
+		double doubles[8] = { 0.0 , 0.0 , 0.0 , 0.0 , 0.0 , 0.0 , 0.0 , 0.0 }; ///< positions, angles, and velocities.
+		
+	};
+	
+	//Event records
+	void fillBondFormRecord( BondForm *bond_form , EventRecord &record );
+	void fillBondBreakRecord( BondBreak *bond_break , EventRecord &record );
+	void fillDepositionRecord( Deposition *depo , EventRecord &record );
+	void fillDiffusionRecord( Diffusion *diff , EventRecord &record );
+	void fillMonoatomicDesorptionRecord( MonoatomicDesorption *monodes , EventRecord &record );
+	void fillEventRecord( Event *event , EventRecord &record );
+	void broadcastEventRecord( EventRecord &record , const int &event_proc );
+	const bool eventRecordDeletesAtoms( PaprecaConfig &papreca_config , const EventRecord &record );
+	
 	//Formation events
-	void fillFormTransferDataArr( BondForm *bond_form , int *form_data );
-	void deserializeFormTransferDataArr( int *form_data , int &bond_type , int &delete_atoms );
-	void executeBondForm( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event );
+	void executeBondForm( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog );
 	
 	//Bond-breaking events
-	void executeBondBreak( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event , ATOM2BONDS_MAP &atomID2bonds );
+	void executeBondBreak( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , BondGraph &atomID2bonds , EventCatalog &event_catalog );
 	
 	//Deposition events
-	void fillDepoDataTransfArr( double *depo_data , Deposition *depo );
-	void deserializeDepoTransfData( double *depo_data , double *site_pos , double *rot_pos , double &rot_theta , double &insertion_vel );
-	void executeDeposition( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event );
+	void executeDeposition( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog );
 	
 	//Diffusion events
-	void fillIntegerDiffDataTransfArray( int *diff_intdata , PredefinedDiffusionHop *diff_template , Diffusion *diff );
-	void fillDoubleDiffDataTransfArray( double *diff_doubledata , Diffusion *diff );
-	void deserializeIntegerDiffDataArr( int *diff_intdata , int &parent_type , int &diffused_type , int &diffvec_style_len , int &diffusion_style_len );
-	void deserializeDoubleDiffDataArr( double *diff_doubledata , double *vac_pos , double &insertion_vel );
-	void executeDiffusion( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event );
+	void executeDiffusion( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog );
 	
 	//Monoatomic desorption events
-	void executeMonoatomicDesorption( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &nprocs , const int &event_proc , Event *selected_event );
+	void executeMonoatomicDesorption( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , int &KMC_loopid , double &time , const int &proc_id , const int &event_proc , const EventRecord &record , EventCatalog &event_catalog );
 	
 	//General event execution functions
 	void printStepInfo( PaprecaConfig &papreca_config , const int &KMC_loopid , const double &time , const double &film_height , const double &proc_rates_sum );
-	void executeEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs , const int &event_proc , const int &event_num , char *event_type , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds );
-	int selectAndExecuteEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , ATOM2BONDS_MAP &atomID2bonds , double &film_height );
+	void executeEventRecord( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const EventRecord &record , BondGraph &atomID2bonds , EventCatalog &event_catalog );
+	void executeEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , PaprecaConfig &papreca_config , const int &proc_id , const int &event_proc , const int &event_num , char *event_type , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog );
+	int selectAndExecuteEvent( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog , double &film_height );
+	
+	//Synchronous sublattice kMC
+	const int getEventSublatticeColor( LAMMPS_NS::LAMMPS *lmp , Event *event , const double *sector_mid );
+	const int getExecutableRecordsNum( PaprecaConfig &papreca_config , const std::vector< EventRecord > &records , const bool &atomic_system );
+	int selectAndExecuteSublatticeEvents( LAMMPS_NS::LAMMPS *lmp , int &KMC_loopid , double &time , char *event_type , int &proc_id , int &nprocs , PaprecaConfig &papreca_config , std::vector< Event* > &events_local , BondGraph &atomID2bonds , EventCatalog &event_catalog , double &film_height );
+	
+	//Event batching
+	void releaseLocalEvents( std::vector< Event* > &events_local , EventCatalog &event_catalog );
+	const bool continueEventBatch( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , EventCatalog &event_catalog , std::vector< Event* > &events_local , const int &KMC_loopid , const int &batch_events );
 
 }//end of PAPRECA namespace 
 
@@ -110,6 +110,8 @@ namespace PAPRECA{
 	const std::string &PredefinedDiffusionHop::getCustomStyle( ) const{ return custom_style; }
 	const std::vector< int > &PredefinedDiffusionHop::getStyleAtomTypes( ) const{ return style_atomtypes; }
 	const std::vector< double > &PredefinedDiffusionHop::getStyleConstants( ) const{ return style_constants; }
+	void PredefinedDiffusionHop::setTemplateID( const int &template_id_in ){ template_id = template_id_in; }
+	const int &PredefinedDiffusionHop::getTemplateID( ) const{ return template_id; }
 	//-------------------------------------End of PredefinedDiffusionHop class-------------------------------------
 	
 	
@@ -123,6 +125,20 @@ namespace PAPRECA{
 		atom_types = lmp->atom->molecules[imol]->type;
 		atoms_num = lmp->atom->molecules[imol]->natoms;
 		center = lmp->atom->molecules[imol]->center;
+		
+		coords_x.resize( atoms_num );
+		coords_y.resize( atoms_num );
+		coords_z.resize( atoms_num );
+		for( int i = 0; i < atoms_num; ++i ){
+			
+			coords_x[i] = coords[i][0];
+			coords_y[i] = coords[i][1];
+			coords_z[i] = coords[i][2];
+			
+			const double dist = std::sqrt( coords[i][0] * coords[i][0] + coords[i][1] * coords[i][1] + coords[i][2] * coords[i][2] );
+			if( dist > bounding_radius ){ bounding_radius = dist; }
+			
+		}
 	
 	
 	}
@@ -143,10 +159,16 @@ namespace PAPRECA{
 	const bool &PredefinedDeposition::hasVariableStickingCoeff( ) const{ return variable_sticking; }
 	void PredefinedDeposition::setStickingCoeff( const double &sticking_coeff_in ){ sticking_coeff = sticking_coeff_in; }
 	const double &PredefinedDeposition::getStickingCoeff( ) const{ return sticking_coeff; }
-	void PredefinedDeposition::incrementDepositionTries( ){ ++deposition_tries; }
+	void PredefinedDeposition::incrementDepositionTries( ){
+		const int thread_id = getThreadID( );
+		if( thread_id == 0 ){ ++deposition_tries; }else{ ++thread_tries[thread_id]; } //Threads other than the master thread count on their own slots (see PredefinedDeposition::mergeThreadCounters())
+	}
 	const int &PredefinedDeposition::getDepositionTries( ) const{ return deposition_tries; }
 	void PredefinedDeposition::resetDepositionTries( ){ deposition_tries = 0; }
-	void PredefinedDeposition::incrementDepositionSites( ){ ++deposition_sites; }
+	void PredefinedDeposition::incrementDepositionSites( ){
+		const int thread_id = getThreadID( );
+		if( thread_id == 0 ){ ++deposition_sites; }else{ ++thread_sites[thread_id]; }
+	}
 	const int &PredefinedDeposition::getDepositionSites( ) const{ return deposition_sites; }
 	void PredefinedDeposition::resetDepositionSites( ){ deposition_sites = 0; }
 	void PredefinedDeposition::resetDepositionTriesAndSites( ){
@@ -158,6 +180,136 @@ namespace PAPRECA{
 	int *PredefinedDeposition::getAtomTypes( ){ return atom_types; }
 	double *PredefinedDeposition::getCenter( ){ return center; }
 	double **PredefinedDeposition::getCoords( ){ return coords; }
+	void PredefinedDeposition::setTemplateID( const int &template_id_in ){ template_id = template_id_in; }
+	const int &PredefinedDeposition::getTemplateID( ) const{ return template_id; }
+	
+	void PredefinedDeposition::initThreadCounters( const int &threads_num ){
+		
+		/// Allocates per-thread deposition tries/sites counters, so that the counters can be incremented concurrently during threaded event detection.
+		/// @param[in] threads_num number of OpenMP threads used for event detection.
+		/// @see PAPRECA::loopAtomsAndIdentifyEventsWithThreads()
+		
+		thread_tries.assign( threads_num , 0 );
+		thread_sites.assign( threads_num , 0 );
+		
+	}
+	
+	void PredefinedDeposition::mergeThreadCounters( ){
+		
+		/// Adds the per-thread deposition tries/sites counters to the total counters and zeroes them. Integer sums do not depend on the order of the threads, so the merged counters are identical to those of serial event detection.
+		
+		for( size_t i = 0; i < thread_tries.size( ); ++i ){
+			deposition_tries += thread_tries[i];
+			deposition_sites += thread_sites[i];
+			thread_tries[i] = thread_sites[i] = 0;
+		}
+		
+	}
+	
+	//Collision checks
+	const double &PredefinedDeposition::getBoundingRadius( ) const{ return bounding_radius; }
+	const double *PredefinedDeposition::getCoordsX( ) const{ return coords_x.data( ); }
+	const double *PredefinedDeposition::getCoordsY( ) const{ return coords_y.data( ); }
+	const double *PredefinedDeposition::getCoordsZ( ) const{ return coords_z.data( ); }
+	
+	void PredefinedDeposition::initTypeSigmaMax( const std::vector< double > &type_sigma_max_in ){
+		
+		/// Stores the largest sigma between each system atom type and the template atoms, as well as the (squared) bounding-sphere reach of each system atom type.
+		/// @param[in] type_sigma_max_in type_sigma_max_in[t] is the largest sigma between atom type t and any template atom.
+		/// @see PAPRECA::PaprecaConfig::initDepositionCollisionCells(), PAPRECA::atomHasCollisionWithMolAtoms()
+		
+		type_sigma_max = type_sigma_max_in;
+		type_reach_sqr.resize( type_sigma_max.size( ) );
+		for( size_t i = 0; i < type_sigma_max.size( ); ++i ){ type_reach_sqr[i] = ( bounding_radius + type_sigma_max[i] ) * ( bounding_radius + type_sigma_max[i] ); }
+		
+	}
+	
+	const double &PredefinedDeposition::getTypeSigmaMax( const int &atom_type ) const{ return type_sigma_max[atom_type]; }
+	const double &PredefinedDeposition::getTypeReachSqr( const int &atom_type ) const{ return type_reach_sqr[atom_type]; }
+	
+	void PredefinedDeposition::initCollisionCells( const double &cell_size_in ){
+		
+		/// Bins the template atoms (i.e., their distances from the template center) in cubic cells of edge cell_size_in. The cells are stored in a compressed (CSR) layout.
+		/// @param[in] cell_size_in edge of each cell. This should be the maximum sigma in the system, so that all template atoms colliding with a system atom lie in the 3x3x3 block of cells around it.
+		/// @see PAPRECA::PaprecaConfig::initDepositionCollisionCells(), PAPRECA::candidateDepoHasCollisions()
+		
+		cell_start.clear( );
+		cell_atoms.clear( );
+		cell_size = 0.0;
+		if( cell_size_in <= 0.0 || atoms_num == 0 ){ return; }
+		
+		double cells_hi[3];
+		for( int k = 0; k < 3; ++k ){
+			cells_lo[k] = coords[0][k];
+			cells_hi[k] = coords[0][k];
+		}
+		for( int i = 1; i < atoms_num; ++i ){
+			for( int k = 0; k < 3; ++k ){
+				if( coords[i][k] < cells_lo[k] ){ cells_lo[k] = coords[i][k]; }
+				if( coords[i][k] > cells_hi[k] ){ cells_hi[k] = coords[i][k]; }
+			}
+		}
+		
+		cell_size = cell_size_in;
+		for( int k = 0; k < 3; ++k ){ cells_num[k] = static_cast< int >( ( cells_hi[k] - cells_lo[k] ) / cell_size ) + 1; }
+		
+		//Counting sort of template atoms into cells
+		std::vector< int > atom_cell( atoms_num );
+		cell_start.assign( cells_num[0] * cells_num[1] * cells_num[2] + 1 , 0 );
+		for( int i = 0; i < atoms_num; ++i ){
+			
+			int cell_ixyz[3];
+			for( int k = 0; k < 3; ++k ){ cell_ixyz[k] = std::min( static_cast< int >( ( coords[i][k] - cells_lo[k] ) / cell_size ) , cells_num[k] - 1 ); }
+			atom_cell[i] = getCollisionCellID( cell_ixyz[0] , cell_ixyz[1] , cell_ixyz[2] );
+			++cell_start[atom_cell[i]+1];
+			
+		}
+		for( size_t i = 1; i < cell_start.size( ); ++i ){ cell_start[i] += cell_start[i-1]; }
+		
+		cell_atoms.resize( atoms_num );
+		std::vector< int > cell_fill( cell_start.begin( ) , cell_start.end( ) - 1 );
+		for( int i = 0; i < atoms_num; ++i ){ cell_atoms[cell_fill[atom_cell[i]]++] = i; }
+		
+	}
+	
+	const bool PredefinedDeposition::collisionCellsAreInitialized( ) const{ return( cell_size > 0.0 ? true : false ); }
+	
+	const bool PredefinedDeposition::getCollisionCellsRange( const double *dist , const double &cutoff , int *cell_lo , int *cell_hi ) const{
+		
+		/// Returns the (inclusive) range of collision cells that may contain template atoms within cutoff of a point.
+		/// @param[in] dist position of the point relative to the template center.
+		/// @param[in] cutoff search radius around the point (should not exceed the collision cell size).
+		/// @param[out] cell_lo lower x, y, and z cell indices.
+		/// @param[out] cell_hi upper x, y, and z cell indices.
+		/// @return false if the range does not overlap with any cell, true otherwise.
+		
+		for( int k = 0; k < 3; ++k ){
+			
+			const double lo = ( dist[k] - cutoff - cells_lo[k] ) / cell_size;
+			const double hi = ( dist[k] + cutoff - cells_lo[k] ) / cell_size;
+			if( hi < 0.0 || lo >= cells_num[k] ){ return false; }
+			
+			cell_lo[k] = lo < 0.0 ? 0 : static_cast< int >( lo );
+			cell_hi[k] = std::min( static_cast< int >( hi ) , cells_num[k] - 1 );
+			
+		}
+		
+		return true;
+		
+	}
+	
+	const int PredefinedDeposition::getCollisionCellID( const int &ix , const int &iy , const int &iz ) const{ return ( iz * cells_num[1] + iy ) * cells_num[0] + ix; }
+	
+	const int *PredefinedDeposition::getCollisionCellAtoms( const int &cell_id , int &cell_atoms_num ) const{
+		
+		/// @param[in] cell_id ID of collision cell (see PAPRECA::PredefinedDeposition::getCollisionCellID()).
+		/// @param[out] cell_atoms_num number of template atoms in the cell.
+		/// @return pointer to the indices of template atoms in the cell.
+		
+		cell_atoms_num = cell_start[cell_id+1] - cell_start[cell_id];
+		return cell_atoms.data( ) + cell_start[cell_id];
+		
+	}
 	//-------------------------------------End of PredefinedDeposition Class-------------------------------------
 	
 	//---------------------------------PredefinedMonoatomicDesorption Class--------------------------------
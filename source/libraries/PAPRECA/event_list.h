@@ -37,6 +37,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <unordered_set>
 #include <unordered_map>
 #include <mpi.h>
+#include <cmath>
+#include <algorithm>
 
 //LAMMPS Headers
 #include "lammps.h"
@@ -139,6 +141,8 @@ namespace PAPRECA{
 			const std::string &getCustomStyle( ) const;
 			const std::vector< int > &getStyleAtomTypes( ) const;
 			const std::vector< double > &getStyleConstants( ) const;
+			void setTemplateID( const int &template_id_in );
+			const int &getTemplateID( ) const;
 			
 		private:
 			int parent_type = -1; ///< type of candidate parent atom.
@@ -152,6 +156,7 @@ namespace PAPRECA{
 			std::vector< double > style_constants; ///< vector that allows you to pass information about constants from the PAPRECA input file. For instance, used to store the "contaminant search distance" in style "Contaminants";
 			INTPAIR2DOUBLE_MAP contnum_to_rate; ///< integer pair to double map, mapping (parent_cont_num,candidate_cont_num)->rate. Only used for Contaminant diffusion.
 			double rate = 0.0; ///< rate of diffusion event. This is a placeholder for style "Contaminants" this is a placeholder (rates are extracted from contnum_to_rate;
+			int template_id = -1; ///< index of the template in PAPRECA::PaprecaConfig (identical on all MPI processes). Communicated instead of the style strings when a diffusion event is executed.
 	
 	};
 	
@@ -185,6 +190,24 @@ namespace PAPRECA{
 			int *getAtomTypes( );
 			double *getCenter( ) ;
 			double **getCoords( );
+			void setTemplateID( const int &template_id_in );
+			const int &getTemplateID( ) const;
+			void initThreadCounters( const int &threads_num );
+			void mergeThreadCounters( );
+			
+			//Collision checks
+			const double &getBoundingRadius( ) const;
+			const double *getCoordsX( ) const;
+			const double *getCoordsY( ) const;
+			const double *getCoordsZ( ) const;
+			void initTypeSigmaMax( const std::vector< double > &type_sigma_max_in );
+			const double &getTypeSigmaMax( const int &atom_type ) const;
+			const double &getTypeReachSqr( const int &atom_type ) const;
+			void initCollisionCells( const double &cell_size_in );
+			const bool collisionCellsAreInitialized( ) const;
+			const bool getCollisionCellsRange( const double *dist , const double &cutoff , int *cell_lo , int *cell_hi ) const;
+			const int getCollisionCellID( const int &ix , const int &iy , const int &iz ) const;
+			const int *getCollisionCellAtoms( const int &cell_id , int &cell_atoms_num ) const;
 			
 		
 		private:
@@ -195,14 +218,30 @@ namespace PAPRECA{
 			bool variable_sticking = true; ///< true or false for variable and fixed sticking coefficients, respectively.
 			int deposition_tries = 0; ///< total sites (i.e., free + occupied) for that specific deposition event.
 			int deposition_sites = 0; ///< available deposition sites for that specific deposition event.
+			std::vector< int > thread_tries; ///< deposition tries counted by OpenMP threads other than the master thread (only used for threaded event detection).
+			std::vector< int > thread_sites; ///< deposition sites counted by OpenMP threads other than the master thread (only used for threaded event detection).
 			double sticking_coeff = -1.0; ///< sticking coefficient (i.e., free sites/ total sites). Does not change its value if variable_sticking=false.
 			std::string adsorbate_name = "NONE"; ///< name of adsorbate. This has to be identical to the adsorbate name as initialized in the LAMMPS input file (e.g., if this command is used: "molecule mmmTCP ./TCP.xyz"), then your adsorbate name should be mmmTCP. 
+			int template_id = -1; ///< index of the template in PAPRECA::PaprecaConfig (identical on all MPI processes). Communicated instead of the adsorbate name when a deposition event is executed.
 			
 			//Lammps template definitions
 			int atoms_num = 0; ///< Number of molecule atoms in LAMMPS (and in the xyz molecule/particle input file).
 			int *atom_types = NULL; ///< Template molecule types from lammps. This is an int[mol_natoms] array.
 			double *center = NULL; //< Template molecule center coordinates array from lammps. This is a pointer to a double[3] array (defined in the LAMMPS header molecule.h).
 			double **coords = NULL; ///< Template molecule xyz (coordinates) array from lammps. This is a pointer to double[mol_natoms][3].
+			
+			//Collision cells
+			double bounding_radius = 0.0; ///< largest distance of a template atom from the template center. No system atom can collide with the molecule if it is further than bounding_radius+sigma_max from the candidate center.
+			std::vector< double > coords_x; ///< x-distances of template atoms from the template center (contiguous copy of coords).
+			std::vector< double > coords_y; ///< y-distances of template atoms from the template center (contiguous copy of coords).
+			std::vector< double > coords_z; ///< z-distances of template atoms from the template center (contiguous copy of coords).
+			std::vector< double > type_sigma_max; ///< type_sigma_max[t] is the largest sigma between a system atom of type t and any template atom.
+			std::vector< double > type_reach_sqr; ///< type_reach_sqr[t] is (bounding_radius+type_sigma_max[t])^2. System atoms of type t further than that from the candidate center cannot collide with the molecule.
+			double cell_size = 0.0; ///< edge of collision cells (equal to the maximum sigma in the system). Zero if the collision cells are not initialized.
+			double cells_lo[3] = { 0.0 , 0.0 , 0.0 }; ///< lower corner of the collision cells grid (relative to the template center).
+			int cells_num[3] = { 0 , 0 , 0 }; ///< number of collision cells along the x-, y-, and z-directions.
+			std::vector< int > cell_start; ///< cell_start[i] is the index of the first atom of cell i in cell_atoms (CSR layout). Has cells_num[0]*cells_num[1]*cells_num[2]+1 elements.
+			std::vector< int > cell_atoms; ///< template atom indices sorted by collision cell.
 	
 	
 	};
@@ -18,12 +18,73 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 ----------------------------------------------------------------------------------------*/
 
 /// \file ///
-/// @brief Definitions for event_detect.h.
+/// @brief Definitions for event_select.h.
 
 #include "event_select.h"
 
 namespace PAPRECA{
 	
+	//Constructors/Destructors
+	RateTree::RateTree( ){ }
+	RateTree::~RateTree( ){ }
+	
+	//Functions
+	void RateTree::build( const double *rates , const int &rates_num ){
+		
+		/// Builds the tree from an array of rates in O(n).
+		/// @param[in] rates array of rates.
+		/// @param[in] rates_num size of rates array.
+		/// @note Negative rates are not allowed.
+		
+		size = rates_num;
+		capacity = 1;
+		while( capacity < size ){ capacity *= 2; }
+		
+		nodes.assign( 2 * capacity , 0.0 );
+		for( int i = 0; i < size; ++i ){
+			if( rates[i] < 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Negative rate passed to RateTree::build (event_select.cpp)." ); }
+			nodes[capacity+i] = rates[i];
+		}
+		for( int node = capacity - 1; node > 0; --node ){ nodes[node] = nodes[2*node] + nodes[2*node+1]; }
+		
+	}
+	
+	const double &RateTree::getRatesSum( ) const{ return nodes[1]; }
+	const int &RateTree::getSize( ) const{ return size; }
+	
+	const int RateTree::selectIndex( const double &rnum ) const{
+		
+		/// Selects a process stochastically (through the classic N-FOLD way selection process) by descending the tree in O(log n).
+		/// @param[in] rnum uniformly distributed (between 0 and 1) pseudorandom number (usually drawn on master proc).
+		/// @return index of the selected process.
+		/// @see PAPRECA::selectAndExecuteEvent(), PAPRECA::selectAndExecuteSublatticeEvents()
+		/// @note Processes are selected in index order (i.e., in the order of PAPRECA::Event objects in events_local) and the rates are not sorted. Hence, the event selected for a given random number depends on the order in which events are detected on the event proc (and therefore on the domain decomposition). Runs are repeatable for the same random seed and the same number of MPI processes.
+		/// @note See paper and equation 3 here for more information regarding the classic N-FOLD way and the event selection process: https://www.sciencedirect.com/science/article/pii/S0927025623004159
+		
+		if( size == 0 || nodes[1] <= 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "No event was selected in RateTree::selectIndex (event_select.cpp) because the sum of rates is zero." ); }
+		
+		double target = rnum * nodes[1]; //Scale rnum by the sum of rates.
+		int node = 1;
+		while( node < capacity ){
+			const int left = 2 * node;
+			if( nodes[left] > 0.0 && target <= nodes[left] ){
+				node = left;
+			}else{
+				target -= nodes[left];
+				node = left + 1;
+			}
+		}
+		
+		//Floating point errors (e.g., rnum = 1.0 and nodes[1] slightly smaller than the accumulated sum of leaves) might send us to an empty leaf on the right. Fall back to the last process with a non-zero rate.
+		int index = node - capacity;
+		if( index >= size || nodes[node] <= 0.0 ){
+			for( index = size - 1; index >= 0 && nodes[capacity+index] <= 0.0; --index ){ }
+		}
+		
+		return index;
+		
+	}
+	
 	double getLocalRate( std::vector< Event* > &events_local , PaprecaConfig &papreca_config ){
 	
 		/// Calculates the total local (on the current MPI process) rate by summing the rates of the detected local events (contained in the PAPRECA::Event objects vector, events_local).
@@ -32,6 +93,7 @@ namespace PAPRECA{
 		/// @return local (per MPI process) rate.
 		/// @note This function also dumps surface coverage file (if activated by the user).
 		
+		papreca_config.reduceStepStats( ); //Single collective for the deposition tries/sites of all templates (used by the surface coverage and the sticking coefficients) and the execution times of the previous step
 		if( papreca_config.getSurfaceCoverageFile( ).isActive( ) ){ papreca_config.calcSurfaceCoverage( ); } //ALWAYS calculate the surface coverage BEFORE calculating the sticking coefficients. Do that because the calcStickingCoeffs function zeroes the depsites and deptries and those variables are neccesary to calcualte the surface coverage.
 		papreca_config.calcStickingCoeffs( );
 		
@@ -39,9 +101,9 @@ namespace PAPRECA{
 		for( const auto &event : events_local ){
 			
 			//For deposition events, scale event rate by sticking coefficient (the sticking coefficient of all events is initialized to 1 and the tweaked in this function).
-			if( event->getType( ) == "DEPO" ){
-				Deposition *depo = dynamic_cast< Deposition* >( event );	
-				event->setRate( event->getRate( ) * depo->getDepoTemplate( )->getStickingCoeff( ) ); //For non-variable sticking coefficient events the getStickingCoeff function will return the constant sticking coeff. For variable sticking coefficients, the relevant value is obtained from the calcStickingCoeffs function of the PaprecaConfig class.
+			if( event->getType( ) == EVENT_DEPO ){
+				Deposition *depo = static_cast< Deposition* >( event );
+				event->setRate( depo->getDepoTemplate( )->getRate( ) * depo->getDepoTemplate( )->getStickingCoeff( ) ); //Scale the template rate (and not the current event rate) so the scaling is not applied twice to deposition events kept between PAPRECA steps (see PAPRECA::EventCatalog). For non-variable sticking coefficient events the getStickingCoeff function will return the constant sticking coeff. For variable sticking coefficients, the relevant value is obtained from the calcStickingCoeffs function of the PaprecaConfig class.
 			}
 			
 			rate_local += event->getRate( );	
@@ -51,62 +113,26 @@ namespace PAPRECA{
 		
 	}
 	
-	void fillAndSortIndexedRatesVec( double *arr , const int &arr_size , DOUBLE2INTPAIR_VEC &rates_indexed ){
-		
-		/// Uses std::sort to sort a double array. Typically used to sort rates vector in ascending order. Sorting helps with faster event selection. It also ensures repeatability (if the same random number seed is used), because the event enumeration is maintained even if the domain decomposition numbering changes (i.e., if MPI decides to decompose the domain differently). The sorting is not performed on the array itself but on an auxiliary std::vector< std::pair< double , int > > containers that helps us sort while maintaining the index of events. This is necessary, since each time we stochastically select an event using the rates array, we have to link it (by index) to the correct PAPRECA::Event.
-		/// @param[in] arr double array container.
-		/// @param[in] arr_size size of arr.
-		/// @param[in,out] rates_indexed std::vector< std::pair< double , int > > container used for ascending sorting.
-		
-		rates_indexed.reserve( arr_size );
+	const int selectEventProc( const double &rate_local , const double &rate_prefix , const double &target , const int &last_active_proc , const int &proc_id , const int &nprocs ){
 		
-		for( int i = 0; i < arr_size; ++i ){
-			rates_indexed.push_back( std::make_pair( arr[i] , i ) );
-		}
+		/// Selects the MPI process that fires the next event (classic N-FOLD way) without gathering the rates of all MPI processes. Every MPI process owns the window [rate_prefix,rate_prefix+rate_local] of the cumulative rate and checks locally if the target falls in its window. The selected MPI process is then communicated through a single (integer) MPI_Allreduce.
+		/// @param[in] rate_local total rate of the current MPI process.
+		/// @param[in] rate_prefix sum of rates of all MPI processes with lower IDs (i.e., exclusive prefix sum obtained from MPI_Exscan).
+		/// @param[in] target rnum * (total rate of all MPI processes). Drawn on the master proc and communicated to all MPI processes.
+		/// @param[in] last_active_proc ID of the last MPI process with a non-zero rate.
+		/// @param[in] proc_id ID of current MPI process.
+		/// @param[in] nprocs total number of MPI processes.
+		/// @return ID of the selected MPI process (identical on all MPI processes).
+		/// @see PAPRECA::selectAndExecuteEvent(), PAPRECA::RateTree::selectIndex()
+		/// @note Selection follows PAPRECA::RateTree::selectIndex(): the selected MPI process is the first MPI process with a non-zero rate whose cumulative rate is larger than or equal to target. Every MPI process whose cumulative rate is larger than or equal to the target is a candidate and the minimum candidate ID is selected. Hence, rounding differences between the prefix sums of neighboring MPI processes never leave the target without an owner. If the target exceeds all cumulative rates (again, due to rounding) the last MPI process with a non-zero rate is selected.
 		
-
-
-		std::sort( rates_indexed.begin( ) , rates_indexed.end( ) );
-	}
-	
-	int selectProcessStochastically( double *arr , const int &arr_size , double &rnum , double &rates_sum ){
-		
-		/// Selects a process stochastically (through the classic N-FOLD way selection process). Can be used to select an MPI proc that fires an event or can be used to select the next kMC event inside the proc. The event selection is performed on a std::vector< std::pair< double , int > > container that holds the rate and the associated index of events.
-		/// @param[in] arr array of rates.
-		/// @param[in] arr_size size of arr.
-		/// @param[in] rnum uniformly distributed (between 0 and 1) pseudorandom number (usually drawn on master proc).
-		/// @param[in] rates_sum total sum of rates
-		/// @return integer that corresponds to the ith position of the provided vector (i.e., index of the selected process) or -1 if the function could not select a process (indicates error).
-		/// @see PAPRECA::selectAndExecuteEvent()
-		/// @note See paper and equation 3 here for more information regarding the classic N-FOLD way and the event selection process: https://www.sciencedirect.com/science/article/pii/S0927025623004159
+		int candidate_proc = nprocs;
+		if( rate_local > 0.0 && ( target <= rate_prefix + rate_local || proc_id == last_active_proc ) ){ candidate_proc = proc_id; }
 		
-		DOUBLE2INTPAIR_VEC rates_indexed; //We will be sorting the rates vec so we need a vector of <double,int> pairs (i.e., rate and proc num). This helps us know the proc num AFTER sorting the processes by rate.
-		//The rates vec is either a proc rates vec (index is the proc_num) or an event rates vec (index is the event num).
-		fillAndSortIndexedRatesVec( arr , arr_size , rates_indexed );
-		
-		rnum *= rates_sum; //Scale rnum by the sum of rates (could introduce floating point errors).
-		double rate_cur = 0.0;
-		
-		for( int i = 0; i < arr_size; ++i ){
-
-			double rate = rates_indexed[i].first;
-			int index = rates_indexed[i].second;
-			
-			if( rate > 0 ){ //Avoid processes (or procs) with zero rate.
-			
-				rate_cur += rate;
-				if( rnum <= rate_cur ){
-					return index;
-					
-				}
-			}
-			
-			
-			
-		}
+		int event_proc = nprocs;
+		MPI_Allreduce( &candidate_proc , &event_proc , 1 , MPI_INT , MPI_MIN , MPI_COMM_WORLD );
 		
-		allAbortWithMessage( MPI_COMM_WORLD , "No event was selected in function selectProcessStochastically in papreca.cpp" );
-		return -1; //This means that some error occurred and no process was selected
+		return ( event_proc < nprocs ? event_proc : -1 );
 		
 	}
 
@@ -43,9 +43,35 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 namespace PAPRECA{
 
+	class RateTree{
+		
+		/// @class PAPRECA::RateTree
+		/// @brief Binary sum tree of rates. Leaves store the rates of processes (i.e., MPI processes or PAPRECA::Event objects) in index order and every internal node stores the sum of its children.
+		///
+		/// The tree is built in O(n) and supports O(log n) selection (see RateTree::selectIndex()).
+		/// Selection follows the classic N-FOLD way: the selected index is the first index whose cumulative rate is larger than or equal to rnum * (sum of rates). Processes with zero rates are never selected.
+		/// @note The tree is rebuilt on every PAPRECA step (see PAPRECA::selectAndExecuteEvent()), since the PAPRECA::Event objects (and their indices) change between PAPRECA steps.
+		
+		public:
+			//Constructors/Destructors
+			RateTree( );
+			~RateTree( );
+			
+			//Functions
+			void build( const double *rates , const int &rates_num );
+			const double &getRatesSum( ) const;
+			const int &getSize( ) const;
+			const int selectIndex( const double &rnum ) const;
+			
+		private:
+			int size = 0; ///< number of stored rates (leaves).
+			int capacity = 1; ///< number of leaves of the (complete) binary tree. Always a power of 2 and larger than or equal to size.
+			std::vector< double > nodes; ///< stores the tree in a flat array. Node 1 is the root, the children of node i are 2i and 2i+1, and leaves start at index capacity.
+			
+	};
+	
 	double getLocalRate( std::vector< Event* > &events_local , PaprecaConfig &papreca_config );
-	void fillAndSortIndexedRatesVec( double *arr , const int &arr_size , DOUBLE2INTPAIR_VEC &rates_indexed );
-	int selectProcessStochastically( double *arr , const int &arr_size , double &rnum , double &rates_sum );
+	const int selectEventProc( const double &rate_local , const double &rate_prefix , const double &target , const int &last_active_proc , const int &proc_id , const int &nprocs );
 	
 }//end of PAPRECA namespace 
 
@@ -222,9 +222,9 @@ namespace PAPRECA{
 		
 	}
 	
-	void ElementalDistribution::append( LAMMPS_NS::LAMMPS *lmp , double **mass_profiles , const int &types_num , const int &bins_num , const double &bin_width , double *atom_mass ){
-		
+	void ElementalDistribution::append( LAMMPS_NS::LAMMPS *lmp , const std::vector< double > &mass_profiles , const int &types_num , const int &bins_num , const int &bin_lo , const int &occupied_bins_num , const double &bin_width , double *atom_mass ){
 		
+		//mass_profiles only stores the occupied bins (see PAPRECA::calcFilmHeight()). Bins outside [bin_lo,bin_lo+occupied_bins_num) are empty and are still printed.
 		for( int i = 0; i < bins_num; ++i ){
 			
 			double height = lmp->domain->boxlo[2] + double( i ) * bin_width;
@@ -236,7 +236,8 @@ namespace PAPRECA{
 			for( int j = 1; j < types_num + 1; ++j ){
 				
 				
-				int atoms_num = std::round( mass_profiles[i][j] / atom_mass[j] );
+				const bool bin_is_occupied = ( i >= bin_lo && i < bin_lo + occupied_bins_num );
+				int atoms_num = bin_is_occupied ? std::round( mass_profiles[( i - bin_lo ) * ( types_num + 1 ) + j] / atom_mass[j] ) : 0;
 				bin_total += atoms_num;
 				
 				file << std::setw( 32 ) << std::fixed << atoms_num << "   ";
@@ -288,21 +289,14 @@ namespace PAPRECA{
 		
 	}
 	
-	void ExecTime::calcHybridTime( const int &nprocs ){
+	void ExecTime::calcHybridTime( ){
 		
 		t2_hybrid = MPI_Wtime( );
 		
 		
-		//This calculates the total elapsed time ON EACH INDIVIDUAL PROC.
+		//This calculates the total elapsed time ON EACH INDIVIDUAL PROC. Min/avg/max values are obtained with the per-step statistics (see PAPRECA::PaprecaConfig::reduceStepStats()).
 		t_hybrid = t2_hybrid - t1_hybrid;
 		
-		MPI_Allreduce( &t_hybrid , &thybrid_min , 1 , MPI_DOUBLE , MPI_MIN , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_hybrid , &thybrid_max , 1 , MPI_DOUBLE , MPI_MAX , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_hybrid , &thybrid_avg , 1 , MPI_DOUBLE , MPI_SUM , MPI_COMM_WORLD );
-		thybrid_avg /= nprocs;
-		
-		thybrid_total += thybrid_avg;
-		
 		
 	}
 	
@@ -326,20 +320,12 @@ namespace PAPRECA{
 		
 	}
 	
-	void ExecTime::calcMDtime( const int &nprocs ){
+	void ExecTime::calcMDtime( ){
 		
 		
 		t2_md = MPI_Wtime( );
 		
-		t_md = t2_md - t1_md;
-		
-		MPI_Allreduce( &t_md , &tmd_min , 1 , MPI_DOUBLE , MPI_MIN , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_md , &tmd_max , 1 , MPI_DOUBLE , MPI_MAX , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_md , &tmd_avg , 1 , MPI_DOUBLE , MPI_SUM , MPI_COMM_WORLD );
-		tmd_avg /= nprocs;
-		
-		tmd_total += tmd_avg;
-		
+		t_md = t2_md - t1_md; //Local MD time. Min/avg/max values are obtained with the per-step statistics (see PAPRECA::PaprecaConfig::reduceStepStats()).
 		
 		
 	}
@@ -358,18 +344,10 @@ namespace PAPRECA{
 	}
 	
 	
-	void ExecTime::calcKMCtime( const int &nprocs ){
+	void ExecTime::calcKMCtime( ){
 		
 		t_kmc = t_hybrid - t_md;
 		
-		MPI_Allreduce( &t_kmc , &tkmc_min , 1 , MPI_DOUBLE , MPI_MIN , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_kmc , &tkmc_max , 1 , MPI_DOUBLE , MPI_MAX , MPI_COMM_WORLD );
-		MPI_Allreduce( &t_kmc , &tkmc_avg , 1 , MPI_DOUBLE , MPI_SUM , MPI_COMM_WORLD );
-		tkmc_avg /= nprocs;
-		
-		//The total KMC time is considered to be the sum of all average values. The same goes for the other time variables (hybrid, MD)
-		tkmc_total += tkmc_avg;
-		
 	}
 	
 	void ExecTime::resetKMCtimeVariables( ){
@@ -382,13 +360,99 @@ namespace PAPRECA{
 		
 		
 		
+	}
+	
+	void ExecTime::registerTimeStats( StepStats &step_stats ){
+		
+		/// Registers the min/max/sum of the local hybrid, MD, and kMC times in the per-step statistics.
+		/// @param[in,out] step_stats per-step statistics of PAPRECA::PaprecaConfig (see PAPRECA::PaprecaConfig::initStepStats()).
+		
+		thybrid_min_stat = step_stats.registerStat( STAT_MIN );
+		thybrid_max_stat = step_stats.registerStat( STAT_MAX );
+		thybrid_sum_stat = step_stats.registerStat( STAT_SUM );
+		tmd_min_stat = step_stats.registerStat( STAT_MIN );
+		tmd_max_stat = step_stats.registerStat( STAT_MAX );
+		tmd_sum_stat = step_stats.registerStat( STAT_SUM );
+		tkmc_min_stat = step_stats.registerStat( STAT_MIN );
+		tkmc_max_stat = step_stats.registerStat( STAT_MAX );
+		tkmc_sum_stat = step_stats.registerStat( STAT_SUM );
+		
+	}
+	
+	void ExecTime::setPendingTimes( const int &step_num , const int &atoms_num ){
+		
+		/// Marks the local times of the current PAPRECA step as pending. Those times are reduced along with the deposition statistics of the next PAPRECA step, so no collective is required at the end of the PAPRECA step.
+		/// @param[in] step_num current PAPRECA step.
+		/// @param[in] atoms_num number of atoms at the end of the current PAPRECA step.
+		/// @see PAPRECA::PaprecaConfig::reduceStepStats()
+		
+		pending_step = step_num;
+		pending_atoms = atoms_num;
+		
+	}
+	
+	const bool ExecTime::timesArePending( ) const{ return ( pending_step != -1 ); }
+	
+	void ExecTime::setLocalTimeStats( StepStats &step_stats ){
+		
+		/// @param[in,out] step_stats per-step statistics of PAPRECA::PaprecaConfig. The local values of the pending times are set before the reduction.
+		/// @note The MD time is zero if no MD stage was performed on the pending PAPRECA step.
+		
+		step_stats.setLocalValue( thybrid_min_stat , t_hybrid );
+		step_stats.setLocalValue( thybrid_max_stat , t_hybrid );
+		step_stats.setLocalValue( thybrid_sum_stat , t_hybrid );
+		step_stats.setLocalValue( tmd_min_stat , t_md );
+		step_stats.setLocalValue( tmd_max_stat , t_md );
+		step_stats.setLocalValue( tmd_sum_stat , t_md );
+		step_stats.setLocalValue( tkmc_min_stat , t_kmc );
+		step_stats.setLocalValue( tkmc_max_stat , t_kmc );
+		step_stats.setLocalValue( tkmc_sum_stat , t_kmc );
+		
+	}
+	
+	void ExecTime::getReducedTimeStats( const StepStats &step_stats , const int &nprocs ){
+		
+		/// Retrieves the min/avg/max values of the pending hybrid, MD, and kMC times from the (already reduced) per-step statistics.
+		/// @param[in] step_stats per-step statistics of PAPRECA::PaprecaConfig (see PAPRECA::PaprecaConfig::reduceStepStats()).
+		/// @param[in] nprocs total number of MPI processes.
+		
+		thybrid_min = step_stats.getGlobalValue( thybrid_min_stat );
+		thybrid_max = step_stats.getGlobalValue( thybrid_max_stat );
+		thybrid_avg = step_stats.getGlobalValue( thybrid_sum_stat ) / nprocs;
+		tmd_min = step_stats.getGlobalValue( tmd_min_stat );
+		tmd_max = step_stats.getGlobalValue( tmd_max_stat );
+		tmd_avg = step_stats.getGlobalValue( tmd_sum_stat ) / nprocs;
+		tkmc_min = step_stats.getGlobalValue( tkmc_min_stat );
+		tkmc_max = step_stats.getGlobalValue( tkmc_max_stat );
+		tkmc_avg = step_stats.getGlobalValue( tkmc_sum_stat ) / nprocs;
+		
+		//The total times are considered to be the sum of all average values.
+		thybrid_total += thybrid_avg;
+		tmd_total += tmd_avg;
+		tkmc_total += tkmc_avg;
+		
+		//Reset local times on all procs, so that the MD time of this step is not reduced again on steps without an MD stage.
+		t_hybrid = 0.0;
+		t_md = 0.0;
+		t_kmc = 0.0;
+		
+	}
+	
+	void ExecTime::appendPendingTimes( const int &proc_id ){
+		
+		/// Appends the reduced times of the pending PAPRECA step to the execTimes.log file (master proc only) and clears the pending step.
+		/// @param[in] proc_id ID of current MPI process.
+		
+		if( proc_id == 0 ){ append( pending_step , pending_atoms ); }
+		pending_step = -1;
+		
 	}
 	
 	void ExecTime::calcTimes( const int &nprocs ){
 		
-		calcMDtime( nprocs );
-		calcHybridTime( nprocs );
-		calcKMCtime( nprocs );
+		calcMDtime( );
+		calcHybridTime( );
+		calcKMCtime( );
 		
 		
 	}
@@ -414,9 +478,6 @@ namespace PAPRECA{
 			 << std::endl; 
 		
 		
-		//Reset variables after appending
-		resetTimeVariables( );
-		
 	}
 	
 	
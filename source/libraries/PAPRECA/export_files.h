@@ -30,10 +30,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <fstream>
 #include <iomanip>
 #include <mpi.h>
+#include <vector>
 
 //LAMMPS headers
 #include "lammps.h"
 #include "domain.h"
+
+//kMC headers
+#include "step_stats.h"
+
 namespace PAPRECA{
 
 	/* The classes below manage the result files exported by a run. New export files should be added here and a relevant implementation in the papreca_config.h and input_file.h headers should be included to read/manage/setup the files. */
@@ -144,7 +149,7 @@ namespace PAPRECA{
 			
 			//functions
 			void init( const int &KMC_loopid , const int &types_num );
-			void append( LAMMPS_NS::LAMMPS *lmp , double **mass_profiles , const int &types_num , const int &bins_num , const double &bin_width , double *atom_mass );
+			void append( LAMMPS_NS::LAMMPS *lmp , const std::vector< double > &mass_profiles , const int &types_num , const int &bins_num , const int &bin_lo , const int &occupied_bins_num , const double &bin_width , double *atom_mass );
 			
 	};
 	
@@ -168,16 +173,22 @@ namespace PAPRECA{
 			void close( ) override;
 			//Total Time Calculation
 			void setHybridStartTimeStamp( );
-			void calcHybridTime( const int &nprocs );
+			void calcHybridTime( );
 			void resetHybridTimeVariables( );
 			//MD time calculation
 			void setMDstartTimeStamp( );
-			void calcMDtime( const int &nprocs );
+			void calcMDtime( );
 			void resetMDtimeVariables( );	
 			//KMC time calculation
-			void calcKMCtime( const int &nprocs );
+			void calcKMCtime( );
 			void resetKMCtimeVariables( );
 			//General functions
+			void registerTimeStats( StepStats &step_stats );
+			void setPendingTimes( const int &step_num , const int &atoms_num );
+			const bool timesArePending( ) const;
+			void setLocalTimeStats( StepStats &step_stats );
+			void getReducedTimeStats( const StepStats &step_stats , const int &nprocs );
+			void appendPendingTimes( const int &proc_id );
 			void calcTimes( const int &nprocs );
 			void resetTimeVariables( );
 			
@@ -190,6 +201,13 @@ namespace PAPRECA{
 			double tmd_min = 0.0 , tmd_avg = 0.0 , tmd_max = 0.0;
 			double thybrid_total = 0.0 , tkmc_total = 0.0 , tmd_total = 0.0;
 			
+			//Per-step reduction of local times. The min/max/sum of all times are registered in the per-step statistics of PAPRECA::PaprecaConfig and reduced (one PAPRECA step later) along with the deposition statistics (see PAPRECA::PaprecaConfig::reduceStepStats()).
+			int thybrid_min_stat = -1 , thybrid_max_stat = -1 , thybrid_sum_stat = -1;
+			int tmd_min_stat = -1 , tmd_max_stat = -1 , tmd_sum_stat = -1;
+			int tkmc_min_stat = -1 , tkmc_max_stat = -1 , tkmc_sum_stat = -1;
+			int pending_step = -1; ///< PAPRECA step whose local times are not reduced yet (-1 if no times are pending).
+			int pending_atoms = 0; ///< number of atoms at the end of pending_step.
+			
 		
 	};
 
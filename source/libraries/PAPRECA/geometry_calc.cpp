@@ -25,127 +25,110 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace PAPRECA{
 	
 	//Film Height Calculation
-	void calcLocalMassAndFillMassProfile( LAMMPS_NS::LAMMPS *lmp , double **mass_profiles , double &local_mass , const int &atom_type , double *atom_xyz , const double &atom_mass , const double &bin_width , const int &bins_num ){
+	const int getMassBinID( LAMMPS_NS::LAMMPS *lmp , const double *atom_xyz , const double &bin_width , const int &bins_num ){
 		
-		/// Appends atom_mass to the relevant bin of mass_profiles array.
 		/// @param[in] lmp pointer to LAMMPS object.
-		/// @param[in,out] mass_profiles 2D (i.e., mass_profiles[bins_num][atomtypes_num]) array containing the total mass of a specific atom type for each x-y slice (bin) in the system.
-		/// @param[in,out] local_mass total mass in current MPI process.
-		/// @param[in] atom_type type of the current atom.
 		/// @param[in] atom_xyz array containing the coordinates of the current atom.
-		/// @param[in] atom_mass mass of current atom.
-		/// @param[in] bin_width width of current x-y slice (bin).
-		/// @param[in] bins_num total number of x-y slices (bins).
-		/// @see PAPRECA::initMassProfilesArr(), PAPRECA::deleteMassProfilesArr(), PAPRECA::fillMassProfilesTotalArrFromMassProfilesLocal(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
+		/// @param[in] bin_width width of each x-y slice (bin).
+		/// @param[in] bins_num total number of x-y slices (bins) in the simulation box.
+		/// @return ID of the x-y slice (bin) containing the atom. Bins are numbered from the lower bound of the simulation box along the z-dimension.
 		
-		int bin_num = round( ( atom_xyz[2] - lmp->domain->boxlo[2] ) / bin_width );
-		mass_profiles[bin_num][atom_type] += atom_mass; //Store mass of current atom in relevant bin
-		local_mass += atom_mass;		
-	}
-	
-	double **initMassProfilesArr( const int &types_num , const int &bins_num ){
+		int bin_id = round( ( atom_xyz[2] - lmp->domain->boxlo[2] ) / bin_width );
+		if( bin_id < 0 ){ bin_id = 0; } //Atoms slightly outside the box (i.e., before being remapped by LAMMPS) are placed in the boundary bins.
+		if( bin_id > bins_num - 1 ){ bin_id = bins_num - 1; }
+		
+		return bin_id;
 		
-		/// Initializes a 2D array of mass profiles (i.e., arr[bins_num][types_num]).
-		/// @param[in] types_num total number of atom types.
-		/// @param[in] bins_num total number of x-y slices (bins).
-		/// @return pointer to initialized 2D array of mass profiles.
-		/// @see PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::deleteMassProfilesArr(), PAPRECA::fillMassProfilesTotalArrFromMassProfilesLocal(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
-		/// @note Arrays initialized with this function have to be deleted manually using PAPRECA::deleteMassProfilesArr().
-		
-		double **mass_profiles = new double*[bins_num];
-		for( int i = 0; i < bins_num; ++i ){
-			mass_profiles[i] = new double[types_num+1]; //types_num + 1 because in lammps 0 is not mapped to anything and we need to be able to access mass_profiles[i][types_num] (in the TCP example this is type 8);
-			for( int j = 0; j < types_num + 1; ++j ){
-				mass_profiles[i][j] = 0; //Initialize all elements to zero to avoid segmentation faults			
-			}
-				
-		}	
-		return mass_profiles;
-	
 	}
 	
-	void deleteMassProfilesArr( double **mass_profiles , const int &bins_num  ){
-	
-		/// Deletes a previously-initialized 2D array of mass profiles.
-		/// @param[in,out] mass_profiles 2D array of mass profiles
-		/// @param[in] bins_num number of x-y slices (bins).
-		/// @see PAPRECA::initMassProfilesArr(), PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::fillMassProfilesTotalArrFromMassProfilesLocal(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
-		
-		for( int i = 0; i < bins_num; ++i ){
-				
-			delete[] mass_profiles[i]; //Delete internal arrays
-				
+	void getOccupiedMassBinsRange( LAMMPS_NS::LAMMPS *lmp , const int &natoms , double **atom_xyz , const double &bin_width , const int &bins_num , int &bin_lo , int &bin_hi ){
+		
+		/// Finds the lowest and highest x-y slices (bins) containing at least one atom in the whole system. Only those bins are stored in the mass profiles array (see PAPRECA::calcFilmHeight()).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in] natoms number of local atoms.
+		/// @param[in] atom_xyz LAMMPS array storing the coordinates of local atoms.
+		/// @param[in] bin_width width of each x-y slice (bin).
+		/// @param[in] bins_num total number of x-y slices (bins) in the simulation box.
+		/// @param[in,out] bin_lo ID of the lowest occupied bin in the whole system.
+		/// @param[in,out] bin_hi ID of the highest occupied bin in the whole system. If the system has no atoms, bin_hi is smaller than bin_lo.
+		/// @note Both bounds are retrieved with a single MPI_Allreduce (the lower bound is negated to use MPI_MAX for both).
+		
+		int range_local[2] = { -bins_num , -1 };
+		for( int i = 0; i < natoms; ++i ){
+			const int bin_id = getMassBinID( lmp , atom_xyz[i] , bin_width , bins_num );
+			if( -bin_id > range_local[0] ){ range_local[0] = -bin_id; }
+			if( bin_id > range_local[1] ){ range_local[1] = bin_id; }
 		}
-			
-		delete[] mass_profiles;
+		
+		int range[2];
+		MPI_Allreduce( range_local , range , 2 , MPI_INT , MPI_MAX , MPI_COMM_WORLD );
+		bin_lo = -range[0];
+		bin_hi = range[1];
 		
 	}
 	
-	void fillMassProfilesTotalArrFromMassProfilesLocal( const int &bins_num , const int &types_num , double **mass_profiles_total , double **mass_profiles_local ){
-	
-		/// Fills global array of mass profiles on master process (i.e., proc_id==0). This is done by invoking MPI_Reduce on the local mass profile arrays.
-		/// @param[in] bins_num total number of x-y slices (bins).
+	void calcLocalMassAndFillMassProfile( LAMMPS_NS::LAMMPS *lmp , std::vector< double > &mass_profiles , const int &atom_type , double *atom_xyz , const double &atom_mass , const double &bin_width , const int &bins_num , const int &bin_lo , const int &types_num ){
+		
+		/// Appends atom_mass to the relevant bin of mass_profiles array and to the total mass (i.e., last element of the mass_profiles array).
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @param[in,out] mass_profiles contiguous array containing the total mass of a specific atom type for each occupied x-y slice (bin) in the system. The mass of type j in bin i is stored in mass_profiles[( i - bin_lo ) * ( types_num + 1 ) + j]. The last element stores the total mass.
+		/// @param[in] atom_type type of the current atom.
+		/// @param[in] atom_xyz array containing the coordinates of the current atom.
+		/// @param[in] atom_mass mass of current atom.
+		/// @param[in] bin_width width of current x-y slice (bin).
+		/// @param[in] bins_num total number of x-y slices (bins) in the simulation box.
+		/// @param[in] bin_lo ID of the lowest occupied bin (see PAPRECA::getOccupiedMassBinsRange()).
 		/// @param[in] types_num total number of atom types.
-		/// @param[in,out] mass_profiles_total global 2D mass profiles array initialized and filled ONLY for the master process (i.e., proc_id==0).
-		/// @param[in] mass_profiles_local local (per MPI process) 2D array of mass profiles.
-		/// @see PAPRECA::initMassProfilesArr(), PAPRECA::deleteMassProfilesArr(), PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
-		
-		//Gather all mass profiles into master proc 0
-		for( int i = 0; i < bins_num; ++i ){
-					
-			for( int j = 0; j < types_num + 1; ++j ){
-					
-				MPI_Reduce( &mass_profiles_local[i][j] , &mass_profiles_total[i][j] , 1 , MPI_DOUBLE , MPI_SUM , 0 , MPI_COMM_WORLD ); //Reduce all values in proc 0
-						
-			}
-					
-					
-		}
+		/// @see PAPRECA::getOccupiedMassBinsRange(), PAPRECA::reduceMassProfiles(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
 		
+		const int bin_id = getMassBinID( lmp , atom_xyz , bin_width , bins_num );
+		mass_profiles[( bin_id - bin_lo ) * ( types_num + 1 ) + atom_type] += atom_mass; //Store mass of current atom in relevant bin
+		mass_profiles.back( ) += atom_mass;
 		
+	}
+	
+	void reduceMassProfiles( std::vector< double > &mass_profiles ){
+	
+		/// Sums the local mass profiles of all MPI processes. After this call, every MPI process stores the global mass profiles (and total mass).
+		/// @param[in,out] mass_profiles contiguous array of local mass profiles (see PAPRECA::calcLocalMassAndFillMassProfile()). Overwritten by the global mass profiles.
+		/// @see PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcFilmHeight()
+		/// @note A single MPI_Allreduce is used for all bins and types.
+		
+		if( mass_profiles.empty( ) ){ return; }
+		MPI_Allreduce( MPI_IN_PLACE , mass_profiles.data( ) , mass_profiles.size( ) , MPI_DOUBLE , MPI_SUM , MPI_COMM_WORLD );
 		
 	}
 	
-	void getFilmHeightFromMassBinsMethod( PaprecaConfig &papreca_config , LAMMPS_NS::LAMMPS *lmp , const int &proc_id , double &film_height , double **mass_profiles_total , const double &local_mass , double *atom_mass , const int &bins_num , const int &types_num , const double &bin_width ){
+	void getFilmHeightFromMassBinsMethod( PaprecaConfig &papreca_config , LAMMPS_NS::LAMMPS *lmp , double &film_height , const std::vector< double > &mass_profiles , const int &bin_lo , const int &occupied_bins_num , const int &types_num , const double &bin_width ){
 	
-		/// Uses the global 2D mass profiles array (initialized/filled in the master process) to calculate the film height in the current step.
+		/// Uses the global mass profiles array (see PAPRECA::reduceMassProfiles()) to calculate the film height in the current step. The film height is the height of the first bin at which the cumulative mass exceeds the user-defined percentage of the total mass.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in] lmp pointer to LAMMPS object.
-		/// @param[in] proc_id id of current MPI process.
 		/// @param[in,out] film_height height of current step.
-		/// @param[in] mass_profiles_total global 2D array of mass_profiles (initialized/filled in master MPI process).
-		/// @param[in] local_mass total mass in the current MPI process.
-		/// @param[in] atom_mass LAMMPS array storing the masses of atom_types.
-		/// @param[in] bins_num total number of x-y slices (bins).
+		/// @param[in] mass_profiles global contiguous array of mass profiles (identical on all MPI processes).
+		/// @param[in] bin_lo ID of the lowest occupied bin.
+		/// @param[in] occupied_bins_num number of bins stored in mass_profiles.
 		/// @param[in] types_num total number of atom types.
 		/// @param[in] bin_width width of each x-y slice (bin).
-		/// @see PAPRECA::initMassProfilesArr(), PAPRECA::deleteMassProfilesArr(), PAPRECA::fillMassProfilesTotalArrFromMassProfilesLocal(), PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::calcFilmHeight()
+		/// @see PAPRECA::getOccupiedMassBinsRange(), PAPRECA::reduceMassProfiles(), PAPRECA::calcLocalMassAndFillMassProfile(), PAPRECA::calcFilmHeight()
+		/// @note The film height is calculated on all MPI processes from the same global mass profiles. Hence, no broadcast is needed.
+		
+		film_height = lmp->domain->boxlo[2];
+		if( occupied_bins_num <= 0 ){ return; }
+		
+		const double mass_cutoff = papreca_config.getHeightPercentage( ) * mass_profiles.back( ); //This is the percentage over the total mass (arbitrarily set, but you can try changing it in APRECAT config and see if this affects your system).
+		if( mass_cutoff <= 0.0 ){ return; } //Empty bins below bin_lo already reach the cutoff.
 		
-		double total_mass = 0.0;
-			
-		//Get total mass on proc 0
-		MPI_Reduce( &local_mass , &total_mass , 1 , MPI_DOUBLE , MPI_SUM , 0 , MPI_COMM_WORLD );
-
-		double mass_cutoff = papreca_config.getHeightPercentage( ) * total_mass; //This is the percentage over the total mass (arbitrarily set, but you can try changing it in APRECAT config and see if this affects your system).
 		double mass_cur = 0.0;
-		film_height = 0.0;
+		for( int i = 0; i < occupied_bins_num; ++i ){
 			
-		//Select film height on proc 0 using the user Defined
-		if( proc_id == 0 ){
-					
-			for( int i = 0; i < bins_num; ++i ){
-						
-				double bin_mass = doubleArrSum( mass_profiles_total[i] , types_num + 1 );//The mass of the current bin is the sum of the mass of all the types. Here, note that we do an unnecessary loop (on types_num = 0);
-				mass_cur += bin_mass;
-				if( mass_cur >= mass_cutoff ){ //Mass total is non-zero ONLY on proc 0!
-					film_height = lmp->domain->boxlo[2] + double( i ) * bin_width;
-					break;
-				}
-			}			
+			const double *bin_masses = &mass_profiles[i * ( types_num + 1 )];
+			for( int j = 0; j < types_num + 1; ++j ){ mass_cur += bin_masses[j]; } //The mass of the current bin is the sum of the mass of all the types.
+			if( mass_cur >= mass_cutoff ){
+				film_height = lmp->domain->boxlo[2] + double( bin_lo + i ) * bin_width;
+				break;
+			}
 		}
-		
-		//Broadcast value from master proc 0 to all other procs
-		MPI_Bcast( &film_height , 1 , MPI_DOUBLE , 0 , MPI_COMM_WORLD );
 	
 	}
 	
@@ -157,8 +140,9 @@ namespace PAPRECA{
 		/// @param[in] KMC_loopid PAPRECA (kMC) step number.
 		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
 		/// @param[in,out] film_height height at current PAPRECA (kMC) step.
-		/// @see PAPRECA::initMassProfilesArr(), PAPRECA::deleteMassProfilesArr(), PAPRECA::fillMassProfilesTotalArrFromMassProfilesLocal(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcLocalMassAndFillMassProfile()
+		/// @see PAPRECA::getOccupiedMassBinsRange(), PAPRECA::reduceMassProfiles(), PAPRECA::getFilmHeightFromMassBinsMethod(), PAPRECA::calcLocalMassAndFillMassProfile()
 		/// @note This function also dumps ElementalDistributions files.
+		/// @note Mass profiles are only stored for the x-y slices (bins) between the lowest and highest atoms of the system. All bins are reduced with a single MPI_Allreduce.
 		
 		if( papreca_config.getHeightMethod( ) != "mass_bins" && !papreca_config.getElementalDistributionsFile( ).isActive( ) ){ return; }//For now, we bin the types ONLY if we dump ElementalDistribution files OR if we calculate the film height using the mass bins method.
 		
@@ -167,27 +151,26 @@ namespace PAPRECA{
 		double *atom_mass = ( double *)lammps_extract_atom( lmp , "mass" ); //extract atom mass: Careful, this is per-type, so you need to input the atom type number (goes from 0 to Ntypes+1)
 		int *atom_types = ( int *)lammps_extract_atom( lmp , "type" );//extract atom types
 		const int types_num = *( ( int * )lammps_extract_global( lmp , const_cast<char*>( "ntypes" ) ) ); //Extract total number of types
+		const double bin_width = papreca_config.getBinWidth( );
 
-		int bins_num = round( ( lmp->domain->boxhi[2] - lmp->domain->boxlo[2] ) / papreca_config.getBinWidth( ) ) + 1; //Calculate number of bins using the dimensions of the simulation box. Add +1 to avoid segmentation faults when calculating the mass profile of the highest atom.
-		double **mass_profiles = initMassProfilesArr( types_num , bins_num );
-		double local_mass = 0; //Sum to hold local (proc) mass.
-		
+		int bins_num = round( ( lmp->domain->boxhi[2] - lmp->domain->boxlo[2] ) / bin_width ) + 1; //Calculate number of bins using the dimensions of the simulation box. Add +1 to avoid segmentation faults when calculating the mass profile of the highest atom.
+		int bin_lo , bin_hi;
+		getOccupiedMassBinsRange( lmp , natoms , atom_xyz , bin_width , bins_num , bin_lo , bin_hi );
+		const int occupied_bins_num = ( bin_hi >= bin_lo ) ? bin_hi - bin_lo + 1 : 0;
 		
+		//types_num + 1 entries per bin because in lammps 0 is not mapped to anything and we need to be able to access type types_num (in the TCP example this is type 8). The extra element at the end stores the total mass.
+		std::vector< double > mass_profiles( occupied_bins_num * ( types_num + 1 ) + 1 , 0.0 );
 		for ( int i = 0; i < natoms; ++i ){
-			calcLocalMassAndFillMassProfile( lmp , mass_profiles , local_mass , atom_types[i] , atom_xyz[i] , atom_mass[atom_types[i]] , papreca_config.getBinWidth( ) , bins_num );
+			calcLocalMassAndFillMassProfile( lmp , mass_profiles , atom_types[i] , atom_xyz[i] , atom_mass[atom_types[i]] , bin_width , bins_num , bin_lo , types_num );
 		}
 		
-		
-		//From the local mass bins we need to get the "full" mass bins. The full mass bins is the global mass bins which is the sum of all the local bins (on proc 0).
-		double **mass_profiles_total = initMassProfilesArr( types_num , bins_num );
-		fillMassProfilesTotalArrFromMassProfilesLocal( bins_num , types_num , mass_profiles_total , mass_profiles );
+		//From the local mass bins we need to get the "full" mass bins. The full mass bins is the global mass bins which is the sum of all the local bins (on all procs).
+		reduceMassProfiles( mass_profiles );
 		
 		//Calculate film height only if a method is defined (currently, only mass_bins is supported).
-		if( papreca_config.getHeightMethod( ) == "mass_bins" ){ getFilmHeightFromMassBinsMethod( papreca_config , lmp , proc_id , film_height , mass_profiles_total , local_mass , atom_mass , bins_num , types_num , papreca_config.getBinWidth( ) ); }
-		if( papreca_config.getElementalDistributionsFile( ).isActive( ) ){ papreca_config.dumpElementalDistributionFile( lmp , proc_id , KMC_loopid , mass_profiles_total , atom_mass , bins_num , types_num ); }
-			
-		deleteMassProfilesArr( mass_profiles , bins_num ); 
-		deleteMassProfilesArr( mass_profiles_total , bins_num );
+		if( papreca_config.getHeightMethod( ) == "mass_bins" ){ getFilmHeightFromMassBinsMethod( papreca_config , lmp , film_height , mass_profiles , bin_lo , occupied_bins_num , types_num , bin_width ); }
+		if( papreca_config.getElementalDistributionsFile( ).isActive( ) ){ papreca_config.dumpElementalDistributionFile( lmp , proc_id , KMC_loopid , mass_profiles , atom_mass , bins_num , bin_lo , occupied_bins_num , types_num ); }
+		
 	}
 	
 	
@@ -202,15 +185,11 @@ namespace PAPRECA{
 		/// @param[in] atom2_xyz coordinates of the second atom (x,y, and z).
 		/// @param[in] atom2_type atom type of the second atom.
 		/// @return true or false if atoms collide or don't collide, respectively.
-		/// @see PAPRECA::getDepoEventsFromAtom(), PAPRECA::atomHasCollisionWithMolAtoms(), PAPRECA::candidateDepoHasCollisions(), PAPRECA::getDiffEventsFromAtom()
+		/// @see PAPRECA::getDiffEventsFromAtom(), PAPRECA::candidateDiffHasCollisions(), PAPRECA::PaprecaConfig::getSigmaSqrFromAtomTypes()
 		
-		double sigma = papreca_config.getSigmaFromAtomTypes( atom1_type , atom2_type );
-		if( sigma == 0 ){ 
-			const std::string warn_message = "Sigma between types " + std::to_string( atom1_type ) + " and " + std::to_string( atom2_type ) + " is zero! Collisions might not be checked correctly! Please ensure that all sigmas are initialized properly. ";
-			allAbortWithMessage( MPI_COMM_WORLD , warn_message.c_str( ) );
-		}
+		const double sigma_sqr = papreca_config.getSigmaSqrFromAtomTypes( atom1_type , atom2_type ); //Aborts if sigma is unmapped or zero
 		double dist_sqr = get3DSqrDistWithPBC( lmp , atom1_xyz , atom2_xyz );
-		if( dist_sqr < sigma * sigma ){
+		if( dist_sqr < sigma_sqr ){
 			return true;
 			
 		}
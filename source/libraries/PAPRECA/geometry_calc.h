@@ -40,11 +40,11 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 namespace PAPRECA{
 	
 	//Film Height calculation
-	void calcLocalMassAndFillMassProfile( LAMMPS_NS::LAMMPS *lmp , double **mass_profiles , double &local_mass , const int &atom_type , double *atom_xyz , const double &atom_mass , const double &bin_width , const int &bins_num );
-	double **initMassProfilesArr( const int &types_num , const int &bins_num );
-	void deleteMassProfilesArr( double **mass_profiles , const int &bins_num  );
-	void fillMassProfilesTotalArrFromMassProfilesLocal( const int &bins_num , const int &types_num , double **mass_profiles_total , double **mass_profiles_local );
-	void getFilmHeightFromMassBinsMethod( PaprecaConfig &papreca_config , LAMMPS_NS::LAMMPS *lmp , const int &proc_id , double &film_height , double **mass_profiles_total , const double &local_mass , double *atom_mass , const int &bins_num , const int &types_num , const double &bin_width );
+	const int getMassBinID( LAMMPS_NS::LAMMPS *lmp , const double *atom_xyz , const double &bin_width , const int &bins_num );
+	void getOccupiedMassBinsRange( LAMMPS_NS::LAMMPS *lmp , const int &natoms , double **atom_xyz , const double &bin_width , const int &bins_num , int &bin_lo , int &bin_hi );
+	void calcLocalMassAndFillMassProfile( LAMMPS_NS::LAMMPS *lmp , std::vector< double > &mass_profiles , const int &atom_type , double *atom_xyz , const double &atom_mass , const double &bin_width , const int &bins_num , const int &bin_lo , const int &types_num );
+	void reduceMassProfiles( std::vector< double > &mass_profiles );
+	void getFilmHeightFromMassBinsMethod( PaprecaConfig &papreca_config , LAMMPS_NS::LAMMPS *lmp , double &film_height , const std::vector< double > &mass_profiles , const int &bin_lo , const int &occupied_bins_num , const int &types_num , const double &bin_width );
 	void calcFilmHeight( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &KMC_loopid , PaprecaConfig &papreca_config , double &film_height );
 	
 	//Interference between atoms
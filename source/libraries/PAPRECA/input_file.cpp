@@ -637,7 +637,7 @@ namespace PAPRECA{
 		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
 		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
 		
-		std::string error_message = "Invalid desorption command. Must be desorption N style (where N is a double number denoting the desorption height). Style can be gather_all or gather_local or LAMMPS_region. Acceptable keyword ONLY for the gather_all and gather_local styles: max N (where N is the maximum number of atoms that can be deleted at once)";
+		std::string error_message = "Invalid desorption command. Must be desorption N style (where N is a double number denoting the desorption height). Style can be gather_all or gather_local or gather_filtered or LAMMPS_region. Acceptable keyword ONLY for the gather_all, gather_local, and gather_filtered styles: max N (where N is the maximum number of atoms that can be deleted at once)";
 		if( commands.size( ) < 3 ){ allAbortWithMessage( MPI_COMM_WORLD , error_message ); }
 		
 		
@@ -648,14 +648,14 @@ namespace PAPRECA{
 		
 		std::string style = commands[2];
 		
-		if( style == "gather_all" && style == "gather_local" && style != "LAMMPS_region" ){ allAbortWithMessage( MPI_COMM_WORLD , error_message ); } //If you reach any point below you are 100% certain that the correct styles are used
+		if( style != "gather_all" && style != "gather_local" && style != "gather_filtered" && style != "LAMMPS_region" ){ allAbortWithMessage( MPI_COMM_WORLD , error_message ); } //If you reach any point below you are 100% certain that the correct styles are used
 		if( style == "LAMMPS_region" && commands.size( ) > 3 ){ allAbortWithMessage( MPI_COMM_WORLD , error_message ); } //Exit immediately if LAMMPS region is called with additional keywords (because LAMMPS_region has no extra arguments
 		
 		papreca_config.setDesorptionHeight( desorption_height );
 		papreca_config.setDesorptionStyle( style );
 		
-		//Check for the acceptable argument "max" for styles gather_local and gather_all
-		if( ( style == "gather_all" || style == "gather_local" ) && commands.size( ) > 3 ){
+		//Check for the acceptable argument "max" for styles gather_local, gather_all, and gather_filtered
+		if( ( style == "gather_all" || style == "gather_local" || style == "gather_filtered" ) && commands.size( ) > 3 ){
 			
 			if( commands[3] != "max" || commands.size( ) != 5 ){ allAbortWithMessage( MPI_COMM_WORLD , error_message ); }
 			
@@ -836,8 +836,9 @@ namespace PAPRECA{
 		/// Sets an nve/lim integrator for a number of PAPRECA steps on reacted atoms after a bond-breaking event.
 		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
 		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		/// @note If the persistent keyword is set to yes, the nve/limit integrator is installed here (once) instead of before every MD stage.
 		
-		if( commands.size( ) != 3 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid nve_lim command. Must be nve_lim N xmax (where N is an integer denoting the number of LAMMPS MD time steps for nve/lim integration and xmax is a positive double number denoting the maximum distance an atom can move in one timestep: https://docs.lammps.org/fix_nve_limit.html)."); }
+		if( commands.size( ) != 3 && commands.size( ) != 5 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid nve_lim command. Must be nve_lim N xmax (where N is an integer denoting the number of LAMMPS MD time steps for nve/lim integration and xmax is a positive double number denoting the maximum distance an atom can move in one timestep: https://docs.lammps.org/fix_nve_limit.html), optionally followed by persistent yes/no."); }
 		const int maxsteps = string2Int( commands[1] );
 		if( maxsteps <= 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid nve_lim command: N must be a positive integer number denoting the number of LAMMPS MD time steps for nve/lim integration"); }
 		
@@ -849,6 +850,12 @@ namespace PAPRECA{
 		papreca_config.setNveLimDist( xmax );
 		lmp->input->one( "group nve_limited empty" ); //create the nve_limited group with no atoms included
 		
+		if( commands.size( ) == 5 ){
+			if( commands[3] != "persistent" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown keyword " + commands[3] + " in nve_lim command. The only acceptable keyword is persistent." ); }
+			papreca_config.setNveLimPersistent( string2Bool( commands[4] ) );
+		}
+		if( papreca_config.nveLimIsPersistent( ) ){ setupNveLimIntegrator( lmp , papreca_config ); } //The integrator acts on the (empty) nve_limited group and is never removed
+		
 		
 	}
 	
@@ -887,6 +894,153 @@ namespace PAPRECA{
 		
 	}
 	
+	void executeIncrementalDetectionCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Activates/deactivates incremental event detection (see PAPRECA::EventCatalog) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid incremental_detection command. Must be incremental_detection yes/no."); }
+		
+		const bool incremental_detection = string2Bool( commands[1] );
+		papreca_config.setIncrementalDetection( incremental_detection );
+		
+	}
+	
+	void executeBondAdjacencyCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Selects how the bonds of atoms are retrieved on each PAPRECA step (see PAPRECA::Bond::initAtomID2BondsMap() and PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()).
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid bond_adjacency command. Must be bond_adjacency global/local."); }
+		
+		if( commands[1] == "global" ){
+			papreca_config.setLocalBondAdjacency( false );
+		}else if( commands[1] == "local" ){
+			papreca_config.setLocalBondAdjacency( true );
+		}else{
+			allAbortWithMessage( MPI_COMM_WORLD , "Invalid bond_adjacency style: " + commands[1] + ". Must be global or local." );
+		}
+		
+	}
+	
+	void executeNativeExecutionCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Activates/deactivates the native execution of events (see lammps_native.h) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid native_execution command. Must be native_execution yes/no."); }
+		
+		const bool native_execution = string2Bool( commands[1] );
+		papreca_config.setNativeExecution( native_execution );
+		
+	}
+	
+	void executeSublatticeKMCCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Activates/deactivates synchronous sublattice kMC (see PAPRECA::selectAndExecuteSublatticeEvents()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid sublattice_kmc command. Must be sublattice_kmc yes/no."); }
+		
+		const bool sublattice_kmc = string2Bool( commands[1] );
+		papreca_config.setSublatticeKMC( sublattice_kmc );
+		
+	}
+	
+	void executeKMCBatchCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Sets the maximum number of PAPRECA steps executing events from the same event detection pass (see PAPRECA::continueEventBatch()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid kmc_batch command. Must be kmc_batch N (where N is the maximum number of kMC steps per event detection pass)."); }
+		
+		const int kmc_batch_size = string2Int( commands[1] );
+		if( kmc_batch_size < 1 ){ allAbortWithMessage( MPI_COMM_WORLD , "kmc_batch has to be a positive integer." ); }
+		papreca_config.setKMCBatchSize( kmc_batch_size );
+		
+	}
+	
+	void executeDetectionThreadsCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Sets the number of OpenMP threads per MPI process used for event detection (see PAPRECA::loopAtomsAndIdentifyEventsWithThreads()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid detection_threads command. Must be detection_threads N (where N is the number of OpenMP threads per MPI process)."); }
+		
+		const int detection_threads = string2Int( commands[1] );
+		if( detection_threads < 1 ){ allAbortWithMessage( MPI_COMM_WORLD , "detection_threads has to be a positive integer." ); }
+		#ifndef _OPENMP
+		if( detection_threads > 1 ){ allAbortWithMessage( MPI_COMM_WORLD , "detection_threads > 1 requires PAPRECA to be compiled with OpenMP support." ); }
+		#endif
+		papreca_config.setDetectionThreadsNum( detection_threads );
+		
+	}
+	
+	void executeCounterRNGCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Activates/deactivates counter-based random numbers for random deposition/diffusion vectors (see PaprecaConfig::getDetectionRanNums()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid counter_rng command. Must be counter_rng yes/no."); }
+		
+		const bool counter_rng = string2Bool( commands[1] );
+		papreca_config.setCounterRNG( counter_rng );
+		
+	}
+	
+	void executeDepoSiteToleranceCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Sets the distance below which deposition candidates are considered identical (see PAPRECA::DepositionSiteGrid) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid depo_site_tolerance command. Must be depo_site_tolerance D (where D is the distance below which deposition candidates are considered identical)."); }
+		
+		const double depo_site_tolerance = string2Double( commands[1] );
+		if( depo_site_tolerance < 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "depo_site_tolerance cannot be negative." ); }
+		papreca_config.setDepoSiteTolerance( depo_site_tolerance );
+		
+	}
+	
+	void executeLocalRelaxCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Sets the radius of localized relaxation (see PAPRECA::equilibrateFluidAtoms()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 2 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid local_relax command. Must be local_relax R (where R is the radius around touched atoms within which fluid atoms are integrated on normal MD stages)."); }
+		
+		const double local_relax_radius = string2Double( commands[1] );
+		if( local_relax_radius < 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "local_relax radius cannot be negative." ); }
+		papreca_config.setLocalRelaxRadius( local_relax_radius );
+		
+	}
+	
+	void executeAdaptiveMDCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
+		
+		/// Sets the chunk length, convergence metric, and convergence tolerance of adaptive MD stages (see PAPRECA::runAdaptiveTrajectory()) in the PAPRECA::PaprecaConfig object.
+		/// @param[in] commands trimmed/processed vector of strings. This is effectively the entire command line with each vector element (i.e., std::string) being a single word/number.
+		/// @param[in,out] papreca_config previously instantiated PAPRECA::PaprecaConfig object storing the settings and global variables for the PAPRECA simulation.
+		
+		if( commands.size( ) != 4 ){ allAbortWithMessage( MPI_COMM_WORLD , "Invalid adaptive_md command. Must be adaptive_md N metric tol (where N is the chunk length in timesteps, metric is fmax, disp, or pe, and tol is the convergence tolerance)."); }
+		
+		const int adaptive_md_chunk = string2Int( commands[1] );
+		if( adaptive_md_chunk < 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "The chunk length in adaptive_md command cannot be negative." ); }
+		if( commands[2] != "fmax" && commands[2] != "disp" && commands[2] != "pe" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown metric " + commands[2] + " in adaptive_md command. The metric can be fmax, disp, or pe." ); }
+		const double adaptive_md_tol = string2Double( commands[3] );
+		if( adaptive_md_tol < 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "The tolerance in adaptive_md command cannot be negative." ); }
+		
+		papreca_config.setAdaptiveMD( adaptive_md_chunk , commands[2] , adaptive_md_tol );
+		
+	}
+	
 	
 	void executeCreateBondBreakCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config ){
 	
@@ -1325,6 +1479,26 @@ namespace PAPRECA{
 			executeDepoheightsCommand( commands , papreca_config );
 		}else if( command_class == "random_depovecs" ){
 			executeRandomDepovecsCommand( commands , papreca_config );
+		}else if( command_class == "incremental_detection" ){
+			executeIncrementalDetectionCommand( commands , papreca_config );
+		}else if( command_class == "bond_adjacency" ){
+			executeBondAdjacencyCommand( commands , papreca_config );
+		}else if( command_class == "native_execution" ){
+			executeNativeExecutionCommand( commands , papreca_config );
+		}else if( command_class == "sublattice_kmc" ){
+			executeSublatticeKMCCommand( commands , papreca_config );
+		}else if( command_class == "kmc_batch" ){
+			executeKMCBatchCommand( commands , papreca_config );
+		}else if( command_class == "detection_threads" ){
+			executeDetectionThreadsCommand( commands , papreca_config );
+		}else if( command_class == "counter_rng" ){
+			executeCounterRNGCommand( commands , papreca_config );
+		}else if( command_class == "depo_site_tolerance" ){
+			executeDepoSiteToleranceCommand( commands , papreca_config );
+		}else if( command_class == "local_relax" ){
+			executeLocalRelaxCommand( commands , papreca_config );
+		}else if( command_class == "adaptive_md" ){
+			executeAdaptiveMDCommand( commands , papreca_config );
 		}else if( command_class == "create_BondBreak" ){
 			executeCreateBondBreakCommand( commands , papreca_config );
 		}else if( command_class == "create_BondForm" ){
@@ -1391,6 +1565,8 @@ namespace PAPRECA{
 	
 		if( papreca_config.predefinedCatalogIsEmpty( ) ){ warnAll( MPI_COMM_WORLD , "No predefined events were defined!" ); }
 		if( papreca_config.getKMCperMD( ) != std::numeric_limits< unsigned long int >::max( ) && papreca_config.getTrajDuration( ) == 0 && papreca_config.getMinimize1( ).empty( ) && papreca_config.getMinimize2( ).empty( ) ){ warnAll( MPI_COMM_WORLD , "KMC per MD defined but no equilibration scheme set (i.e., trajectory duration is 0, and no prior or after minimization commands were set" ); }
+		if( papreca_config.localRelaxIsActive( ) && papreca_config.getKMCperLongMD( ) == std::numeric_limits< unsigned long int >::max( ) ){ warnAll( MPI_COMM_WORLD , "local_relax is active but KMC_per_longMD was not set. Fluid atoms far from executed events will only be integrated on steps with zero total event rate." ); }
+		if( papreca_config.adaptiveMDIsActive( ) && papreca_config.getAdaptiveMDChunk( ) >= papreca_config.getTrajDuration( ) ){ warnAll( MPI_COMM_WORLD , "The adaptive_md chunk length is not smaller than the trajectory duration. Normal MD stages will always run for the full trajectory duration." ); }
 	
 	}
 	
@@ -1474,6 +1650,10 @@ namespace PAPRECA{
 		warn4IllegalRuns( proc_id , papreca_config );
 		abortIllegalRun( proc_id , papreca_config );
 		
+		papreca_config.compilePredefinedCatalog( lmp ); //Dense lookup tables for event detection. The predefined catalog and sigmas do not change after this point.
+		papreca_config.initThreadedDetection( );
+		Event::initEventPools( papreca_config.getDetectionThreadsNum( ) ); //One event pool per detection thread
+		
 			
 			
 	}	
@@ -40,6 +40,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "papreca_error.h"
 #include "papreca_config.h"
 #include "event_list.h"
+#include "event.h"
 #include "rates_calc.h"
 #include "utilities.h"
 #include "lammps_wrappers.h"
@@ -81,6 +82,16 @@ namespace PAPRECA{
 	void executeNveLimCommand( LAMMPS_NS::LAMMPS *lmp , std::vector< std::string > &commands , PaprecaConfig &papreca_config );
 	void executeDepoheightsCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
 	void executeRandomDepovecsCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeIncrementalDetectionCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeBondAdjacencyCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeNativeExecutionCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeSublatticeKMCCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeKMCBatchCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeDetectionThreadsCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeCounterRNGCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeDepoSiteToleranceCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeLocalRelaxCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
+	void executeAdaptiveMDCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
 	void executeCreateBondBreakCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
 	void executeCreateBondFormCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
 	void executeCreateDiffusionHopCommand( std::vector< std::string > &commands , PaprecaConfig &papreca_config );
@@ -0,0 +1,478 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Definitions for lammps_native.h.
+
+#include "lammps_native.h"
+
+namespace PAPRECA{
+
+	//Helpers
+	const bool nativeOperationsAreSupported( LAMMPS_NS::LAMMPS *lmp ){
+
+		/// Checks if the current LAMMPS system can be modified natively.
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @return true if the simulation box is orthogonal, atoms have IDs, and an atom map is defined. False otherwise.
+		/// @note The return value is identical on all MPI processes.
+
+		if( lmp->domain->triclinic ){ return false; } //Native operations do not convert coordinates to lamda coordinates.
+		if( !lmp->atom->tag_enable ){ return false; }
+		if( lmp->atom->map_style == LAMMPS_NS::Atom::MAP_NONE ){ return false; }
+
+		return true;
+
+	}
+
+	const bool allProcsAgree( const bool &local_flag ){
+
+		/// @param[in] local_flag boolean flag on the current MPI process.
+		/// @return true if local_flag is true on all MPI processes.
+
+		int flag = local_flag ? 1 : 0;
+		int flag_all = 0;
+		MPI_Allreduce( &flag , &flag_all , 1 , MPI_INT , MPI_MIN , MPI_COMM_WORLD );
+
+		return ( flag_all == 1 );
+
+	}
+
+	const int getOwnedAtomIndex( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom_id ){
+
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom_id ID of atom.
+		/// @return local index of atom_id if the atom is owned by the current MPI process, or -1 otherwise (i.e., if the atom does not exist or is a ghost atom).
+
+		if( atom_id <= 0 || atom_id > lmp->atom->map_tag_max ){ return -1; }
+
+		const int iatom = lmp->atom->map( atom_id );
+		return( ( iatom >= 0 && iatom < lmp->atom->nlocal ) ? iatom : -1 );
+
+	}
+
+	void resetAtomMap( LAMMPS_NS::LAMMPS *lmp ){
+
+		/// Discards ghost atoms and re-creates the LAMMPS atom map (global atom ID to local index) for owned atoms. Ghost atoms are re-created by the next LAMMPS run.
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @note Has to be called by all MPI processes.
+
+		lmp->atom->nghost = 0;
+		lmp->atom->map_init( );
+		lmp->atom->map_set( );
+
+	}
+
+	void recountBonds( LAMMPS_NS::LAMMPS *lmp ){
+
+		/// Recounts the total number of bonds in the system (i.e., lmp->atom->nbonds).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @note Has to be called by all MPI processes.
+
+		LAMMPS_NS::bigint nbonds_local = 0;
+		for( int i = 0; i < lmp->atom->nlocal; ++i ){ nbonds_local += lmp->atom->num_bond[i]; }
+
+		LAMMPS_NS::bigint nbonds = 0;
+		MPI_Allreduce( &nbonds_local , &nbonds , 1 , MPI_LMP_BIGINT , MPI_SUM , MPI_COMM_WORLD );
+		if( !lmp->force->newton_bond ){ nbonds /= 2; } //Each bond is stored by both atoms.
+
+		lmp->atom->nbonds = nbonds;
+
+	}
+
+	void removeBondsOfOwnedAtom( LAMMPS_NS::LAMMPS *lmp , const int &iatom , const TAGINT_SET &bond_atom_ids ){
+
+		/// Removes all bonds stored by an owned atom whose bonded atom is contained in bond_atom_ids.
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] iatom local index of owned atom.
+		/// @param[in] bond_atom_ids std::unordered_set of IDs of bonded atoms.
+		/// @note Removed bonds are replaced by the last bond of iatom (as in the delete_bonds command with the remove keyword).
+
+		int *num_bond = lmp->atom->num_bond;
+		int **bond_type = lmp->atom->bond_type;
+		LAMMPS_NS::tagint **bond_atom = lmp->atom->bond_atom;
+
+		int m = 0;
+		while( m < num_bond[iatom] ){
+
+			if( elementIsInUnorderedSet( bond_atom_ids , bond_atom[iatom][m] ) ){
+				const int last = num_bond[iatom] - 1;
+				bond_type[iatom][m] = bond_type[iatom][last];
+				bond_atom[iatom][m] = bond_atom[iatom][last];
+				--num_bond[iatom];
+			}else{
+				++m;
+			}
+
+		}
+
+	}
+
+	//kMC operations
+	const bool deleteAtomsNative( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule ){
+
+		/// Natively deletes all atoms with the given IDs (equivalent to PAPRECA::deleteAtoms()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom_ids array of IDs of atoms to be deleted.
+		/// @param[in] num_atoms number of atoms to be deleted (length of atom_ids array).
+		/// @param[in] delete_bonds if "yes", bonds between remaining atoms and deleted atoms are also removed.
+		/// @param[in] delete_molecule if "yes", whole molecules have to be deleted. Not supported natively.
+		/// @return true if the atoms were deleted, or false if the operation is not supported natively (the system is not modified in that case).
+		/// @note Mirrors the delete_atoms LAMMPS command: owned atoms are deleted by copying the last owned atom in their place, and atom IDs of atomic (i.e., non-molecular) systems are compressed.
+		/// @note Has to be called by all MPI processes.
+
+		if( !nativeOperationsAreSupported( lmp ) || delete_molecule == "yes" ){ return false; }
+
+		LAMMPS_NS::Atom *atom = lmp->atom;
+		const bool molecular = ( atom->molecular == LAMMPS_NS::Atom::MOLECULAR );
+		if( delete_bonds == "yes" && molecular && ( atom->avec->angles_allow || atom->avec->dihedrals_allow || atom->avec->impropers_allow ) ){ return false; } //Only bonds of remaining atoms are cleaned natively.
+
+		TAGINT_SET delids_set( atom_ids , atom_ids + num_atoms );
+
+		int nlocal = atom->nlocal;
+		int i = 0;
+		while( i < nlocal ){
+			if( elementIsInUnorderedSet( delids_set , atom->tag[i] ) ){
+				atom->avec->copy( nlocal - 1 , i , 1 );
+				--nlocal;
+			}else{
+				++i;
+			}
+		}
+		atom->nlocal = nlocal;
+
+		if( delete_bonds == "yes" && molecular ){
+			for( int i = 0; i < nlocal; ++i ){ removeBondsOfOwnedAtom( lmp , i , delids_set ); }
+		}
+
+		if( atom->molecular == LAMMPS_NS::Atom::ATOMIC ){ //Compress atom IDs (as in delete_atoms with compress yes).
+			for( int i = 0; i < nlocal; ++i ){ atom->tag[i] = 0; }
+			atom->tag_extend( );
+		}
+
+		LAMMPS_NS::bigint nlocal_big = nlocal;
+		MPI_Allreduce( &nlocal_big , &atom->natoms , 1 , MPI_LMP_BIGINT , MPI_SUM , MPI_COMM_WORLD );
+		resetAtomMap( lmp );
+		if( molecular ){ recountBonds( lmp ); }
+
+		return true;
+
+	}
+
+	const bool createAtomNative( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type ){
+
+		/// Natively inserts an atom in the simulation (equivalent to PAPRECA::createAtom()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom_pos coordinates (x,y, and z) of insertion point.
+		/// @param[in] atom_type type of inserted atom.
+		/// @return true if the atom was inserted, or false if the operation is not supported natively (the system is not modified in that case).
+		/// @note Mirrors the create_atoms LAMMPS command with the single keyword: the atom is created by the MPI process owning the insertion point with zero velocity and charge. No atom is created if the insertion point lies outside the simulation box.
+		/// @note Has to be called by all MPI processes.
+
+		if( !nativeOperationsAreSupported( lmp ) ){ return false; }
+
+		LAMMPS_NS::Atom *atom = lmp->atom;
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		if( atom_type <= 0 || atom_type > atom->ntypes ){ return false; } //Let the create_atoms command report the error.
+
+		//Created atoms overwrite ghost atoms (as in create_atoms)
+		atom->nghost = 0;
+		atom->avec->clear_bonus( );
+
+		const int nlocal_previous = atom->nlocal;
+		double coord[3] = { atom_pos[0] , atom_pos[1] , atom_pos[2] };
+		if( coord[0] >= domain->sublo[0] && coord[0] < domain->subhi[0] && coord[1] >= domain->sublo[1] && coord[1] < domain->subhi[1] && coord[2] >= domain->sublo[2] && coord[2] < domain->subhi[2] ){
+			atom->avec->create_atom( atom_type , coord );
+		}
+
+		LAMMPS_NS::bigint nlocal_big = atom->nlocal;
+		MPI_Allreduce( &nlocal_big , &atom->natoms , 1 , MPI_LMP_BIGINT , MPI_SUM , MPI_COMM_WORLD );
+		atom->tag_extend( );
+		resetAtomMap( lmp );
+		atom->data_fix_compute_variable( nlocal_previous , atom->nlocal );
+
+		return true;
+
+	}
+
+	const bool deleteBondNative( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special ){
+
+		/// Natively deletes all bonds between atom1 and atom2 (equivalent to PAPRECA::deleteBond()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom1id ID of the first atom.
+		/// @param[in] atom2id ID of the second atom.
+		/// @param[in] special if true, the 1-2, 1-3, and 1-4 special lists are re-built after the deletion.
+		/// @return true if the bond was deleted, or false if the operation is not supported natively (the system is not modified in that case).
+		/// @note As in PAPRECA::deleteBond(), no error is produced if there is no bond between the two atoms.
+		/// @note Has to be called by all MPI processes.
+
+		if( !nativeOperationsAreSupported( lmp ) || lmp->atom->molecular != LAMMPS_NS::Atom::MOLECULAR ){ return false; }
+
+		const int iatom1 = getOwnedAtomIndex( lmp , atom1id );
+		const int iatom2 = getOwnedAtomIndex( lmp , atom2id );
+		if( iatom1 != -1 ){ removeBondsOfOwnedAtom( lmp , iatom1 , TAGINT_SET{ atom2id } ); } //With newton_bond on, the bond is only stored by one of the two atoms.
+		if( iatom2 != -1 ){ removeBondsOfOwnedAtom( lmp , iatom2 , TAGINT_SET{ atom1id } ); }
+		recountBonds( lmp );
+
+		if( special ){
+			LAMMPS_NS::Special special_lists( lmp );
+			special_lists.build( );
+		}
+
+		return true;
+
+	}
+
+	const bool formBondNative( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type ){
+
+		/// Natively bonds atom1 and atom2 with a specific bond type (equivalent to PAPRECA::formBond()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom1id ID of the first atom.
+		/// @param[in] atom2id ID of the second atom.
+		/// @param[in] bond_type type of bond to be formed.
+		/// @return true if the bond was formed, or false if the operation is not supported natively (the system is not modified in that case).
+		/// @note Mirrors the create_bonds LAMMPS command with the single/bond keyword: the bond is stored by atom1 (and also by atom2 if newton_bond is off) and the special lists are re-built.
+		/// @note false is also returned if the bond cannot be formed (e.g., missing atoms or too many bonds per atom), so the create_bonds LAMMPS command can report the relevant error.
+		/// @note Has to be called by all MPI processes.
+
+		if( !nativeOperationsAreSupported( lmp ) || lmp->atom->molecular != LAMMPS_NS::Atom::MOLECULAR ){ return false; }
+
+		LAMMPS_NS::Atom *atom = lmp->atom;
+		const bool newton_bond = lmp->force->newton_bond;
+		const int iatom1 = getOwnedAtomIndex( lmp , atom1id );
+		const int iatom2 = getOwnedAtomIndex( lmp , atom2id );
+
+		int checks[3] = { 0 , 0 , 0 }; //Atom1 found, atom2 found, bond arrays full.
+		if( iatom1 != -1 ){
+			checks[0] = 1;
+			if( atom->num_bond[iatom1] == atom->bond_per_atom ){ checks[2] = 1; }
+		}
+		if( iatom2 != -1 ){
+			checks[1] = 1;
+			if( !newton_bond && atom->num_bond[iatom2] == atom->bond_per_atom ){ checks[2] = 1; }
+		}
+		int checks_all[3];
+		MPI_Allreduce( checks , checks_all , 3 , MPI_INT , MPI_SUM , MPI_COMM_WORLD );
+		if( checks_all[0] != 1 || checks_all[1] != 1 || checks_all[2] != 0 || bond_type <= 0 || bond_type > atom->nbondtypes ){ return false; }
+
+		if( iatom1 != -1 ){
+			atom->bond_type[iatom1][atom->num_bond[iatom1]] = bond_type;
+			atom->bond_atom[iatom1][atom->num_bond[iatom1]] = atom2id;
+			++atom->num_bond[iatom1];
+		}
+		if( !newton_bond && iatom2 != -1 ){
+			atom->bond_type[iatom2][atom->num_bond[iatom2]] = bond_type;
+			atom->bond_atom[iatom2][atom->num_bond[iatom2]] = atom1id;
+			++atom->num_bond[iatom2];
+		}
+		++atom->nbonds;
+
+		LAMMPS_NS::Special special_lists( lmp );
+		special_lists.build( );
+
+		return true;
+
+	}
+
+	const bool moveAtomNative( LAMMPS_NS::LAMMPS *lmp , const double end_pos[3] , const double start_pos[3] , const LAMMPS_NS::tagint &atom_id ){
+
+		/// Natively displaces an atom by end_pos - start_pos (equivalent to PAPRECA::moveAtom()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] end_pos final position of atom.
+		/// @param[in] start_pos initial position of atom.
+		/// @param[in] atom_id ID of moving atom.
+		/// @return true if the atom was displaced, or false if the operation is not supported natively (the system is not modified in that case).
+		/// @note Mirrors the displace_atoms LAMMPS command: the displaced atom is remapped inside the periodic box (image flags are updated) and migrated to a new MPI process if it left the sub-domain of its owner. Migration requires an irregular communication, which is skipped if the atom remains in the sub-domain of its owner.
+		/// @note Has to be called by all MPI processes.
+
+		if( !nativeOperationsAreSupported( lmp ) ){ return false; }
+
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		const int iatom = getOwnedAtomIndex( lmp , atom_id );
+		bool atom_left_subdomain = false;
+
+		if( iatom != -1 ){
+
+			double *x = lmp->atom->x[iatom];
+			for( int i = 0; i < 3; ++i ){ x[i] += end_pos[i] - start_pos[i]; }
+			domain->remap( x , lmp->atom->image[iatom] );
+
+			for( int i = 0; i < 3; ++i ){
+				if( x[i] < domain->sublo[i] || x[i] >= domain->subhi[i] ){ atom_left_subdomain = true; }
+			}
+
+		}
+
+		if( !allProcsAgree( !atom_left_subdomain ) ){
+			LAMMPS_NS::Irregular irregular( lmp );
+			irregular.migrate_atoms( 1 );
+		}
+
+		return true;
+
+	}
+
+	//Neighbor lists
+	const bool rebuildNeighborListsNative( LAMMPS_NS::LAMMPS *lmp ){
+
+		/// Re-creates ghost atoms and rebuilds the LAMMPS neighbor lists without evaluating forces (i.e., the neighbor-related part of the setup performed by a run 0 command).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @return true if the neighbor lists were rebuilt, or false if LAMMPS has to be fully re-initialized (i.e., through a run 0 command).
+		/// @note Has to be called by all MPI processes.
+		/// @note Only valid if no fixes/computes were added or removed and the simulation box was not changed since the last LAMMPS run. Otherwise, the per-fix lists of the LAMMPS Modify class and the neighbor bins are outdated.
+		/// @see PAPRECA::refreshLammps()
+
+		if( !nativeOperationsAreSupported( lmp ) ){ return false; }
+		if( !lmp->update->first_update || !lmp->neighbor->style ){ return false; } //LAMMPS was never initialized (i.e., no run was performed yet).
+
+		lmp->update->setupflag = 1;
+		lmp->modify->setup_pre_exchange( );
+		lmp->domain->pbc( );
+		lmp->domain->reset_box( );
+		lmp->comm->setup( );
+		lmp->neighbor->setup_bins( );
+		lmp->comm->exchange( );
+		lmp->comm->borders( ); //Also re-creates the atom map (global atom ID to local index) for owned and ghost atoms.
+		lmp->domain->image_check( );
+		lmp->domain->box_too_small_check( );
+		lmp->modify->setup_pre_neighbor( );
+		lmp->neighbor->build( 1 );
+		lmp->modify->setup_post_neighbor( );
+		lmp->neighbor->ncalls = 0;
+		lmp->update->setupflag = 0;
+
+		return true;
+
+	}
+
+	//Groups
+	const bool setNveLimitedGroupNative( LAMMPS_NS::LAMMPS *lmp , const TAGINT_VEC &atom_ids ){
+
+		/// Redefines the nve_limited group so it only contains the (non-frozen) atoms in atom_ids, and removes those atoms from the fluid group. The group bits of the atoms are set directly in the LAMMPS mask array (i.e., equivalent to PAPRECA::resetMobileAtomsGroups4NveLimIntegration() but without group commands and without an ID string).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] atom_ids IDs of atoms to be integrated via nve/limit (identical on all MPI processes). Duplicate IDs are allowed.
+		/// @return true if the groups were modified, or false if there is no atom map or any of the nve_limited, fluid, and frozen groups is not defined.
+		/// @note Has to be called by all MPI processes. Each MPI process only modifies its owned atoms (ghost atoms get the masks of their owners on the next LAMMPS run).
+		/// @note The fluid group is expected to contain all fluid atoms (see PAPRECA::resetMobileAtomsGroups()).
+
+		if( lmp->atom->map_style == LAMMPS_NS::Atom::MAP_NONE ){ return false; }
+
+		const int igroup_nvelim = lmp->group->find( "nve_limited" );
+		const int igroup_fluid = lmp->group->find( "fluid" );
+		const int igroup_frozen = lmp->group->find( "frozen" );
+		if( igroup_nvelim == -1 || igroup_fluid == -1 || igroup_frozen == -1 ){ return false; }
+
+		const int nvelim_bit = lmp->group->bitmask[igroup_nvelim];
+		const int fluid_bit = lmp->group->bitmask[igroup_fluid];
+		const int frozen_bit = lmp->group->bitmask[igroup_frozen];
+		int *mask = lmp->atom->mask;
+
+		clearGroupNative( lmp , "nve_limited" );
+		for( const auto &atom_id : atom_ids ){
+
+			const int iatom = getOwnedAtomIndex( lmp , atom_id );
+			if( iatom < 0 || ( mask[iatom] & frozen_bit ) ){ continue; } //Frozen atoms can be collected through recursive bonded atoms collection.
+			mask[iatom] |= nvelim_bit;
+			mask[iatom] &= ~fluid_bit;
+		}
+
+		return true;
+
+	}
+
+	const bool clearGroupNative( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name ){
+
+		/// Removes all (owned and ghost) atoms from a LAMMPS group by clearing the group bit in the LAMMPS mask array (i.e., equivalent to the group clear command).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] group_name name of LAMMPS group.
+		/// @return true if the group was cleared, or false if the group is not defined.
+		/// @note Has to be called by all MPI processes.
+
+		const int igroup = lmp->group->find( group_name );
+		if( igroup == -1 ){ return false; }
+
+		const int inverse_bit = ~lmp->group->bitmask[igroup];
+		int *mask = lmp->atom->mask;
+		const int nall = lmp->atom->nlocal + lmp->atom->nghost;
+		for( int i = 0; i < nall; ++i ){ mask[i] &= inverse_bit; }
+
+		return true;
+
+	}
+
+	const bool resetFluidGroupNative( LAMMPS_NS::LAMMPS *lmp , const std::vector< int > &fluid_atomtypes ){
+
+		/// Natively redefines the fluid group so it contains exactly the atoms of fluid types (equivalent to PAPRECA::resetMobileAtomsGroups(), i.e., the group clear and group type commands).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] fluid_atomtypes fluid atom types (as defined in the PAPRECA input file).
+		/// @return true if the fluid group was redefined, or false if the fluid group is not defined.
+		/// @note Has to be called by all MPI processes. No communication is required, since group bits are stored per atom.
+
+		const int igroup = lmp->group->find( "fluid" );
+		if( igroup == -1 ){ return false; }
+
+		std::vector< char > type_is_fluid( lmp->atom->ntypes + 1 , 0 );
+		for( const auto &type : fluid_atomtypes ){
+			if( type > 0 && type <= lmp->atom->ntypes ){ type_is_fluid[type] = 1; }
+		}
+
+		const int fluid_bit = lmp->group->bitmask[igroup];
+		int *mask = lmp->atom->mask;
+		int *type = lmp->atom->type;
+		const int nall = lmp->atom->nlocal + lmp->atom->nghost;
+		for( int i = 0; i < nall; ++i ){
+			if( type_is_fluid[type[i]] ){
+				mask[i] |= fluid_bit;
+			}else{
+				mask[i] &= ~fluid_bit;
+			}
+		}
+
+		return true;
+
+	}
+
+	const bool initCreatedAtomsNative( LAMMPS_NS::LAMMPS *lmp , const int &first_created , const std::vector< int > &fluid_atomtypes , const double &insertion_vel ){
+
+		/// Natively adds the atoms created by an executed event to the fluid group (only atoms of fluid types) and sets their vertical velocity to insertion_vel (in box units).
+		/// This replaces the temporary group (e.g., new_mol or new_atom) and velocity commands, and the reset of the fluid group that follow insertions with velocity (see PAPRECA::executeDeposition() and PAPRECA::executeDiffusion()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] first_created number of owned atoms right before the insertion. Created atoms are appended to the per-atom arrays (by the create_atoms command and by PAPRECA::createAtomNative()), so all owned atoms with local index >= first_created are new.
+		/// @param[in] fluid_atomtypes fluid atom types (as defined in the PAPRECA input file).
+		/// @param[in] insertion_vel velocity along the z-direction (in LAMMPS velocity units).
+		/// @return true if the created atoms were initialized, or false if the fluid group is not defined or first_created is not a valid local index.
+		/// @note Has to be called by all MPI processes. The return value is identical on all MPI processes.
+		/// @note Atoms of the created molecule/atom that are not of fluid type are not added to any group (as with the resetMobileAtomsGroups() function).
+
+		const int igroup = lmp->group->find( "fluid" );
+		if( !allProcsAgree( igroup != -1 && first_created >= 0 && first_created <= lmp->atom->nlocal ) ){ return false; }
+
+		const int fluid_bit = lmp->group->bitmask[igroup];
+		int *mask = lmp->atom->mask;
+		int *type = lmp->atom->type;
+		double **v = lmp->atom->v;
+		for( int i = first_created; i < lmp->atom->nlocal; ++i ){
+			if( std::find( fluid_atomtypes.begin( ) , fluid_atomtypes.end( ) , type[i] ) != fluid_atomtypes.end( ) ){ mask[i] |= fluid_bit; }
+			v[i][2] = insertion_vel;
+		}
+
+		return true;
+
+	}
+
+}//end of namespace PAPRECA
@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Declarations for native LAMMPS operations.
+///
+/// Functions that modify the LAMMPS system directly through the LAMMPS class APIs (i.e., Atom, AtomVec, Domain), without parsing LAMMPS input commands.
+/// Every function returns false (without modifying the system) if the operation is not supported natively. In that case, the caller should fall back to the equivalent LAMMPS input command (see lammps_wrappers.h).
+
+#ifndef LAMMPS_NATIVE_H
+#define LAMMPS_NATIVE_H
+
+//System Headers
+#include <string>
+#include <mpi.h>
+#include <unordered_set>
+#include <vector>
+#include <algorithm>
+
+//LAMMPS headers
+#include "lammps.h"
+/// \cond
+#include "atom.h"
+#include "atom_vec.h"
+#include "domain.h"
+#include "force.h"
+#include "irregular.h"
+#include "special.h"
+#include "comm.h"
+#include "modify.h"
+#include "neighbor.h"
+#include "update.h"
+#include "group.h"
+/// \endcond
+
+//kMC Headers
+#include "papreca_error.h"
+#include "utilities.h"
+
+
+namespace PAPRECA{
+
+	//Helpers
+	const bool nativeOperationsAreSupported( LAMMPS_NS::LAMMPS *lmp );
+	const bool allProcsAgree( const bool &local_flag );
+	const int getOwnedAtomIndex( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom_id );
+	void resetAtomMap( LAMMPS_NS::LAMMPS *lmp );
+	void recountBonds( LAMMPS_NS::LAMMPS *lmp );
+	void removeBondsOfOwnedAtom( LAMMPS_NS::LAMMPS *lmp , const int &iatom , const TAGINT_SET &bond_atom_ids );
+
+	//kMC operations
+	const bool deleteAtomsNative( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule );
+	const bool createAtomNative( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type );
+	const bool deleteBondNative( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special );
+	const bool formBondNative( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type );
+	const bool moveAtomNative( LAMMPS_NS::LAMMPS *lmp , const double end_pos[3] , const double start_pos[3] , const LAMMPS_NS::tagint &atom_id );
+
+	//Neighbor lists
+	const bool rebuildNeighborListsNative( LAMMPS_NS::LAMMPS *lmp );
+
+	//Groups
+	const bool setNveLimitedGroupNative( LAMMPS_NS::LAMMPS *lmp , const TAGINT_VEC &atom_ids );
+	const bool clearGroupNative( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name );
+	const bool resetFluidGroupNative( LAMMPS_NS::LAMMPS *lmp , const std::vector< int > &fluid_atomtypes );
+	const bool initCreatedAtomsNative( LAMMPS_NS::LAMMPS *lmp , const int &first_created , const std::vector< int > &fluid_atomtypes , const double &insertion_vel );
+
+}//end of namespace PAPRECA
+
+
+#endif
@@ -22,6 +22,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "lammps_wrappers.h"
 
+//Vectorization hint for the batched minimum image loop (see MinImageBatch::compute()). Plain loop if PAPRECA is compiled without OpenMP.
+#ifdef _OPENMP
+#define PAPRECA_SIMD _Pragma( "omp simd" )
+#else
+#define PAPRECA_SIMD
+#endif
+
 namespace PAPRECA{
 
 	///Initialize LAMMPS
@@ -54,6 +61,7 @@ namespace PAPRECA{
 		std::string input_str = "fix nve_limited_integration nve_limited nve/limit ";
 		input_str += std::to_string( papreca_config.getNveLimDist( ) );
 		lmp->input->one( input_str.c_str( ) );
+		papreca_config.setLammpsInitRequired( ); //Fixes were modified so LAMMPS has to be re-initialized before the next neighbor lists rebuild.
 			
 		
 	}
@@ -65,6 +73,7 @@ namespace PAPRECA{
 		/// @param[in] papreca_config configuration variable including basic simulation information. Used to retrieved the IDs of fluid atoms.
 		
 		lmp->input->one( "unfix nve_limited_integration");
+		papreca_config.setLammpsInitRequired( );
 		
 	}
 	
@@ -83,6 +92,87 @@ namespace PAPRECA{
 		
 	}
 	
+	void runLammpsChunk( LAMMPS_NS::LAMMPS *lmp , const int &timesteps_num , const bool &first_chunk ){
+		
+		/// Runs a chunk of a LAMMPS trajectory that is split in multiple runs (see PAPRECA::runAdaptiveTrajectory()).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] timesteps_num number of timesteps to execute.
+		/// @param[in] first_chunk true for the first chunk of the trajectory. The LAMMPS setup is skipped on all other chunks, since the system is not modified between chunks.
+		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/run.html (with the pre and post keywords).
+		
+		if( timesteps_num < 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Attempted to run trajectory chunk with " + std::to_string( timesteps_num ) + " steps." ); }
+		std::string input_str = "run " + std::to_string( timesteps_num ) + ( first_chunk ? " post no" : " pre no post no" );
+		lmp->input->one( input_str.c_str( ) );
+		
+	}
+	
+	double getPotentialEnergy( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Retrieves the total potential energy of the system from a LAMMPS equal-style variable.
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @return total potential energy (in LAMMPS energy units).
+		/// @note Has to be called right after a LAMMPS run, since the potential energy is only tallied on thermo output timesteps (i.e., always on the last timestep of a run).
+		
+		std::string var_name = "papreca_pe";
+		std::string command = "variable " + var_name + " equal pe";
+		lmp->input->one( command.c_str( ) );
+		int id_pe = lmp->input->variable->find( var_name.c_str( ) );
+		double pe = lmp->input->variable->compute_equal( id_pe );
+		
+		command = "variable " + var_name + " delete";
+		lmp->input->one( command.c_str( ) );
+		
+		return pe;
+		
+	}
+	
+	double getMaxForceInGroup( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name ){
+		
+		/// Calculates the maximum force magnitude on the atoms of a LAMMPS group.
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] group_name name of LAMMPS group.
+		/// @return maximum force magnitude (in LAMMPS force units) on all MPI processes, or 0 if the group is empty.
+		/// @note Forces are only up to date right after a LAMMPS run.
+		
+		const int igroup = lmp->group->find( group_name );
+		if( igroup == -1 ){ allAbortWithMessage( MPI_COMM_WORLD , "Could not find group " + group_name + " in getMaxForceInGroup function (lammps_wrappers.cpp)." ); }
+		const int groupbit = lmp->group->bitmask[igroup];
+		
+		double **atom_f = lmp->atom->f;
+		int *atom_mask = lmp->atom->mask;
+		const int nlocal = lmp->atom->nlocal;
+		
+		double fmax_sqr_local = 0.0;
+		for( int i = 0; i < nlocal; ++i ){
+			if( !( atom_mask[i] & groupbit ) ){ continue; }
+			const double f_sqr = atom_f[i][0] * atom_f[i][0] + atom_f[i][1] * atom_f[i][1] + atom_f[i][2] * atom_f[i][2];
+			if( f_sqr > fmax_sqr_local ){ fmax_sqr_local = f_sqr; }
+		}
+		
+		double fmax_sqr;
+		MPI_Allreduce( &fmax_sqr_local , &fmax_sqr , 1 , MPI_DOUBLE , MPI_MAX , MPI_COMM_WORLD );
+		
+		return sqrt( fmax_sqr );
+		
+	}
+	
+	void refreshLammps( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config ){
+		
+		/// Refreshes the ghost atoms, atom map, and neighbor lists of LAMMPS, but only if the LAMMPS system changed since the last refresh. If only atoms/bonds changed, the neighbor lists are rebuilt without evaluating forces (see PAPRECA::rebuildNeighborListsNative()). A full LAMMPS setup (i.e., run 0) is only performed if fixes were added/removed, the simulation box changed, or the neighbor lists cannot be rebuilt natively.
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in,out] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @see PAPRECA::PaprecaConfig::lammpsSetupIsOutdated(), PAPRECA::PaprecaConfig::lammpsInitIsRequired()
+		/// @note Has to be called by all MPI processes. Functions modifying the LAMMPS system outside of a LAMMPS run have to call PAPRECA::PaprecaConfig::setLammpsSystemModified().
+		
+		if( !papreca_config.lammpsSetupIsOutdated( lmp ) ){ return; } //Nothing changed since the last refresh so the neighbor lists are still valid.
+		
+		if( papreca_config.lammpsInitIsRequired( lmp ) || !rebuildNeighborListsNative( lmp ) ){
+			runLammps( lmp , 0 );
+		}
+		papreca_config.saveLammpsSetupState( lmp );
+		
+	}
+	
 	//Simulation Box Operations
 	void resizeZboxLength( LAMMPS_NS::LAMMPS *lmp , double &box_zlow , double &box_zhigh ){
 		/// Resizes the simulation box along the z-dimension.
@@ -164,6 +254,33 @@ namespace PAPRECA{
 		
 	}
 	
+	void resetMobileAtomsGroups4LocalRelaxation( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , std::vector< LAMMPS_NS::tagint > &relax_ids ){
+		
+		/// Redefines the "fluid" group so it only contains the fluid atoms in relax_ids (and, for molecular systems, the fluid atoms of the same molecules).
+		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] papreca_config configuration variable including basic simulation information. Used to retrieved the IDs of fluid atoms.
+		/// @param[in] relax_ids IDs of atoms to be integrated (identical on all MPI processes). Non-fluid atoms are discarded.
+		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/group.html.
+		/// @note The fluid group is left empty if relax_ids is empty. Call PAPRECA::resetMobileAtomsGroups() after the run to integrate all fluid atoms again.
+		/// @see PAPRECA::equilibrateFluidAtoms()
+		
+		lmp->input->one( "group fluid clear" );
+		if( relax_ids.empty( ) ){ return; }
+		
+		std::string input_str1 = "group relax_temp id ";
+		for( const auto &id : relax_ids ){ input_str1 += std::to_string( id ) + " "; }
+		lmp->input->one( input_str1.c_str( ) );
+		if( lmp->atom->molecule_flag ){ lmp->input->one( "group relax_temp include molecule" ); } //Avoid integrating only a part of a molecule
+		
+		std::string input_str2 = "group fluid_temp type ";
+		for( auto &type : papreca_config.getFluidAtomTypes( ) ){ input_str2 += std::to_string( type ) + " "; }
+		lmp->input->one( input_str2.c_str( ) );
+		lmp->input->one( "group fluid intersect fluid_temp relax_temp" );
+		lmp->input->one( "group fluid_temp delete" );
+		lmp->input->one( "group relax_temp delete" );
+		
+	}
+	
 	void resetMobileAtomsGroups( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config ){
 		
 		/// Clears the fluid group (containing the fluid atom types, as defined in the PAPRECA input file) and redefines it to. This ensures that all atoms of fluid types are included in the fluid group.
@@ -171,7 +288,10 @@ namespace PAPRECA{
 		/// @param[in] papreca_config configuration variable including basic simulation information. Used to retrieved the IDs of fluid atoms.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/group.html.
 		/// @note This operation is necessary each time you add/remove atoms. This ensures that the correct group of atoms will keep moving in the simulation.
+		/// @note If native_execution is active, the group bits are set directly (see PAPRECA::resetFluidGroupNative()).
 	
+		if( papreca_config.nativeExecutionIsActive( ) && resetFluidGroupNative( lmp , papreca_config.getFluidAtomTypes( ) ) ){ return; }
+		
 		lmp->input->one( "group fluid clear" );
 		std::string input_str1 = "group fluid type ";
 		for( auto &type : papreca_config.getFluidAtomTypes( ) ){ input_str1 += std::to_string( type ) + " "; }
@@ -180,7 +300,7 @@ namespace PAPRECA{
 		
 	}
 	
-	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule ){
+	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule , const bool native ){
 
 		/// Receives an array of atom IDs (atom_ids) and deletes all atoms in the simulation with the corresponding IDs.
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
@@ -188,11 +308,13 @@ namespace PAPRECA{
 		/// @param[in] num_atoms number of atoms to be deleted (length of atom_ids vector).
 		/// @param[in] delete_bonds if "yes", then the LAMMPS delete_atoms command is called with the "bond yes" keyword.
 		/// @param[in] delete_molecule if "yes", then the LAMMPS delete atoms command is called with the "mol yes" option.
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::deleteAtomsNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/delete_atoms.html.
 		/// @note This function uses a dummy group named "deletion" to delete atoms. You should NOT use a group with the same name in your LAMMPS input file.
 		
 		if( delete_bonds != "yes" && delete_bonds != "no" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown delete_bonds option: " + delete_bonds + " for deleteAtoms function in lammps_wrappers.cpp." ); }
 		if( delete_molecule != "yes" && delete_molecule != "no" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown delete_molecule option: " + delete_molecule + " for deleteAtoms function in lammps_wrappers.cpp." ); }
+		if( native && deleteAtomsNative( lmp , atom_ids , num_atoms , delete_bonds , delete_molecule ) ){ return; }
 		
 		//Insert all atoms to be deleted in the same group
 		std::string input_str = "group deletion id ";
@@ -212,18 +334,20 @@ namespace PAPRECA{
 
 	}
 	
-	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , std::vector< LAMMPS_NS::tagint > &atom_ids , const std::string &delete_bonds , const std::string &delete_molecule ){
+	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , std::vector< LAMMPS_NS::tagint > &atom_ids , const std::string &delete_bonds , const std::string &delete_molecule , const bool native ){
 		
 		/// Receives a vector of atom IDs and deletes all atoms in the simulation with the corresponding IDs.
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
 		/// @param[in] atom_ids std::vector of IDs of atoms to be deleted.
 		/// @param[in] delete_bonds if "yes", then the LAMMPS delete_atoms command is called with the "bond yes" keyword.
 		/// @param[in] delete_molecule if "yes", then the LAMMPS delete atoms command is called with the "mol yes" option.
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::deleteAtomsNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/delete_atoms.html.
 		/// @note This function uses a dummy group named "deletion" to delete atoms. You should NOT use a group with the same name in your LAMMPS input file.
 		
 		if( delete_bonds != "yes" && delete_bonds != "no" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown delete_bonds option: " + delete_bonds + " for deleteAtoms function in lammps_wrappers.cpp." ); }
 		if( delete_molecule != "yes" && delete_molecule != "no" ){ allAbortWithMessage( MPI_COMM_WORLD , "Unknown delete_molecule option: " + delete_molecule + " for deleteAtoms function in lammps_wrappers.cpp." ); }
+		if( native && deleteAtomsNative( lmp , atom_ids.data( ) , static_cast< int >( atom_ids.size( ) ) , delete_bonds , delete_molecule ) ){ return; }
 		
 		//Insert all atoms to be deleted in the same group
 		std::string input_str = "group deletion id ";
@@ -272,29 +396,33 @@ namespace PAPRECA{
 		lmp->input->one( "region del_region delete" ); //Delete region for later use of the "del_region" keyword.
 	}
 	
-	void createAtom( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type ){
+	void createAtom( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type , const bool native ){
 		
 		/// Inserts an atom in the simulation.
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
 		/// @param[in] atom_pos coordinates (x,y, and z) of insertion point.
 		/// @param[in] atom_type type of insert atom
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::createAtomNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/create_atoms.html
 		/// @note CAREFUL: Currently, the inserted atom has zero velocity and charges!
 		/// @note CAREFUL: LAMMPS will NOT create the atom if it lies exactly at or outside the periodic box! %PAPRECA uses other functions to remap coordinates inside the periodic box (e.g., PAPRECA::remap3DArrayInPeriodicBox).
 		
+		if( native && createAtomNative( lmp , atom_pos , atom_type ) ){ return; }
+		
 		std::string input_str = "create_atoms " + std::to_string( atom_type ) + " single " + std::to_string( atom_pos[0] )+ " " + std::to_string( atom_pos[1] )+ " " + std::to_string( atom_pos[2] ) + " units box";
 		lmp->input->one( input_str.c_str( ) );
 		
 		
 	}
 	
-	void deleteBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special ){
+	void deleteBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special , const bool native ){
 	
 		/// Deletes an existing bond between atom1 and atom2.
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
 		/// @param[in] atom1id ID of the first atom.
 		/// @param[in] atom2id ID of the second atom.
 		/// @param[in] special if true, then the delete_bonds LAMMPS command is called with the "special" keyword.
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::deleteBondNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/delete_bonds.html
 		/// @note The delete_bonds command in LAMMPS deletes ALL bonds of a specific type between 2 atoms
 		/// Hence, to delete one specific bond, we temporarily move the bond to a dummy bond type group and then invoke the delete_bonds command
@@ -303,6 +431,8 @@ namespace PAPRECA{
 		/// @note If an bond does not exist between the 2 atoms, LAMMPS will not throw an error! This happens because the bond deletion group will be empty by the time the delete_bonds command is called.
 		/// @note This function uses a dummy group named bonddel to delete atoms. Do not define another group with the same name in your LAMMPS input file.
 		
+		if( native && deleteBondNative( lmp , atom1id , atom2id , special ) ){ return; }
+		
 		std::string input_str = "group bonddel id " + std::to_string( atom1id ) + " " + std::to_string( atom2id ); //place atoms on the same bonddel group (via concentrating strings)
 		lmp->input->one( input_str.c_str( ) );
 		
@@ -319,15 +449,18 @@ namespace PAPRECA{
 		
 	}
 	
-	void formBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type ){
+	void formBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type , const bool native ){
 		
 		/// Bonds atom1 and atom2 with a specific bond type (as defined in the LAMMPS input file).
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
 		/// @param[in] atom1id ID of the first atom.
 		/// @param[in] atom2id ID of the second atom.
 		/// @param[in] bond_type type of bond to be formed.
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::formBondNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/create_bonds.html
 		
+		if( native && formBondNative( lmp , atom1id , atom2id , bond_type ) ){ return; }
+		
 		std::string input_str = "create_bonds single/bond " + std::to_string( bond_type ) + " " + std::to_string( atom1id ) + " " + std::to_string( atom2id );
 		lmp->input->one( input_str.c_str( ) );
 
@@ -358,15 +491,18 @@ namespace PAPRECA{
 		
 	}
 	
-	void moveAtom( LAMMPS_NS::LAMMPS *lmp , const double end_pos[3] , const double start_pos[3] , const LAMMPS_NS::tagint &atom_id ){
+	void moveAtom( LAMMPS_NS::LAMMPS *lmp , const double end_pos[3] , const double start_pos[3] , const LAMMPS_NS::tagint &atom_id , const bool native ){
 		
 		/// Moves atom specified by an ID to move_pos
 		/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
 		/// @param[in] end_pos final position of atom
 		/// @param[in] start_pos initial position of atom
 		/// @param[in] atom_id id of moving atom
+		/// @param[in] native if true, the operation is first attempted natively (see PAPRECA::moveAtomNative()). The LAMMPS command is only used if the operation is not supported natively.
 		/// @note This function is a wrapper of this LAMMPS command: https://docs.lammps.org/displace_atoms.html. This command automatically handles  periodic boundaries, increments periodic images, and resizes boxes, so it is safer than set. However, it needs you to calculate an additional distance, so might be slower than the other methods (needs to be tested further).
 		
+		if( native && moveAtomNative( lmp , end_pos , start_pos , atom_id ) ){ return; }
+		
 		double dist[3];
 		
 		//Fill dist array from differences in coordinates
@@ -389,7 +525,7 @@ namespace PAPRECA{
 	}
 		
 	
-	void diffuseAtom( LAMMPS_NS::LAMMPS *lmp , const double vac_pos[3] , const double parent_pos[3] , const LAMMPS_NS::tagint &parent_id , const int &parent_type , const std::string &diffusion_style , const int &diffused_type ){
+	const int diffuseAtom( LAMMPS_NS::LAMMPS *lmp , const double vac_pos[3] , const double parent_pos[3] , const LAMMPS_NS::tagint &parent_id , const int &parent_type , const std::string &diffusion_style , const int &diffused_type , const bool native ){
 			
 			/// Executes a diffusion operation based on diffusion style.
 			/// @param[in,out] lmp pointer to previously instantiated LAMMPS object.
@@ -399,6 +535,8 @@ namespace PAPRECA{
 			/// @param[in] parent_type atom type of parent candidate atom.
 			/// @param[in] diffusion_style string denoting the diffusion style: moves atom if style is "move", deletes parent atom and moves atom to vacancy if style is "move_del", or creates a new atom a the vacancy site for style "spawn".
 			/// @param[in] diffused_type type of diffused atom. Can be the same as parent type or can be set to a different type if you wish to change the atom type after performing a diffusion event. For style "move" the diffused type must be the same as the parent type
+			/// @param[in] native if true, the atoms are created/deleted/moved natively when possible (see lammps_native.h).
+			/// @return number of owned atoms right before the creation of the diffused atom (i.e., owned atoms with local index >= the returned value were created by the diffusion). For diffusion style "move", no atoms are created and the current number of owned atoms is returned.
 			/// @see createAtom(), deleteAtoms()
 			/// @note If diffusion style is "move_del", the original atom is deleted and a new atom is inserted at the vacancy site.
 			/// This approximation introduces an error: it assumes that the charge of the atom becomes zero during diffusion (because the new atom is inserted with 0 charge).
@@ -407,27 +545,33 @@ namespace PAPRECA{
 			/// @note If diffusion style is "spawn", we create a new atom in the vacancy position instead of moving the parent atom.
 			/// Again, we assume that the charge of the atom is 0 to begin with.
 			
+			int first_created;
 			if( diffusion_style == "spawn" ){ //Now we simply create an atom at the vacancy pos
-				createAtom( lmp , vac_pos , diffused_type );
+				first_created = lmp->atom->nlocal;
+				createAtom( lmp , vac_pos , diffused_type , native );
 				
 			}else if( diffusion_style == "move_del" ){
 				
 				LAMMPS_NS::tagint *ids = new LAMMPS_NS::tagint[1];
 				ids[0] = parent_id;
 				
-				deleteAtoms( lmp , ids , 1 , "yes" , "no" );
-				createAtom( lmp , vac_pos , diffused_type );
+				deleteAtoms( lmp , ids , 1 , "yes" , "no" , native );
+				first_created = lmp->atom->nlocal; //Deletions re-order the owned atoms, so the count is taken after the deletion
+				createAtom( lmp , vac_pos , diffused_type , native );
 				
 				delete [ ] ids;
 	
 			}else if( diffusion_style == "move" ){
 				
-				moveAtom( lmp , vac_pos , parent_pos , parent_id );
+				moveAtom( lmp , vac_pos , parent_pos , parent_id , native );
+				first_created = lmp->atom->nlocal;
 				
 			}else{	
 				allAbortWithMessage( MPI_COMM_WORLD , "Unknown diffusion style " + diffusion_style + " in diffuseAtom function of lammps_wrappers.cpp." );
 			}
 			
+			return first_created;
+			
 	}
 	
 	//Sigmas
@@ -494,7 +638,7 @@ namespace PAPRECA{
 		/// @param[in] lmp pointer to LAMMPS object.
 		/// @param[in,out] bonds_list array containing the IDs of bonds.
 		/// @param[in,out] bonds_num number of bonds in the bonds_list array.
-		/// @see PAPRECA::Bond::fillAtomID2BondsContainer(), PAPRECA::Bond::addBond2BondVector(), PAPRECA::Bond::atomIDIsMapped(), PAPRECA::Bond::initAtomID2BondsMap()
+		/// @see PAPRECA::BondGraph::buildFromBondsList(), PAPRECA::Bond::initAtomID2BondsMap()
 		/// @note See LAMMPS documentation (https://docs.lammps.org/) for more information about lammps_gather_bonds.
 		
 		bonds_num = *( LAMMPS_NS::tagint *)lammps_extract_global( lmp , "nbonds" );
@@ -576,4 +720,135 @@ namespace PAPRECA{
 	}
 	
 
+	void get3DMinImageDisplacement( LAMMPS_NS::LAMMPS *lmp , const double *x1 , const double *x2 , double *dist ){
+		
+		/// Calculates the minimum image displacement vector (x1-x2) between 2 points. Orthogonal boxes are handled inline (without the string/line arguments of LAMMPS_NS::Domain::minimum_image()), as this function is called in the innermost loops of collision checks.
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] x1 array of coordinates of point1.
+		/// @param[in] x2 array of coordinates of point2.
+		/// @param[out] dist minimum image displacement vector from point2 to point1.
+		/// @see PAPRECA::get3DSqrDistWithPBC()
+		
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		
+		for( int k = 0; k < 3; ++k ){ dist[k] = x1[k] - x2[k]; }
+		
+		if( domain->triclinic ){
+			
+			domain->minimum_image( "get3DMinImageDisplacement func in lammps_wrappers.cpp of PAPRECA namespace" , 0 , dist[0] , dist[1] , dist[2] );
+			return;
+			
+		}
+		
+		for( int k = 0; k < 3; ++k ){
+			
+			if( domain->periodicity[k] ){
+				
+				while( std::fabs( dist[k] ) > domain->prd_half[k] ){ dist[k] += ( dist[k] < 0.0 ? domain->prd[k] : -domain->prd[k] ); }
+				
+			}
+			
+		}
+		
+	}
+	
+	const bool radiusFitsInPeriodicBox( LAMMPS_NS::LAMMPS *lmp , const double &radius ){
+		
+		/// Checks if a radius is smaller than half of the box along every periodic direction. In that case, at most one periodic image of a point lies within radius of any other point (i.e., the minimum image).
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] radius sphere radius.
+		/// @return true if the sphere fits in the periodic box, false otherwise (or if the box is triclinic).
+		
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		if( domain->triclinic ){ return false; }
+		
+		for( int k = 0; k < 3; ++k ){
+			
+			if( domain->periodicity[k] && radius >= domain->prd_half[k] ){ return false; }
+			
+		}
+		
+		return true;
+		
+	}
+	
+	//MinImageBatch
+	MinImageBatch::MinImageBatch( ){ }
+	MinImageBatch::~MinImageBatch( ){ }
+	
+	void MinImageBatch::compute( LAMMPS_NS::LAMMPS *lmp , const double *x0 , double **atom_xyz , int *neighbors , const int &neighbors_num ){
+		
+		/// Calculates the minimum image displacements (atom minus x0) and squared distances between point x0 and all atoms in a neighbor list.
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @param[in] x0 coordinates of the reference point.
+		/// @param[in] atom_xyz LAMMPS atom coordinates.
+		/// @param[in] neighbors array of (masked) neighbor indexes.
+		/// @param[in] neighbors_num number of neighbors.
+		/// @note Displacements are shifted by the nearest integer number of box lengths along each periodic direction (z first, then y, then x for triclinic boxes). This is equivalent to LAMMPS_NS::Domain::minimum_image() (apart from displacements of exactly half a box length, whose distances are identical anyway). Non-periodic directions get zero inverse lengths, so no shift is applied and the loop stays branch-free.
+		/// @see PAPRECA::get3DMinImageDisplacement()
+		
+		size = neighbors_num;
+		if( dx.size( ) < static_cast< size_t >( size ) ){
+			dx.resize( size );
+			dy.resize( size );
+			dz.resize( size );
+			sqr_dists.resize( size );
+		}
+		
+		//Gather (indirect loads cannot be vectorized efficiently, so this is a separate loop)
+		for( int i = 0; i < size; ++i ){
+			
+			const double *neib_xyz = atom_xyz[neighbors[i] & NEIGHMASK];
+			dx[i] = neib_xyz[0] - x0[0];
+			dy[i] = neib_xyz[1] - x0[1];
+			dz[i] = neib_xyz[2] - x0[2];
+			
+		}
+		
+		//Box lengths, inverse lengths, and tilts (zero along non-periodic directions and for orthogonal boxes)
+		LAMMPS_NS::Domain *domain = lmp->domain;
+		double prd[3] , prd_inv[3];
+		for( int k = 0; k < 3; ++k ){
+			prd[k] = domain->periodicity[k] ? domain->prd[k] : 0.0;
+			prd_inv[k] = domain->periodicity[k] ? 1.0 / domain->prd[k] : 0.0;
+		}
+		const double xy = ( domain->triclinic && domain->periodicity[1] ) ? domain->xy : 0.0;
+		const double xz = ( domain->triclinic && domain->periodicity[2] ) ? domain->xz : 0.0;
+		const double yz = ( domain->triclinic && domain->periodicity[2] ) ? domain->yz : 0.0;
+		
+		double *bdx = dx.data( ) , *bdy = dy.data( ) , *bdz = dz.data( ) , *bsqr_dists = sqr_dists.data( );
+		
+		PAPRECA_SIMD
+		for( int i = 0; i < size; ++i ){
+			
+			double ddx = bdx[i] , ddy = bdy[i] , ddz = bdz[i];
+			
+			const double nz = std::nearbyint( ddz * prd_inv[2] );
+			ddz -= nz * prd[2];
+			ddy -= nz * yz;
+			ddx -= nz * xz;
+			
+			const double ny = std::nearbyint( ddy * prd_inv[1] );
+			ddy -= ny * prd[1];
+			ddx -= ny * xy;
+			
+			const double nx = std::nearbyint( ddx * prd_inv[0] );
+			ddx -= nx * prd[0];
+			
+			bdx[i] = ddx;
+			bdy[i] = ddy;
+			bdz[i] = ddz;
+			bsqr_dists[i] = ddx * ddx + ddy * ddy + ddz * ddz;
+			
+		}
+		
+	}
+	
+	const int &MinImageBatch::getSize( ) const{ return size; }
+	const double *MinImageBatch::getDx( ) const{ return dx.data( ); }
+	const double *MinImageBatch::getDy( ) const{ return dy.data( ); }
+	const double *MinImageBatch::getDz( ) const{ return dz.data( ); }
+	const double *MinImageBatch::getSqrDists( ) const{ return sqr_dists.data( ); }
+	
+
 }//end of namespace PAPRECA
@@ -47,12 +47,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "force.h"
 #include "pair.h"
 #include "variable.h"
+#include "group.h"
 /// \endcond
 
 //kMC Headers
 #include "papreca_config.h"
 #include "papreca_error.h"
 #include "utilities.h"
+#include "lammps_native.h"
 
 
 namespace PAPRECA{
@@ -68,6 +70,10 @@ namespace PAPRECA{
 	
 	//Execute LAMMPS
 	void runLammps( LAMMPS_NS::LAMMPS *lmp , const int &timesteps_num );
+	void runLammpsChunk( LAMMPS_NS::LAMMPS *lmp , const int &timesteps_num , const bool &first_chunk );
+	double getPotentialEnergy( LAMMPS_NS::LAMMPS *lmp );
+	double getMaxForceInGroup( LAMMPS_NS::LAMMPS *lmp , const std::string &group_name );
+	void refreshLammps( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config );
 	void MPIBcastAndExecuteCommand( LAMMPS_NS::LAMMPS *lmp , std::string &command ); //This function gets a line command (std::string), casts it to all other procs, and executes the command
 	
 	//Simulation Box Operations
@@ -76,17 +82,18 @@ namespace PAPRECA{
 	void remap3DArrayInPeriodicBox( LAMMPS_NS::LAMMPS *lmp , double *arr ); //Receives a 3D array and remaps it inside the existing periodic box.
 	
 	//kMC operations
-	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule );
-	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , std::vector< LAMMPS_NS::tagint > &atom_ids , const std::string &delete_bonds , const std::string &delete_molecule ); //Overloaded function of the deleteAtoms function to work with vectors
+	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , LAMMPS_NS::tagint *atom_ids , const int &num_atoms , const std::string &delete_bonds , const std::string &delete_molecule , const bool native = false );
+	void deleteAtoms( LAMMPS_NS::LAMMPS *lmp , std::vector< LAMMPS_NS::tagint > &atom_ids , const std::string &delete_bonds , const std::string &delete_molecule , const bool native = false ); //Overloaded function of the deleteAtoms function to work with vectors
 	void deleteAtomsInBoxRegion( LAMMPS_NS::LAMMPS *lmp , double &boxxlo , double &boxxhi , double &boxylo , double &boxyhi , double &boxzlo , double &boxzhi , const std::string &delete_bonds , const std::string &delete_molecule );
-	void createAtom( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type );
-	void deleteBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special );
-	void formBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type );
+	void createAtom( LAMMPS_NS::LAMMPS *lmp , const double atom_pos[3] , const int &atom_type , const bool native = false );
+	void deleteBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const bool special , const bool native = false );
+	void formBond( LAMMPS_NS::LAMMPS *lmp , const LAMMPS_NS::tagint &atom1id , const LAMMPS_NS::tagint &atom2id , const int &bond_type , const bool native = false );
 	void resetMobileAtomsGroups4NveLimIntegration( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config );
+	void resetMobileAtomsGroups4LocalRelaxation( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config , std::vector< LAMMPS_NS::tagint > &relax_ids );
 	void resetMobileAtomsGroups( LAMMPS_NS::LAMMPS *lmp , PaprecaConfig &papreca_config );
 	void insertMolecule( LAMMPS_NS::LAMMPS *lmp , const double site_pos[3] , const double rot_pos[3] , const double &rot_theta , const int &mol_id , const char *mol_name );
-	void moveAtom( LAMMPS_NS::LAMMPS *lmp , const double move_pos[3] , const LAMMPS_NS::tagint &move_id );
-	void diffuseAtom( LAMMPS_NS::LAMMPS *lmp , const double vac_pos[3] , const double parent_pos[3] , const LAMMPS_NS::tagint &parent_id , const int &parent_type , const std::string &diffusion_style , const int &diffused_type );
+	void moveAtom( LAMMPS_NS::LAMMPS *lmp , const double end_pos[3] , const double start_pos[3] , const LAMMPS_NS::tagint &atom_id , const bool native = false );
+	const int diffuseAtom( LAMMPS_NS::LAMMPS *lmp , const double vac_pos[3] , const double parent_pos[3] , const LAMMPS_NS::tagint &parent_id , const int &parent_type , const std::string &diffusion_style , const int &diffused_type , const bool native = false );
 	
 	//Sigmas
 	void initType2SigmaFromLammpsPairCoeffs( LAMMPS_NS::LAMMPS *lmp , INTPAIR2DOUBLE_MAP &type2sigma );
@@ -106,6 +113,39 @@ namespace PAPRECA{
 	
 	//LAMMPS Maths wrappers
 	double get3DSqrDistWithPBC( LAMMPS_NS::LAMMPS *lmp , const double *x1 , const double *x2 );
+	void get3DMinImageDisplacement( LAMMPS_NS::LAMMPS *lmp , const double *x1 , const double *x2 , double *dist );
+	const bool radiusFitsInPeriodicBox( LAMMPS_NS::LAMMPS *lmp , const double &radius );
+	
+	class MinImageBatch{
+		
+		/// @class PAPRECA::MinImageBatch
+		/// @brief Minimum image displacements (and squared distances) between a point and all atoms of a neighbor list.
+		///
+		/// The coordinates of the neighbors are gathered into contiguous x, y, and z buffers (i.e., structure of arrays) and the minimum image convention is applied to the whole batch in a single branch-free loop that the compiler can vectorize (see MinImageBatch::compute()).
+		/// Batches are used in the innermost loops of event detection (i.e., collision checks, contaminant counts, and bond formation distances) instead of calling PAPRECA::get3DSqrDistWithPBC() once per neighbor. The per-pair functions are still used for single pairs.
+		/// @note Buffers are reused between calls. Hence, callers typically keep a thread_local MinImageBatch to avoid reallocations (and races during threaded event detection).
+		
+		public:
+			//Constructors/Destructors
+			MinImageBatch( );
+			~MinImageBatch( );
+			
+			//Functions
+			void compute( LAMMPS_NS::LAMMPS *lmp , const double *x0 , double **atom_xyz , int *neighbors , const int &neighbors_num );
+			const int &getSize( ) const;
+			const double *getDx( ) const;
+			const double *getDy( ) const;
+			const double *getDz( ) const;
+			const double *getSqrDists( ) const;
+			
+		private:
+			int size = 0; ///< number of neighbors in the current batch.
+			std::vector< double > dx; ///< x-components of minimum image displacements (neighbor minus x0).
+			std::vector< double > dy; ///< y-components of minimum image displacements (neighbor minus x0).
+			std::vector< double > dz; ///< z-components of minimum image displacements (neighbor minus x0).
+			std::vector< double > sqr_dists; ///< squared minimum image distances between x0 and each neighbor.
+		
+	};
 	
 	
 }//end of namespace PAPRECA
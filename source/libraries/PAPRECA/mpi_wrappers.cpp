@@ -31,8 +31,10 @@ namespace PAPRECA{
 		/// @param[in] arg array containing command-line arguments.
 		/// @param[in,out] nprocs number of MPI processes.
 		/// @param[in,out] proc_id identifier of current MPI process.
+		/// @note MPI is initialized with MPI_THREAD_FUNNELED, since OpenMP threads (see detection_threads command) never make MPI calls.
 		
-		MPI_Init( narg , arg );
+		int thread_support = 0;
+		MPI_Init_thread( narg , arg , MPI_THREAD_FUNNELED , &thread_support );
 		MPI_Comm_rank( MPI_COMM_WORLD , proc_id );
 		MPI_Comm_size( MPI_COMM_WORLD , nprocs );
 	}
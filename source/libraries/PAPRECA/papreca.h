@@ -32,13 +32,18 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "geometry_calc.h"
 #include "utilities.h"
 #include "lammps_wrappers.h"
+#include "lammps_native.h"
 #include "mpi_wrappers.h"
+#include "step_stats.h"
+#include "counter_rng.h"
+#include "depo_sites.h"
 
 #include "bond.h"
 #include "debug.h"
 
 #include "event.h"
 #include "event_list.h"
+#include "event_catalog.h"
 #include "event_detect.h"
 #include "event_select.h"
 #include "event_execute.h"
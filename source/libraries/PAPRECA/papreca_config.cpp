@@ -24,7 +24,10 @@ namespace PAPRECA{
 	
 	//Constructors/Destructors
 	PaprecaConfig::PaprecaConfig( ){ }
-	PaprecaConfig::~PaprecaConfig( ){ delete rnum_gen; }
+	PaprecaConfig::~PaprecaConfig( ){
+		delete rnum_gen;
+		for( LAMMPS_NS::RanMars *thread_rnum_gen : thread_rnum_gens ){ delete thread_rnum_gen; }
+	}
 	
 	//Essential parameters
 	void PaprecaConfig::setKMCsteps( const unsigned long int &KMC_steps_in ){ KMC_steps = KMC_steps_in; }
@@ -37,10 +40,61 @@ namespace PAPRECA{
 	const double &PaprecaConfig::getTimeEnd( ){ return time_end; }
 	
 	//Random numbers
-	void PaprecaConfig::initRanNumGenerator( LAMMPS_NS::LAMMPS *lmp , const int &seed ){ rnum_gen = new LAMMPS_NS::RanMars( lmp , seed ); }
-	const double PaprecaConfig::getUniformRanNum( ) const{ return rnum_gen->uniform( ); } //Returns a pseudorandom number uniformly distributed between 0 and 1 (see RanMars.h header of LAMMPS).
+	void PaprecaConfig::initRanNumGenerator( LAMMPS_NS::LAMMPS *lmp , const int &seed ){
+		rnum_gen = new LAMMPS_NS::RanMars( lmp , seed );
+		counter_rnum_gen.setSeed( static_cast< uint64_t >( seed ) );
+	}
+	const double PaprecaConfig::getUniformRanNum( ) const{ //Returns a pseudorandom number uniformly distributed between 0 and 1 (see RanMars.h header of LAMMPS).
+		const int thread_id = getThreadID( );
+		return( thread_id == 0 ? rnum_gen->uniform( ) : thread_rnum_gens[thread_id]->uniform( ) ); //Threads other than the master thread draw from their own streams during threaded event detection
+	}
 	const bool PaprecaConfig::ranNumGeneratorIsInitialized( ) const{ return( rnum_gen == NULL ? false : true ); }
 	
+	void PaprecaConfig::seedThreadRanNumGenerators( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Re-seeds the random number generators of OpenMP threads (other than the master thread) from the main random number generator. Called (serially) before every threaded event detection pass.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @note The seeds are drawn in thread order from the main random number generator of the current MPI process. Hence, results are reproducible for the same random seed, number of MPI processes, and number of detection threads.
+		/// @see PAPRECA::loopAtomsAndIdentifyEventsWithThreads()
+		
+		for( size_t i = 1; i < thread_rnum_gens.size( ); ++i ){
+			const int seed = 1 + static_cast< int >( rnum_gen->uniform( ) * 899999998.0 ); //RanMars seeds have to be in (0,900000000)
+			delete thread_rnum_gens[i];
+			thread_rnum_gens[i] = new LAMMPS_NS::RanMars( lmp , seed );
+		}
+		
+	}
+	
+	void PaprecaConfig::setCounterRNG( const bool &counter_rng_in ){ counter_rng = counter_rng_in; }
+	const bool &PaprecaConfig::counterRNGIsActive( ) const{ return counter_rng; }
+	void PaprecaConfig::setRanNumStep( const int &rnum_step_in ){ rnum_step = rnum_step_in; }
+	
+	void PaprecaConfig::getDetectionRanNums( const LAMMPS_NS::tagint &atom_id , const RNG_STREAM &stream , const int &template_id , double &rnum1 , double &rnum2 ) const{
+		
+		/// Draws the 2 random numbers of a random deposition/diffusion vector.
+		/// @param[in] atom_id ID of the parent atom.
+		/// @param[in] stream random number stream (i.e., deposition or diffusion).
+		/// @param[in] template_id ID of the event template (see PAPRECA::PredefinedDeposition::getTemplateID() and PAPRECA::PredefinedDiffusionHop::getTemplateID()).
+		/// @param[in,out] rnum1 first random number (uniformly distributed between 0 and 1).
+		/// @param[in,out] rnum2 second random number (uniformly distributed between 0 and 1).
+		/// @note If counter_rng is active, the random numbers are a pure function of the random seed, the current PAPRECA step (see PaprecaConfig::setRanNumStep()), atom_id, stream, and template_id (see PAPRECA::CounterRNG). Hence, they do not depend on the number of MPI processes or detection threads. Otherwise, they are drawn from the random number generator of the current MPI process (or OpenMP thread).
+		
+		if( counter_rng ){
+			
+			double rnums[2];
+			counter_rnum_gen.getUniformRanNums( static_cast< uint64_t >( rnum_step ) , static_cast< uint64_t >( atom_id ) , stream , static_cast< uint32_t >( template_id ) , rnums );
+			rnum1 = rnums[0];
+			rnum2 = rnums[1];
+			
+		}else{
+			
+			rnum1 = getUniformRanNum( );
+			rnum2 = getUniformRanNum( );
+			
+		}
+		
+	}
+	
 	//Atom groups
 	void PaprecaConfig::setFluidAtomTypes( const std::vector< int > &fluid_atomtypes_in ){ fluid_atomtypes = fluid_atomtypes_in; } 
 	const std::vector< int > &PaprecaConfig::getFluidAtomTypes( ) const{ return fluid_atomtypes; }
@@ -56,7 +110,7 @@ namespace PAPRECA{
 		/// @return mapped PAPRECA::PredefinedReaction object.
 		/// @note each bond can only be mapped to one PAPRECA::PredefinedReaction event.
 		
-		return( elementIsInUnorderedSet( predefined_catalog.bond_breaks_set , bond_type ) ? predefined_catalog.bond_breaks_map[bond_type] : NULL );
+		return( ( bond_type > 0 && bond_type <= catalog_bondtypes_num ) ? bond_breaks_table[bond_type] : NULL );
 		
 	}
 	
@@ -67,7 +121,19 @@ namespace PAPRECA{
 		/// @return mapped PAPRECA::PredefinedBondForm object.
 		/// @note each pair of types can only be mapped to one PAPRECA::PredefinedBondForm object.
 		
-		return( elementIsInUnorderedSet( predefined_catalog.bond_forms_set , types_pair ) ? predefined_catalog.bond_forms_map[types_pair] : NULL );
+		return getBondFormFromAtomTypes( types_pair.first , types_pair.second );
+		
+	}
+	
+	PredefinedBondForm *PaprecaConfig::getBondFormFromAtomTypes( const int &atom1_type , const int &atom2_type ) const{
+		
+		/// Returns a PAPRECA::PredefinedBondForm object from the compiled catalog.
+		/// @param[in] atom1_type type of first atom.
+		/// @param[in] atom2_type type of second atom.
+		/// @return mapped PAPRECA::PredefinedBondForm object (or NULL if the pair of types is not formable).
+		/// @see PAPRECA::PaprecaConfig::compilePredefinedCatalog()
+		
+		return( ( atom1_type > 0 && atom1_type <= catalog_types_num && atom2_type > 0 && atom2_type <= catalog_types_num ) ? bond_forms_table[atom1_type*( catalog_types_num + 1 )+atom2_type] : NULL );
 		
 	}
 	
@@ -77,7 +143,7 @@ namespace PAPRECA{
 		/// @param[in] atom_type type of atom.
 		/// @return maximum number of bonds for a specific atom type.
 		
-		return( mappingExists( predefined_catalog.bonds_max , atom_type ) ? predefined_catalog.bonds_max[atom_type] : std::numeric_limits<int>::max( ) ); 
+		return( ( atom_type > 0 && atom_type <= catalog_types_num ) ? bonds_max_table[atom_type] : std::numeric_limits<int>::max( ) ); 
 		
 	} //If no mapping is defined, return limits of int, then bonds will never be greater than limit of int (so no limit defined).
 	
@@ -88,11 +154,8 @@ namespace PAPRECA{
 		/// @param[in] bond_type type of bond to be checked.
 		/// @return maximum number of bonds of a specific bond type for an atom type.
 		
-		if( mappingExists( predefined_catalog.bondtypes_max , atom_type ) ){
-			INT2INT_MAP &species_maxbondtypes = predefined_catalog.bondtypes_max[atom_type];
-			if( mappingExists( species_maxbondtypes , bond_type ) ){
-				return species_maxbondtypes[bond_type];
-			}
+		if( atom_type > 0 && atom_type <= catalog_types_num && bond_type > 0 && bond_type <= catalog_bondtypes_num ){
+			return bondtypes_max_table[atom_type*( catalog_bondtypes_num + 1 )+bond_type];
 		}
 		return -1; //In this case this means that the mapping does not exist (this is used in the atomHasMaxBondTypes function in main.cpp)
 	}
@@ -105,7 +168,7 @@ namespace PAPRECA{
 		/// @return mapped std::vector< PAPRECA::PredefinedDiffusionHop* > (i.e., a vector containing all valid pointers to diffusion events)
 		/// @note each atom type can only be mapped to one PAPRECA::PredefinedDiffusionHop.
 		
-		return( elementIsInUnorderedSet( predefined_catalog.diffusions_set , atom_type ) ? &predefined_catalog.diffusions_map[atom_type] : NULL );
+		return( ( atom_type > 0 && atom_type <= catalog_types_num ) ? diffusions_table[atom_type] : NULL );
 		
 	}
 	
@@ -117,7 +180,7 @@ namespace PAPRECA{
 		/// @return mapped std::vector< PAPRECA::PredefinedDeposition* > (i.e., a vector containing all valid pointers to diffusion events)
 		/// @note each atom type can only be mapped to one PAPRECA::PredefinedDeposition.
 		
-		return( elementIsInUnorderedSet( predefined_catalog.depositions_set , atom_type ) ? &predefined_catalog.depositions_map[atom_type] : NULL );
+		return( ( atom_type > 0 && atom_type <= catalog_types_num ) ? depositions_table[atom_type] : NULL );
 		
 	}
 	
@@ -128,7 +191,7 @@ namespace PAPRECA{
 		/// @return mapped PAPRECA::PredefinedMonoatomicDesorption as defined in the PAPRECA::PredefinedEventsCatalog.
 		/// @note each atom type can only be mapped to one PAPRECA::PredefinedMonoatomicDesorption.
 		
-		return( elementIsInUnorderedSet( predefined_catalog.monodes_set , atom_type ) ? predefined_catalog.monodes_map[atom_type] : NULL );
+		return( ( atom_type > 0 && atom_type <= catalog_types_num ) ? monodes_table[atom_type] : NULL );
 		
 	}
 	
@@ -188,6 +251,8 @@ namespace PAPRECA{
 		
 		
 		if( diffusion ){
+			diffusion->setTemplateID( diffusion_templates.size( ) ); //Templates are defined in the same order on all procs, so the template ID can be communicated instead of the template strings
+			diffusion_templates.push_back( diffusion );
 			predefined_catalog.diffusions_set.insert(parent_type); //Even if parent type is already in the set, the unordered set prevents duplicates
 			predefined_catalog.diffusions_map[parent_type].push_back(diffusion);	
 		}else{
@@ -208,6 +273,8 @@ namespace PAPRECA{
 		}
 		
 		if( depo ){
+			depo->setTemplateID( deposition_templates.size( ) );
+			deposition_templates.push_back( depo );
 			predefined_catalog.depositions_set.insert( parent_type );
 			predefined_catalog.depositions_map[ parent_type ].push_back( depo );
 		}else{
@@ -224,53 +291,110 @@ namespace PAPRECA{
 		
 	}
 	
+	PredefinedDiffusionHop *PaprecaConfig::getDiffusionTemplate( const int &template_id ){
+		
+		/// Returns a PAPRECA::PredefinedDiffusionHop template from its template ID.
+		/// @param[in] template_id ID of the template (see PAPRECA::PredefinedDiffusionHop::getTemplateID()).
+		/// @return pointer to the PAPRECA::PredefinedDiffusionHop template.
+		/// @note Template IDs are assigned in the order the templates are defined in the PAPRECA input file. Hence, the same ID points to the same template on all MPI processes.
+		
+		if( template_id < 0 || template_id >= static_cast< int >( diffusion_templates.size( ) ) ){ allAbortWithMessage( MPI_COMM_WORLD , "Tried to retrieve diffusion template with invalid template ID " + std::to_string( template_id ) + " in papreca_config.cpp." ); }
+		return diffusion_templates[template_id];
+		
+	}
+	
+	PredefinedDeposition *PaprecaConfig::getDepositionTemplate( const int &template_id ){
+		
+		/// Returns a PAPRECA::PredefinedDeposition template from its template ID.
+		/// @param[in] template_id ID of the template (see PAPRECA::PredefinedDeposition::getTemplateID()).
+		/// @return pointer to the PAPRECA::PredefinedDeposition template.
+		/// @note Template IDs are assigned in the order the templates are defined in the PAPRECA input file. Hence, the same ID points to the same template on all MPI processes.
+		
+		if( template_id < 0 || template_id >= static_cast< int >( deposition_templates.size( ) ) ){ allAbortWithMessage( MPI_COMM_WORLD , "Tried to retrieve deposition template with invalid template ID " + std::to_string( template_id ) + " in papreca_config.cpp." ); }
+		return deposition_templates[template_id];
+		
+	}
+	
 	void PaprecaConfig::setSpeciesMaxBonds( const int &species , const int &bonds_max ){ predefined_catalog.bonds_max[ species ] = bonds_max; }
 	void PaprecaConfig::setSpeciesMaxBondTypes( const int &species , const int &bond_type , const int &bonds_max ){ predefined_catalog.bondtypes_max[species][bond_type] = bonds_max; }
 	
-	void PaprecaConfig::calcStickingCoeffs( ){
+	void PaprecaConfig::initStepStats( ){
+		
+		/// Registers the per-step statistics (i.e., deposition tries and sites used for surface coverage and variable sticking coefficients, and execution times) in the step_stats aggregator.
+		/// @note Called by PAPRECA::PaprecaConfig::compilePredefinedCatalog().
+		/// @see PAPRECA::PaprecaConfig::reduceStepStats(), PAPRECA::StepStats
+		
+		step_stats.clearStats( );
+		adsorbate2stats.clear( );
+		coverage_sites_stat = -1;
+		coverage_tries_stat = -1;
+		
+		if( surfcoverage_file.isActive( ) ){
+			coverage_sites_stat = step_stats.registerStat( STAT_SUM );
+			coverage_tries_stat = step_stats.registerStat( STAT_SUM );
+		}
+		
+		//Variable sticking coefficients are calculated per adsorbate. The map is iterated in the same order on all procs (i.e., same insertions on all procs).
+		for( auto it = predefined_catalog.depositions_map.begin( ); it != predefined_catalog.depositions_map.end( ); ++it ){
+			for( PredefinedDeposition *depo : it->second ){
+				if( depo->hasVariableStickingCoeff( ) && !mappingExists( adsorbate2stats , depo->getAdsorbateName( ) ) ){
+					const int sites_stat = step_stats.registerStat( STAT_SUM );
+					const int tries_stat = step_stats.registerStat( STAT_SUM );
+					adsorbate2stats[depo->getAdsorbateName( )] = INT_PAIR( sites_stat , tries_stat );
+				}
+			}
+		}
+		
+		if( execTime_file.isActive( ) ){ execTime_file.registerTimeStats( step_stats ); }
+		
+	}
 	
-		std::unordered_set< std::string > adsorbates;
-		std::unordered_map< std::string , int > deposition_sites;
-		std::unordered_map< std::string , int > deposition_tries;
-		std::unordered_map< std::string , double > sticking_coeff;
+	void PaprecaConfig::reduceStepStats( ){
+		
+		/// Sums the local deposition tries/sites of all PAPRECA::PredefinedDeposition templates and reduces them across all MPI processes, along with the execution times of the previous PAPRECA step (if any), with a single collective.
+		/// Different processors have different events. Hence, they have different deposition tries and sites.
+		/// @note This function has to be called before PAPRECA::PaprecaConfig::calcSurfaceCoverage() and PAPRECA::PaprecaConfig::calcStickingCoeffs().
+		/// @note Execution times are only known at the end of a PAPRECA step. Hence, they are reduced (and appended to the execTimes.log file) one PAPRECA step later. The times of the last PAPRECA step are reduced by PAPRECA::PaprecaConfig::closeExportFiles().
+		/// @see PAPRECA::getLocalRate(), PAPRECA::PaprecaConfig::calcHybridAndKMCTimes4ExecTimeFile()
 		
+		if( step_stats.getStatsNum( ) == 0 ){ return; }
 		
-		//Loop through all possible deposition events.
+		step_stats.resetLocalValues( );
 		for( auto it = predefined_catalog.depositions_map.begin( ); it != predefined_catalog.depositions_map.end( ); ++it ){
-			
-			const DEPOSITIONS_VEC &depositions = it->second;
-			
-			for( PredefinedDeposition *depo : depositions ){
-				
-				std::string adsorbate_name = depo->getAdsorbateName( );
+			for( PredefinedDeposition *depo : it->second ){
 				
+				if( coverage_sites_stat != -1 ){
+					step_stats.addToLocalValue( coverage_sites_stat , depo->getDepositionSites( ) );
+					step_stats.addToLocalValue( coverage_tries_stat , depo->getDepositionTries( ) );
+				}
 				
-				if( depo->hasVariableStickingCoeff( ) ){
-					if( !elementIsInUnorderedSet( adsorbates , adsorbate_name ) ){
-						adsorbates.insert( adsorbate_name );
-						deposition_sites[adsorbate_name] = 0;
-						deposition_tries[adsorbate_name] = 0;
-						sticking_coeff[adsorbate_name] = -1.0; //We initialize this to 0, so there is no confusion between sticking=0 (i.e., when tries are 0) and "freshly-initialized" sticking coeffs.
-						
-					}
-					
-					int depdata_global[2] = { 0 , 0 };
-					int depdata_local[2] = { depo->getDepositionSites( ) , depo->getDepositionTries( ) };
-					MPI_Allreduce( depdata_local , depdata_global , 2 , MPI_INT , MPI_SUM , MPI_COMM_WORLD ); //Different processors have different events. Hence, they should have different deptries and depsites.
-					
-					//At this point, all procs have the same deptries/depsites FOR THAT SPECIFIC PREDEFINED DEPOSITION EVENT
-					//However, the same adsorbate can have different sites and parent atoms. Hence, we collect all depsites and deptries corresponding to the same adsorbate name IN THE SAME CONTAINER
-					deposition_sites[adsorbate_name] += depdata_global[0];
-					deposition_tries[adsorbate_name] += depdata_global[1];
-					
+				if( depo->hasVariableStickingCoeff( ) ){ //The same adsorbate can have different sites and parent atoms. Hence, we collect all depsites and deptries corresponding to the same adsorbate name in the same stats.
+					const INT_PAIR &stats = adsorbate2stats[depo->getAdsorbateName( )];
+					step_stats.addToLocalValue( stats.first , depo->getDepositionSites( ) );
+					step_stats.addToLocalValue( stats.second , depo->getDepositionTries( ) );
 				}
 				
 			}
-			
 		}
 		
-		//We now have to loop again through all deposition events and calculate the sticking coefficients for specific adsorbates.
-		//No need to Allreduce data again here, since all processors should have the same deposition tries and deposition sites FOR THE SAME PREDEFINED EVENT.
+		const bool times_pending = execTime_file.timesArePending( ); //Identical on all procs
+		if( times_pending ){ execTime_file.setLocalTimeStats( step_stats ); }
+		
+		step_stats.reduce( MPI_COMM_WORLD );
+		
+		if( times_pending ){
+			int nprocs;
+			MPI_Comm_size( MPI_COMM_WORLD , &nprocs );
+			execTime_file.getReducedTimeStats( step_stats , nprocs );
+			execTime_file.appendPendingTimes( getMPIRank( MPI_COMM_WORLD ) );
+		}
+		
+	}
+	
+	void PaprecaConfig::calcStickingCoeffs( ){
+		
+		/// Sets the sticking coefficients of PAPRECA::PredefinedDeposition templates with variable sticking coefficients (i.e., free sites over total sites of the same adsorbate) and resets the deposition tries/sites of all templates.
+		/// @note The global deposition tries/sites have to be reduced first (see PAPRECA::PaprecaConfig::reduceStepStats()).
 		
 		for( auto it = predefined_catalog.depositions_map.begin( ); it != predefined_catalog.depositions_map.end( ); ++it ){
 			
@@ -278,24 +402,14 @@ namespace PAPRECA{
 			
 			for( PredefinedDeposition *depo : depositions ){
 				
-				std::string adsorbate_name = depo->getAdsorbateName( );
-				
-				
 				if( depo->hasVariableStickingCoeff( ) ){
-				
-					if( sticking_coeff[adsorbate_name] == -1.0 ){ //This means that we haven't calculated the sticking coefficient for that specific adsorbate name yet.
-						//Hence we calculate it here...
-						if( deposition_tries[adsorbate_name] == 0 ){ //This is to prevent segmentation faults when no deposition tries are attempted at all
-							sticking_coeff[adsorbate_name] = 0;
-							
-						}else{
-							sticking_coeff[adsorbate_name] = static_cast< double >( deposition_sites[adsorbate_name] ) / static_cast< double >( deposition_tries[adsorbate_name] ); //Calculate the sticking coeff which is the number of free sites divided by the number of total sites searched
-						}
-						
-					}
 					
-					//Regardless, we now set the sticking coefficient properly for that event.
-					depo->setStickingCoeff( sticking_coeff[adsorbate_name] );
+					const INT_PAIR &stats = adsorbate2stats[depo->getAdsorbateName( )];
+					const double deposition_sites = step_stats.getGlobalValue( stats.first );
+					const double deposition_tries = step_stats.getGlobalValue( stats.second );
+					
+					//Avoid dividing by zero when no deposition tries are attempted at all
+					depo->setStickingCoeff( deposition_tries == 0 ? 0.0 : deposition_sites / deposition_tries ); //The sticking coeff is the number of free sites divided by the number of total sites searched
 					
 				}//No need to do anything if the deposition is not variable. If the deposition event has a constant sticking coeff, the relevant sticking coeff is already set properly.
 			
@@ -319,9 +433,279 @@ namespace PAPRECA{
 	}
 	
 	
+	const bool PaprecaConfig::predefinedCatalogHasVariableStickingDepositions( ) const{
+		
+		/// @return true if at least one PAPRECA::PredefinedDeposition has a variable sticking coefficient or false otherwise.
+		
+		for( auto it = predefined_catalog.depositions_map.begin( ); it != predefined_catalog.depositions_map.end( ); ++it ){
+			for( PredefinedDeposition *depo : it->second ){
+				if( depo->hasVariableStickingCoeff( ) ){ return true; }
+			}
+		}
+		
+		return false;
+		
+	}
+	
+	
+	//Compiled catalog
+	void PaprecaConfig::compilePredefinedCatalog( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Copies the hashed containers of the PAPRECA::PredefinedEventsCatalog (and the type2sigma map) into dense tables indexed by atom type and/or bond type.
+		/// Those tables are queried in the innermost neighbor loops of event detection. The number of atom/bond types is small, so the tables fit in the L1 cache.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @note This function is called at the end of PAPRECA::readInputAndInitPaprecaConfig(), once the predefined catalog and the sigmas are final. Any later change to the predefined catalog requires a new call.
+		/// @see PAPRECA::PaprecaConfig::atomTypeHasCatalogFlag(), PAPRECA::PaprecaConfig::initSigmaSqrMatrix(), PAPRECA::PaprecaConfig::initDepositionCollisionCells()
+		
+		//Cover all LAMMPS types as well as any (invalid) type used in the PAPRECA input file, so that no catalog entry is silently dropped.
+		catalog_types_num = *( int *)lammps_extract_global( lmp , const_cast<char*>( "ntypes" ) );
+		catalog_bondtypes_num = *( int *)lammps_extract_global( lmp , const_cast<char*>( "nbondtypes" ) );
+		
+		for( const auto &element : predefined_catalog.bond_breaks_map ){ catalog_bondtypes_num = std::max( catalog_bondtypes_num , element.first ); }
+		for( const auto &element : predefined_catalog.bond_forms_map ){ catalog_types_num = std::max( catalog_types_num , std::max( element.first.first , element.first.second ) ); }
+		for( const auto &element : predefined_catalog.bonds_max ){ catalog_types_num = std::max( catalog_types_num , element.first ); }
+		for( const auto &element : predefined_catalog.bondtypes_max ){
+			catalog_types_num = std::max( catalog_types_num , element.first );
+			for( const auto &max_element : element.second ){ catalog_bondtypes_num = std::max( catalog_bondtypes_num , max_element.first ); }
+		}
+		for( const auto &element : predefined_catalog.diffusions_map ){ catalog_types_num = std::max( catalog_types_num , element.first ); }
+		for( const auto &element : predefined_catalog.depositions_map ){ catalog_types_num = std::max( catalog_types_num , element.first ); }
+		for( const auto &element : predefined_catalog.monodes_map ){ catalog_types_num = std::max( catalog_types_num , element.first ); }
+		
+		const int types_dim = catalog_types_num + 1;
+		const int bondtypes_dim = catalog_bondtypes_num + 1;
+		
+		type_flags_table.assign( types_dim , CATALOG_NONE );
+		bond_breaks_table.assign( bondtypes_dim , NULL );
+		bond_forms_table.assign( types_dim * types_dim , NULL );
+		bonds_max_table.assign( types_dim , std::numeric_limits< int >::max( ) );
+		bondtypes_max_table.assign( types_dim * bondtypes_dim , -1 );
+		diffusions_table.assign( types_dim , NULL );
+		depositions_table.assign( types_dim , NULL );
+		monodes_table.assign( types_dim , NULL );
+		
+		//Only positive keys are valid LAMMPS types
+		for( const auto &element : predefined_catalog.bond_breaks_map ){
+			if( element.first > 0 ){ bond_breaks_table[element.first] = element.second; }
+		}
+		
+		for( const auto &element : predefined_catalog.bond_forms_map ){
+			const int &atom1_type = element.first.first;
+			const int &atom2_type = element.first.second;
+			if( atom1_type > 0 && atom2_type > 0 ){
+				bond_forms_table[atom1_type*types_dim+atom2_type] = element.second;
+				type_flags_table[atom1_type] |= CATALOG_BOND_FORM;
+				type_flags_table[atom2_type] |= CATALOG_BOND_FORM;
+			}
+		}
+		
+		for( const auto &element : predefined_catalog.bonds_max ){
+			if( element.first > 0 ){ bonds_max_table[element.first] = element.second; }
+		}
+		
+		for( const auto &element : predefined_catalog.bondtypes_max ){
+			if( element.first < 1 ){ continue; }
+			for( const auto &max_element : element.second ){
+				if( max_element.first > 0 ){ bondtypes_max_table[element.first*bondtypes_dim+max_element.first] = max_element.second; }
+			}
+		}
+		
+		for( auto &element : predefined_catalog.diffusions_map ){
+			if( element.first > 0 ){
+				diffusions_table[element.first] = &element.second;
+				type_flags_table[element.first] |= CATALOG_DIFFUSION;
+			}
+		}
+		
+		for( auto &element : predefined_catalog.depositions_map ){
+			if( element.first > 0 ){
+				depositions_table[element.first] = &element.second;
+				type_flags_table[element.first] |= CATALOG_DEPOSITION;
+			}
+		}
+		
+		for( const auto &element : predefined_catalog.monodes_map ){
+			if( element.first > 0 ){
+				monodes_table[element.first] = element.second;
+				type_flags_table[element.first] |= CATALOG_MONODES;
+			}
+		}
+		
+		//Sigmas, deposition collision cells, and per-step deposition statistics
+		initSigmaSqrMatrix( lmp );
+		initDepositionCollisionCells( );
+		initEventReachMax( );
+		initStepStats( );
+		
+	}
+	
+	const bool PaprecaConfig::atomTypeHasCatalogFlag( const int &atom_type , const int &flag ) const{
+		
+		/// @param[in] atom_type type of atom.
+		/// @param[in] flag PAPRECA::CATALOG_TYPE_FLAG value (or a combination of flags).
+		/// @return true if atom_type is mapped to at least one of the predefined event classes in flag, false otherwise.
+		/// @see PAPRECA::PaprecaConfig::compilePredefinedCatalog()
+		
+		return( ( atom_type > 0 && atom_type <= catalog_types_num && ( type_flags_table[atom_type] & flag ) ) ? true : false );
+		
+	}
+	
+	
 	//Randon deposition vectors
 	void PaprecaConfig::setRandomDepoVecs( const bool &random_depovecs_in ){ random_depovecs = random_depovecs_in; }
 	const bool &PaprecaConfig::depoVecsAreRandom( ) const{ return random_depovecs; }
+	
+	//Incremental event detection
+	void PaprecaConfig::setIncrementalDetection( const bool &incremental_detection_in ){ incremental_detection = incremental_detection_in; }
+	const bool &PaprecaConfig::incrementalDetectionIsActive( ) const{ return incremental_detection; }
+	
+	//Bond adjacency
+	void PaprecaConfig::setLocalBondAdjacency( const bool &local_bond_adjacency_in ){ local_bond_adjacency = local_bond_adjacency_in; }
+	const bool &PaprecaConfig::localBondAdjacencyIsActive( ) const{ return local_bond_adjacency; }
+	
+	//Native execution
+	void PaprecaConfig::setNativeExecution( const bool &native_execution_in ){ native_execution = native_execution_in; }
+	const bool &PaprecaConfig::nativeExecutionIsActive( ) const{ return native_execution; }
+	
+	//Synchronous sublattice kMC
+	void PaprecaConfig::setSublatticeKMC( const bool &sublattice_kmc_in ){ sublattice_kmc = sublattice_kmc_in; }
+	const bool &PaprecaConfig::sublatticeKMCIsActive( ) const{ return sublattice_kmc; }
+	
+	//Event batching
+	void PaprecaConfig::setKMCBatchSize( const int &kmc_batch_size_in ){ kmc_batch_size = kmc_batch_size_in; }
+	const int &PaprecaConfig::getKMCBatchSize( ) const{ return kmc_batch_size; }
+	const bool PaprecaConfig::eventBatchingIsActive( ) const{
+		
+		/// @return true if events can be executed from the same event detection pass on consecutive PAPRECA steps (see PAPRECA::continueEventBatch()) or false otherwise.
+		/// @note Batching is disabled if the detected events depend on quantities that are recalculated on every PAPRECA step (i.e., deposition tries/sites for variable sticking coefficients or surface coverage, and the film height if depoheights are set).
+		
+		if( kmc_batch_size <= 1 ){ return false; }
+		if( surfcoverage_file.isActive( ) || predefinedCatalogHasVariableStickingDepositions( ) ){ return false; }
+		if( height_deposcan != -1 || height_deporeject != -1 ){ return false; }
+		
+		return true;
+		
+	}
+	
+	//Threaded event detection
+	void PaprecaConfig::setDetectionThreadsNum( const int &detection_threads_in ){ detection_threads = detection_threads_in; }
+	const int &PaprecaConfig::getDetectionThreadsNum( ) const{ return detection_threads; }
+	
+	void PaprecaConfig::initThreadedDetection( ){
+		
+		/// Allocates the per-thread random number generators and deposition counters used by threaded event detection (see PAPRECA::loopAtomsAndIdentifyEventsWithThreads()). Has to be called after reading the whole PAPRECA input file.
+		
+		if( detection_threads <= 1 ){ return; }
+		
+		thread_rnum_gens.assign( detection_threads , NULL );
+		for( PredefinedDeposition *depo_template : deposition_templates ){ depo_template->initThreadCounters( detection_threads ); }
+		
+	}
+	
+	void PaprecaConfig::mergeDepositionThreadCounters( ){
+		
+		/// Merges the per-thread deposition tries/sites counters of all PAPRECA::PredefinedDeposition templates (see PAPRECA::PredefinedDeposition::mergeThreadCounters()).
+		
+		for( PredefinedDeposition *depo_template : deposition_templates ){ depo_template->mergeThreadCounters( ); }
+		
+	}
+	
+	//Deposition site deduplication
+	void PaprecaConfig::setDepoSiteTolerance( const double &depo_site_tolerance_in ){ depo_site_tolerance = depo_site_tolerance_in; }
+	const double &PaprecaConfig::getDepoSiteTolerance( ) const{ return depo_site_tolerance; }
+	const bool PaprecaConfig::depoSiteDedupIsActive( ) const{
+		
+		/// @return true if deposition candidates are deduplicated during event detection (see PAPRECA::DepositionSiteGrid) or false otherwise.
+		/// @note Deduplication is disabled with incremental_detection, since only some atoms are rescanned and their candidates cannot be compared against the deposition events stored in the PAPRECA::EventCatalog.
+		
+		return( depo_site_tolerance > 0.0 && !incremental_detection );
+		
+	}
+	
+	void PaprecaConfig::resetDepoSiteGrids( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Clears the deposition site grids of all detection threads and fits them to the current simulation box. Has to be called (serially) before every event detection pass.
+		/// @param[in] lmp pointer to LAMMPS object.
+		
+		if( !depoSiteDedupIsActive( ) ){ return; }
+		
+		if( depo_site_grids.size( ) != static_cast< size_t >( detection_threads ) ){ depo_site_grids.resize( detection_threads ); }
+		for( DepositionSiteGrid &grid : depo_site_grids ){ grid.reset( lmp , depo_site_tolerance ); }
+		
+	}
+	
+	DepositionSiteGrid &PaprecaConfig::getDepoSiteGrid( ){ return depo_site_grids[getThreadID( )]; } //Each detection thread uses its own grid
+	
+	//Localized relaxation
+	void PaprecaConfig::setLocalRelaxRadius( const double &local_relax_radius_in ){ local_relax_radius = local_relax_radius_in; }
+	const double &PaprecaConfig::getLocalRelaxRadius( ) const{ return local_relax_radius; }
+	const bool PaprecaConfig::localRelaxIsActive( ) const{ return( local_relax_radius > 0.0 ); }
+	
+	//Adaptive MD stages
+	void PaprecaConfig::setAdaptiveMD( const int &adaptive_md_chunk_in , const std::string &adaptive_md_metric_in , const double &adaptive_md_tol_in ){
+		
+		adaptive_md_chunk = adaptive_md_chunk_in;
+		adaptive_md_metric = adaptive_md_metric_in;
+		adaptive_md_tol = adaptive_md_tol_in;
+		
+	}
+	
+	const int &PaprecaConfig::getAdaptiveMDChunk( ) const{ return adaptive_md_chunk; }
+	const std::string &PaprecaConfig::getAdaptiveMDMetric( ) const{ return adaptive_md_metric; }
+	const double &PaprecaConfig::getAdaptiveMDTolerance( ) const{ return adaptive_md_tol; }
+	const bool PaprecaConfig::adaptiveMDIsActive( ) const{ return( adaptive_md_chunk > 0 ); }
+	
+	//LAMMPS setup state
+	void PaprecaConfig::saveLammpsSetupState( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Stores the current state of the LAMMPS system (i.e., timestep, number of atoms/bonds, and box bounds). Has to be called right after a LAMMPS setup (i.e., a run 0 or a neighbor lists rebuild).
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @see PAPRECA::refreshLammps()
+		
+		lammps_setup_saved = true;
+		lammps_system_modified = false;
+		lammps_init_required = false;
+		lammps_setup_ntimestep = lmp->update->ntimestep;
+		lammps_setup_natoms = lmp->atom->natoms;
+		lammps_setup_nbonds = lmp->atom->nbonds;
+		for( int i = 0; i < 3; ++i ){
+			lammps_setup_boxlo[i] = lmp->domain->boxlo[i];
+			lammps_setup_boxhi[i] = lmp->domain->boxhi[i];
+		}
+		
+	}
+	
+	void PaprecaConfig::setLammpsSystemModified( ){ lammps_system_modified = true; }
+	void PaprecaConfig::setLammpsInitRequired( ){ lammps_init_required = true; }
+	
+	const bool PaprecaConfig::lammpsSetupIsOutdated( LAMMPS_NS::LAMMPS *lmp ) const{
+		
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @return true if the LAMMPS system (i.e., box, atoms, bonds, or atom positions) changed since the last LAMMPS setup, or if no LAMMPS setup was saved. False otherwise.
+		/// @note Atom positions are assumed to change only through LAMMPS runs (i.e., timestep changes) and executed events (see PAPRECA::PaprecaConfig::setLammpsSystemModified()).
+		
+		if( !lammps_setup_saved || lammps_system_modified || lammps_init_required ){ return true; }
+		if( lmp->update->ntimestep != lammps_setup_ntimestep ){ return true; }
+		if( lmp->atom->natoms != lammps_setup_natoms || lmp->atom->nbonds != lammps_setup_nbonds ){ return true; }
+		
+		return lammpsInitIsRequired( lmp );
+		
+	}
+	
+	const bool PaprecaConfig::lammpsInitIsRequired( LAMMPS_NS::LAMMPS *lmp ) const{
+		
+		/// @param[in] lmp pointer to previously instantiated LAMMPS object.
+		/// @return true if LAMMPS has to be fully initialized (i.e., through run 0) before accessing its neighbor lists. This is the case if no LAMMPS setup was saved, if fixes were added/removed, or if the simulation box changed since the last LAMMPS setup. False otherwise.
+		
+		if( !lammps_setup_saved || lammps_init_required ){ return true; }
+		for( int i = 0; i < 3; ++i ){
+			if( lmp->domain->boxlo[i] != lammps_setup_boxlo[i] || lmp->domain->boxhi[i] != lammps_setup_boxhi[i] ){ return true; }
+		}
+		
+		return false;
+		
+	}
+	
 	void PaprecaConfig::setDepoHeights( const double &height_deposcan_in , const double &height_deporeject_in ){
 		
 		height_deposcan = height_deposcan_in;
@@ -447,6 +831,108 @@ namespace PAPRECA{
 	
 	const bool PaprecaConfig::type2SigmaMapIsEmpty( ) const{ return( type2sigma.empty( ) ? true : false ); }
 	
+	void PaprecaConfig::initSigmaSqrMatrix( LAMMPS_NS::LAMMPS *lmp ){
+		
+		/// Copies the (squared) type2sigma values into a dense matrix indexed by atom types. Collision checks are performed in the innermost neighbor loops of event detection, so hashed lookups in the type2sigma map are avoided there.
+		/// @param[in] lmp pointer to LAMMPS object.
+		/// @note This function has to be called after PAPRECA::PaprecaConfig::mixSigmas(), once all sigmas are set. It is called by PAPRECA::PaprecaConfig::compilePredefinedCatalog().
+		/// @see PAPRECA::PaprecaConfig::getSigmaSqrFromAtomTypes(), PAPRECA::PaprecaConfig::getSigmaMax()
+		
+		sigma_types_num = *( int *)lammps_extract_global( lmp , const_cast<char*>( "ntypes" ) );
+		sigma_sqr_matrix.assign( ( sigma_types_num + 1 ) * ( sigma_types_num + 1 ) , -1.0 );
+		sigma_max = 0.0;
+		
+		for( const auto &element : type2sigma ){
+			
+			const int &atom1_type = element.first.first;
+			const int &atom2_type = element.first.second;
+			if( atom1_type < 1 || atom1_type > sigma_types_num || atom2_type < 1 || atom2_type > sigma_types_num ){ continue; } //Sigmas of non-existent types can never be queried
+			
+			const double &sigma = element.second;
+			sigma_sqr_matrix[atom1_type*( sigma_types_num + 1 )+atom2_type] = sigma * sigma;
+			if( sigma > sigma_max ){ sigma_max = sigma; }
+			
+		}
+		
+	}
+	
+	const double PaprecaConfig::getSigmaSqrFromAtomTypes( const int &atom1_type , const int &atom2_type ) const{
+		
+		/// Returns the squared sigma between two atom types from the dense matrix initialized by PAPRECA::PaprecaConfig::initSigmaSqrMatrix().
+		/// @param[in] atom1_type type of first atom.
+		/// @param[in] atom2_type type of second atom.
+		/// @return squared sigma value between atom1_type and atom2_type.
+		/// @note Aborts if the sigma of the requested pair is unmapped or zero (as collisions cannot be checked correctly in those cases).
+		
+		double sigma_sqr = -1.0;
+		if( atom1_type > 0 && atom1_type <= sigma_types_num && atom2_type > 0 && atom2_type <= sigma_types_num ){ sigma_sqr = sigma_sqr_matrix[atom1_type*( sigma_types_num + 1 )+atom2_type]; }
+		
+		if( sigma_sqr <= 0.0 ){
+			
+			if( sigma_sqr < 0.0 ){ allAbortWithMessage( MPI_COMM_WORLD , "Tried to return unmapped sigma values for species " + std::to_string( atom1_type ) + " and " + std::to_string( atom2_type ) + " in papreca_config.cpp." ); }
+			allAbortWithMessage( MPI_COMM_WORLD , "Sigma between types " + std::to_string( atom1_type ) + " and " + std::to_string( atom2_type ) + " is zero! Collisions might not be checked correctly! Please ensure that all sigmas are initialized properly. " );
+			
+		}
+		
+		return sigma_sqr;
+		
+	}
+	
+	const double &PaprecaConfig::getSigmaMax( ) const{ return sigma_max; }
+	
+	void PaprecaConfig::initDepositionCollisionCells( ){
+		
+		/// Bins the atoms of every PAPRECA::PredefinedDeposition template in cells with an edge equal to the largest sigma in the system. Collision checks then only visit template atoms in cells close to the tested system atom.
+		/// Also stores the largest sigma between each atom type and the atoms of every template, so that bounding-sphere tests use a per-type (instead of a global) collision reach.
+		/// @note This function has to be called after PAPRECA::PaprecaConfig::initSigmaSqrMatrix().
+		/// @note Atom types with unmapped (or zero) sigmas to any template atom get the global sigma_max, so that the per-atom checks still catch (and abort on) unmapped sigmas.
+		/// @see PAPRECA::PredefinedDeposition::initCollisionCells(), PAPRECA::PredefinedDeposition::initTypeSigmaMax(), PAPRECA::candidateDepoHasCollisions()
+		
+		for( PredefinedDeposition *depo_template : deposition_templates ){
+			
+			depo_template->initCollisionCells( sigma_max );
+			
+			std::vector< double > type_sigma_max( sigma_types_num + 1 , sigma_max );
+			const int *mol_atomtypes = depo_template->getAtomTypes( );
+			for( int atom_type = 1; atom_type <= sigma_types_num; ++atom_type ){
+				
+				double sigma_sqr_max = 0.0;
+				for( int j = 0; j < depo_template->getAtomsNum( ); ++j ){
+					
+					const int &mol_atomtype = mol_atomtypes[j];
+					const double sigma_sqr = ( mol_atomtype > 0 && mol_atomtype <= sigma_types_num ) ? sigma_sqr_matrix[atom_type*( sigma_types_num + 1 )+mol_atomtype] : -1.0;
+					if( sigma_sqr <= 0.0 ){
+						sigma_sqr_max = sigma_max * sigma_max;
+						break;
+					}
+					if( sigma_sqr > sigma_sqr_max ){ sigma_sqr_max = sigma_sqr; }
+					
+				}
+				type_sigma_max[atom_type] = std::sqrt( sigma_sqr_max );
+				
+			}
+			
+			depo_template->initTypeSigmaMax( type_sigma_max );
+			
+		}
+		
+	}
+	
+	void PaprecaConfig::initEventReachMax( ){
+		
+		/// Calculates the largest distance from the parent atom at which a deposition or diffusion event can insert, move, or check (for collisions) atoms.
+		/// A deposition inserts the atoms of the molecule up to depo_offset + bounding radius from the parent atom and checks for collisions sigma_max further. A diffusion hop moves (or inserts) an atom diff_dist away from the parent atom and checks for collisions sigma_max further.
+		/// @note This function has to be called after PAPRECA::PaprecaConfig::initSigmaSqrMatrix().
+		/// @see PAPRECA::selectAndExecuteSublatticeEvents()
+		
+		event_reach_max = 0.0;
+		for( PredefinedDeposition *depo_template : deposition_templates ){ event_reach_max = std::max( event_reach_max , depo_template->getDepoOffset( ) + depo_template->getBoundingRadius( ) + sigma_max ); }
+		for( PredefinedDiffusionHop *diff_template : diffusion_templates ){ event_reach_max = std::max( event_reach_max , diff_template->getDiffusionDist( ) + sigma_max ); }
+		
+	}
+	
+	const double &PaprecaConfig::getEventReachMax( ) const{ return event_reach_max; }
+	
 	
 	//Equilibrations - LAMMPS
 	void PaprecaConfig::setMinimize1( const std::string &minimize1_in ){ minimize1 = minimize1_in; }
@@ -465,6 +951,8 @@ namespace PAPRECA{
 	const int &PaprecaConfig::getNveLimSteps( ) const{ return nvelim_steps; }
 	void PaprecaConfig::setNveLimDist( const double &nvelim_dist_in ){ nvelim_dist = nvelim_dist_in; }
 	const double &PaprecaConfig::getNveLimDist( ) const{ return nvelim_dist; }
+	void PaprecaConfig::setNveLimPersistent( const bool &nvelim_persistent_in ){ nvelim_persistent = nvelim_persistent_in; }
+	const bool &PaprecaConfig::nveLimIsPersistent( ) const{ return nvelim_persistent; }
 	const bool PaprecaConfig::nveLimGroupIsEmpty( ) const{ return nvelim_ids.empty( ); }
 	const TAGINT_VEC &PaprecaConfig::getNveLimIdsVec( ) const{ return nvelim_ids; }
 	void PaprecaConfig::clearNveLimGroup( ){ nvelim_ids.clear( ); }
@@ -512,31 +1000,18 @@ namespace PAPRECA{
 	
 	void PaprecaConfig::calcSurfaceCoverage( ){
 		
-		int depdata_global[2] = { 0 , 0 };
-		int depdata_local[2] = { 0 , 0 };
-		
-		for( auto it = predefined_catalog.depositions_map.begin( ); it != predefined_catalog.depositions_map.end( ); ++it ){
-			
-			const DEPOSITIONS_VEC &depositions = it->second;
-			
-			for( PredefinedDeposition *depo : depositions ){
-				
-				depdata_local[0] += depo->getDepositionSites( );
-				depdata_local[1] += depo->getDepositionTries( );
-				
-			}
-			
-		}
+		/// Calculates the global surface coverage from the deposition tries/sites of all PAPRECA::PredefinedDeposition templates.
+		/// @note The global deposition tries/sites have to be reduced first (see PAPRECA::PaprecaConfig::reduceStepStats()).
 		
-		//Different processors have different events. Hence, they should have different deptries and depsites.
-		//Gather the different deposites and tries from ALL events
+		if( coverage_sites_stat == -1 ){ return; }
 		
-		MPI_Allreduce( depdata_local , depdata_global , 2 , MPI_INT , MPI_SUM , MPI_COMM_WORLD ); 
+		const double deposition_sites = step_stats.getGlobalValue( coverage_sites_stat );
+		const double deposition_tries = step_stats.getGlobalValue( coverage_tries_stat );
 		
-		if( depdata_global[1] == 0 ){ 
+		if( deposition_tries == 0 ){ 
 			surface_coverage = 0; //To avoid dividing by 0, set the surface coverage to zero if there are no detected deposition sites.
 		}else{ 
-			surface_coverage = static_cast< double >( 1.0 ) - static_cast< double >( depdata_global[0] ) / static_cast< double >( depdata_global[1] );  //depsites are the free sites for deposition. Hence, the surface coverage is 1 - sites/tries = 1 - sticking_coeff. This is the GLOBAL sticking coeff and not the per-event sticking coeff (as calculated by the calcStickingCoeff function).
+			surface_coverage = 1.0 - deposition_sites / deposition_tries;  //depsites are the free sites for deposition. Hence, the surface coverage is 1 - sites/tries = 1 - sticking_coeff. This is the GLOBAL sticking coeff and not the per-event sticking coeff (as calculated by the calcStickingCoeff function).
 		}
 
 	}
@@ -566,12 +1041,13 @@ namespace PAPRECA{
 		
 	}
 	
-	void PaprecaConfig::calcHybridAndKMCTimes4ExecTimeFile( const int &nprocs , const int &KMC_loopid ){
+	void PaprecaConfig::calcHybridAndKMCTimes4ExecTimeFile( LAMMPS_NS::LAMMPS *lmp , const int &KMC_loopid ){
 		
 		if( execTime_file.isActive( ) && ( KMC_loopid % execTime_file.getPrintFreq( ) == 0 ) ){
 			
-			execTime_file.calcHybridTime( nprocs );
-			execTime_file.calcKMCtime( nprocs );
+			execTime_file.calcHybridTime( );
+			execTime_file.calcKMCtime( );
+			execTime_file.setPendingTimes( KMC_loopid , *( int *)lammps_extract_global( lmp , "natoms" ) ); //No collective here. The times of this step are reduced with the per-step statistics of the next step (see PAPRECA::PaprecaConfig::reduceStepStats()).
 			
 		}
 		
@@ -583,19 +1059,19 @@ namespace PAPRECA{
 		
 	}
 	
-	void PaprecaConfig::calcMDTime4ExecTimeFile( const int &nprocs , const int &KMC_loopid ){
+	void PaprecaConfig::calcMDTime4ExecTimeFile( const int &KMC_loopid ){
 		
-		if( execTime_file.isActive( ) && ( KMC_loopid % execTime_file.getPrintFreq( ) == 0 ) ){ execTime_file.calcMDtime( nprocs ); }
+		if( execTime_file.isActive( ) && ( KMC_loopid % execTime_file.getPrintFreq( ) == 0 ) ){ execTime_file.calcMDtime( ); } //The MD time is reduced with the rest of the times (see PAPRECA::PaprecaConfig::reduceStepStats()).
 		
 	}
 	
 	
-	void PaprecaConfig::dumpElementalDistributionFile( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &KMC_loopid , double **mass_profiles_total , double *atom_mass , const int &bins_num , const int &types_num ){
+	void PaprecaConfig::dumpElementalDistributionFile( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &KMC_loopid , const std::vector< double > &mass_profiles , double *atom_mass , const int &bins_num , const int &bin_lo , const int &occupied_bins_num , const int &types_num ){
 		
 		if( proc_id == 0 ){
 			if( elementalDistribution_files.isActive( ) && ( KMC_loopid % elementalDistribution_files.getPrintFreq( ) == 0 ) ){
 				elementalDistribution_files.init( KMC_loopid , types_num );
-				elementalDistribution_files.append( lmp , mass_profiles_total , types_num , bins_num , bin_width , atom_mass );
+				elementalDistribution_files.append( lmp , mass_profiles , types_num , bins_num , bin_lo , occupied_bins_num , bin_width , atom_mass );
 				elementalDistribution_files.close( );
 			}
 		}
@@ -611,9 +1087,7 @@ namespace PAPRECA{
 			//Append to all files except for papreca.log (contains event specific information and is appended in the event_execute.cpp file)
 			if( heightVtime_file.isActive( ) && ( KMC_loopid % heightVtime_file.getPrintFreq( ) == 0 ) ){ heightVtime_file.append( time , film_height ); }
 			if( surfcoverage_file.isActive( ) && ( KMC_loopid % surfcoverage_file.getPrintFreq( ) == 0 ) ){ surfcoverage_file.append( time , surface_coverage ); } //surf_coverage here is a member variable of the papreca_config object. 
-			if( execTime_file.isActive( ) && ( KMC_loopid % execTime_file.getPrintFreq( ) == 0 ) ){ 
-				execTime_file.append( KMC_loopid , *( int *)lammps_extract_global( lmp , "natoms" ) );
-			}
+			//The execTimes.log file is appended after the times are reduced (i.e., on the next PAPRECA step, see PAPRECA::PaprecaConfig::reduceStepStats()).
 			
 		}
 		
@@ -621,6 +1095,8 @@ namespace PAPRECA{
 	
 	void PaprecaConfig::closeExportFiles( const int &proc_id ){
 		
+		if( execTime_file.timesArePending( ) ){ reduceStepStats( ); } //Reduce and append the times of the last PAPRECA step (collective, so this function has to be called on all procs).
+		
 		if( proc_id == 0 ){
 			
 			log_file.close( );
@@ -41,9 +41,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "lammps_wrappers.h"
 #include "utilities.h"
 #include "export_files.h"
+#include "counter_rng.h"
+#include "depo_sites.h"
 
 namespace PAPRECA{
 	
+	/// Bitmask flags stored per atom type in the compiled catalog (see PAPRECA::PaprecaConfig::compilePredefinedCatalog()).
+	enum CATALOG_TYPE_FLAG{ CATALOG_NONE = 0 , CATALOG_BOND_FORM = 1 , CATALOG_DIFFUSION = 2 , CATALOG_DEPOSITION = 4 , CATALOG_MONODES = 8 };
+	
 	/*This function stores variables that are necessary for the PAPRECA run.
 	You can consider this class as a container storing the simulation settings and global variables.
 	Most variables in this class are initialized by the PAPRECA input file.*/
@@ -72,6 +77,11 @@ namespace PAPRECA{
 			void initRanNumGenerator( LAMMPS_NS::LAMMPS *lmp , const int &seed );
 			const double getUniformRanNum( ) const;
 			const bool ranNumGeneratorIsInitialized( ) const;
+			void seedThreadRanNumGenerators( LAMMPS_NS::LAMMPS *lmp );
+			void setCounterRNG( const bool &counter_rng_in );
+			const bool &counterRNGIsActive( ) const;
+			void setRanNumStep( const int &rnum_step_in );
+			void getDetectionRanNums( const LAMMPS_NS::tagint &atom_id , const RNG_STREAM &stream , const int &template_id , double &rnum1 , double &rnum2 ) const;
 			
 			//Atom groups
 			void setFluidAtomTypes( const std::vector< int > &fluid_atomtypes_in );
@@ -82,6 +92,7 @@ namespace PAPRECA{
 			//Predefined events
 			PredefinedReaction *getReactionFromBondType( const int &bond_type );
 			PredefinedBondForm *getBondFormFromAtomTypesPair( const INT_PAIR &types_pair );
+			PredefinedBondForm *getBondFormFromAtomTypes( const int &atom1_type , const int &atom2_type ) const;
 			int getMaxBondsFromSpecies( const int &atom_type );
 			int getMaxBondTypesOfSpecies( const int &atom_type , const int &bond_type );
 			DIFFUSIONS_VEC *getDiffusionHopsFromAtomType(int atom_type);
@@ -92,8 +103,12 @@ namespace PAPRECA{
 			void initPredefinedDiffusionHop( const int &parent_type , const double &insertion_vel , const double &diff_dist , const std::string &diffvec_style , const std::string &diffusion_style , const int &diffused_type , const double &rate , const std::string &custom_style , const std::vector< int > &custom_atomtypes , const std::vector< double > &custom_constants , INTPAIR2DOUBLE_MAP &contnum_to_rate );
 			void initPredefinedDeposition( LAMMPS_NS::LAMMPS *lmp , const int &parent_type , const double &depo_offset , const double &insertion_vel , const std::string &adsorbate_name , const double &rate , const bool &variable_sticking , const double &sticking_coeff );
 			void initPredefinedMonoatomicDesorption( const int &parent_type , const double &rate );
+			PredefinedDiffusionHop *getDiffusionTemplate( const int &template_id );
+			PredefinedDeposition *getDepositionTemplate( const int &template_id );
 			void setSpeciesMaxBonds( const int &species , const int &bonds_max );
 			void setSpeciesMaxBondTypes( const int &species , const int &bond_type , const int &bonds_max );
+			void initStepStats( );
+			void reduceStepStats( );
 			void calcStickingCoeffs( );
 			const bool predefinedCatalogHasBondBreakEvents( ) const;
 			const bool predefinedCatalogHasBondFormEvents( ) const;
@@ -101,10 +116,68 @@ namespace PAPRECA{
 			const bool predefinedCatalogHasDepositionEvents( ) const;
 			const bool predefinedCatalogHasMonoDesEvents( ) const;
 			const bool predefinedCatalogIsEmpty( ) const;
+			const bool predefinedCatalogHasVariableStickingDepositions( ) const;
+			
+			//Compiled catalog
+			void compilePredefinedCatalog( LAMMPS_NS::LAMMPS *lmp );
+			const bool atomTypeHasCatalogFlag( const int &atom_type , const int &flag ) const;
 			
 			//Random Deposition Vectors
 			void setRandomDepoVecs( const bool &random_depovecs_in );
 			const bool &depoVecsAreRandom( ) const;
+			
+			//Incremental event detection
+			void setIncrementalDetection( const bool &incremental_detection_in );
+			const bool &incrementalDetectionIsActive( ) const;
+			
+			//Bond adjacency
+			void setLocalBondAdjacency( const bool &local_bond_adjacency_in );
+			const bool &localBondAdjacencyIsActive( ) const;
+			
+			//Native execution
+			void setNativeExecution( const bool &native_execution_in );
+			const bool &nativeExecutionIsActive( ) const;
+			
+			//Synchronous sublattice kMC
+			void setSublatticeKMC( const bool &sublattice_kmc_in );
+			const bool &sublatticeKMCIsActive( ) const;
+			
+			//Event batching
+			void setKMCBatchSize( const int &kmc_batch_size_in );
+			const int &getKMCBatchSize( ) const;
+			const bool eventBatchingIsActive( ) const;
+			
+			//Threaded event detection
+			void setDetectionThreadsNum( const int &detection_threads_in );
+			const int &getDetectionThreadsNum( ) const;
+			void initThreadedDetection( );
+			void mergeDepositionThreadCounters( );
+			
+			//Deposition site deduplication
+			void setDepoSiteTolerance( const double &depo_site_tolerance_in );
+			const double &getDepoSiteTolerance( ) const;
+			const bool depoSiteDedupIsActive( ) const;
+			void resetDepoSiteGrids( LAMMPS_NS::LAMMPS *lmp );
+			DepositionSiteGrid &getDepoSiteGrid( );
+			
+			//Localized relaxation
+			void setLocalRelaxRadius( const double &local_relax_radius_in );
+			const double &getLocalRelaxRadius( ) const;
+			const bool localRelaxIsActive( ) const;
+			
+			//Adaptive MD stages
+			void setAdaptiveMD( const int &adaptive_md_chunk_in , const std::string &adaptive_md_metric_in , const double &adaptive_md_tol_in );
+			const int &getAdaptiveMDChunk( ) const;
+			const std::string &getAdaptiveMDMetric( ) const;
+			const double &getAdaptiveMDTolerance( ) const;
+			const bool adaptiveMDIsActive( ) const;
+			
+			//LAMMPS setup state
+			void saveLammpsSetupState( LAMMPS_NS::LAMMPS *lmp );
+			void setLammpsSystemModified( );
+			void setLammpsInitRequired( );
+			const bool lammpsSetupIsOutdated( LAMMPS_NS::LAMMPS *lmp ) const;
+			const bool lammpsInitIsRequired( LAMMPS_NS::LAMMPS *lmp ) const;
 		
 			//Deposition height settings
 			void setDepoHeights( const double &height_deposcan_in , const double &height_deporeject_in );
@@ -144,6 +217,12 @@ namespace PAPRECA{
 			void mixSigmas( LAMMPS_NS::LAMMPS *lmp );
 			const double getSigmaFromAtomTypes( const int &atom1_type , const int &atom2_type );
 			const bool type2SigmaMapIsEmpty( ) const;
+			void initSigmaSqrMatrix( LAMMPS_NS::LAMMPS *lmp );
+			const double getSigmaSqrFromAtomTypes( const int &atom1_type , const int &atom2_type ) const;
+			const double &getSigmaMax( ) const;
+			void initDepositionCollisionCells( );
+			void initEventReachMax( );
+			const double &getEventReachMax( ) const;
 			
 			//Equilibration LAMMPS
 			void setMinimize1( const std::string &minimize1_in );
@@ -162,6 +241,8 @@ namespace PAPRECA{
 			const int &getNveLimSteps( ) const;
 			void setNveLimDist( const double &nvelim_dist_in );
 			const double &getNveLimDist( ) const;
+			void setNveLimPersistent( const bool &nvelim_persistent_in );
+			const bool &nveLimIsPersistent( ) const;
 			const bool nveLimGroupIsEmpty( ) const;
 			const TAGINT_VEC &getNveLimIdsVec( ) const;
 			void clearNveLimGroup( );
@@ -183,11 +264,11 @@ namespace PAPRECA{
 			ExecTime &getExecTimeFile( );
 			void setupExportFiles( const int &proc_id );
 			void setHybridStartTimeStamp4ExecTimeFile( const int &KMC_loopid );
-			void calcHybridAndKMCTimes4ExecTimeFile( const int &nprocs , const int &KMC_loopid );
+			void calcHybridAndKMCTimes4ExecTimeFile( LAMMPS_NS::LAMMPS *lmp , const int &KMC_loopid );
 			void setMDTimeStamp4ExecTimeFile( const int &KMC_loopid );
-			void calcMDTime4ExecTimeFile( const int &nprocs , const int &KMC_loopid );
+			void calcMDTime4ExecTimeFile( const int &KMC_loopid );
 			void appendExportFiles( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const double &time , const char *event_type , const double &film_height , const int &KMC_loopid );
-			void dumpElementalDistributionFile( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &KMC_loopid , double **mass_profiles_total , double *atom_mass , const int &bins_num , const int &types_num );
+			void dumpElementalDistributionFile( LAMMPS_NS::LAMMPS *lmp , const int &proc_id , const int &KMC_loopid , const std::vector< double > &mass_profiles , double *atom_mass , const int &bins_num , const int &bin_lo , const int &occupied_bins_num , const int &types_num );
 			void closeExportFiles( const int &proc_id );
 			void setRestartDumpFreq( const int &restart_dumpfreq_in );
 			const int &getRestartDumpFreq( )const;
@@ -198,6 +279,10 @@ namespace PAPRECA{
 		
 			//Random number generator.
 			LAMMPS_NS::RanMars *rnum_gen = NULL; ///< Points to RanMars object as implemented in LAMMPS (see random_mars.h). The LAMMPS RanMars object is initialized from a user defined random seed in the PAPRECA input file (seed > 0 && seed < 900000000).
+			std::vector< LAMMPS_NS::RanMars* > thread_rnum_gens; ///< Per-thread RanMars objects used by OpenMP threads other than the master thread during threaded event detection. Re-seeded from rnum_gen before every threaded detection pass (see PaprecaConfig::seedThreadRanNumGenerators()).
+			CounterRNG counter_rnum_gen; ///< Counter-based random number generator keyed on the random seed. Used for random deposition/diffusion vectors if counter_rng is true (see PaprecaConfig::getDetectionRanNums()).
+			bool counter_rng = false; ///< If true, random deposition/diffusion vectors are drawn from counter_rnum_gen instead of rnum_gen. Off by default, to preserve the trajectories of previous PAPRECA versions.
+			int rnum_step = 0; ///< PAPRECA step of the current event detection pass. Part of the counter of counter_rnum_gen.
 			
 			//Essential parameters
 			unsigned long int KMC_steps = 0; ///< perform that many PAPRECA steps.
@@ -211,14 +296,68 @@ namespace PAPRECA{
 			
 			//Predefined events
 			PredefinedEventsCatalog predefined_catalog; ///< stores a PAPRECA::PredefinedEventsCatalog.
+			std::vector< PredefinedDiffusionHop* > diffusion_templates; ///< all PAPRECA::PredefinedDiffusionHop templates in the order they were defined in the PAPRECA input file. The index of a template is its template ID (see PAPRECA::PredefinedDiffusionHop::getTemplateID()).
+			std::vector< PredefinedDeposition* > deposition_templates; ///< all PAPRECA::PredefinedDeposition templates in the order they were defined in the PAPRECA input file. The index of a template is its template ID (see PAPRECA::PredefinedDeposition::getTemplateID()).
 			bool random_depovecs = false; ///< Controls deposition sites. If true, the deposition sites are not directly above the parent atom, but on the surface of a sphere of radius depo_offset.
 			double height_deposcan = -1;  ///< Scan for deposition events only +- above/below the current film height. Default at -1 which means scan everywhere.
 			double height_deporeject = -1; ///< Reject deposition event above height_current + height_deporeject. Default at -1 which means do not reject anything.
 			
+			//Compiled catalog. Dense copies of the predefined_catalog maps indexed by atom type and/or bond type (see PAPRECA::PaprecaConfig::compilePredefinedCatalog()). Those are used in the innermost loops of event detection instead of the hashed containers.
+			int catalog_types_num = 0; ///< number of atom types covered by the compiled tables.
+			int catalog_bondtypes_num = 0; ///< number of bond types covered by the compiled tables.
+			std::vector< unsigned int > type_flags_table; ///< (catalog_types_num+1) bitmasks of PAPRECA::CATALOG_TYPE_FLAG values.
+			std::vector< PredefinedReaction* > bond_breaks_table; ///< (catalog_bondtypes_num+1) bond break templates indexed by bond type.
+			std::vector< PredefinedBondForm* > bond_forms_table; ///< (catalog_types_num+1)x(catalog_types_num+1) row-major bond formation templates indexed by atom types.
+			std::vector< int > bonds_max_table; ///< (catalog_types_num+1) maximum bonds per atom type.
+			std::vector< int > bondtypes_max_table; ///< (catalog_types_num+1)x(catalog_bondtypes_num+1) row-major maximum bonds of a bond type per atom type (-1 if not set).
+			std::vector< DIFFUSIONS_VEC* > diffusions_table; ///< (catalog_types_num+1) diffusion templates indexed by parent atom type.
+			std::vector< DEPOSITIONS_VEC* > depositions_table; ///< (catalog_types_num+1) deposition templates indexed by parent atom type.
+			std::vector< PredefinedMonoatomicDesorption* > monodes_table; ///< (catalog_types_num+1) monoatomic desorption templates indexed by parent atom type.
+			
+			//Incremental event detection
+			bool incremental_detection = false; ///< If true, detected events are stored in a PAPRECA::EventCatalog between PAPRECA steps and only the atoms around executed events are rescanned.
+			
+			//Bond adjacency
+			bool local_bond_adjacency = false; ///< If true, the bonds of local and ghost atoms are retrieved from the per-atom bond arrays of LAMMPS (see PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms()). If false, the bonds of the whole system are gathered on every MPI process (see PAPRECA::Bond::initAtomID2BondsMap()).
+			
+			//Native execution
+			bool native_execution = false; ///< If true, events are executed by modifying the LAMMPS system directly (see lammps_native.h) instead of calling LAMMPS input commands. LAMMPS input commands are still used for operations that are not supported natively.
+			
+			//Synchronous sublattice kMC
+			bool sublattice_kmc = false; ///< If true, every MPI process can fire one event (from a sector of its subdomain) per PAPRECA step (see PAPRECA::selectAndExecuteSublatticeEvents()).
+			
+			//Event batching
+			int kmc_batch_size = 1; ///< Maximum number of PAPRECA steps executing events from the same event detection pass (see PAPRECA::continueEventBatch()). Batching is off by default (i.e., events are detected on every PAPRECA step).
+			
+			//Threaded event detection
+			int detection_threads = 1; ///< Number of OpenMP threads per MPI process used in PAPRECA::loopAtomsAndIdentifyEvents(). Detection is serial if detection_threads=1.
+			
+			//Deposition site deduplication
+			double depo_site_tolerance = 0.0; ///< Deposition candidates (of the same template) closer than depo_site_tolerance are considered identical and only checked for collisions once per event detection pass. Deduplication is off if depo_site_tolerance=0.
+			std::vector< DepositionSiteGrid > depo_site_grids; ///< One PAPRECA::DepositionSiteGrid per detection thread (see PaprecaConfig::getDepoSiteGrid()).
+			
+			//Localized relaxation
+			double local_relax_radius = 0.0; ///< Normal MD stages only integrate fluid atoms within local_relax_radius of the atoms touched by events executed since the last MD stage (see PAPRECA::equilibrateFluidAtoms()). Localized relaxation is off if local_relax_radius=0.
+			
+			//Adaptive MD stages
+			int adaptive_md_chunk = 0; ///< Normal MD stages are run in chunks of adaptive_md_chunk steps and stop as soon as the convergence metric drops below adaptive_md_tol (see PAPRECA::runAdaptiveTrajectory()). Adaptive MD stages are off if adaptive_md_chunk=0.
+			std::string adaptive_md_metric; ///< Convergence metric of adaptive MD stages. Can be "fmax" (maximum force on fluid atoms), "disp" (maximum displacement of fluid atoms during the last chunk), or "pe" (change of potential energy during the last chunk).
+			double adaptive_md_tol = 0.0; ///< Convergence tolerance of adaptive MD stages (in LAMMPS units of the selected metric).
+			
+			//LAMMPS setup state. Used to skip the LAMMPS setup (i.e., run 0) if the LAMMPS system did not change since the last setup (see PAPRECA::refreshLammps()).
+			bool lammps_setup_saved = false; ///< True if the state of the LAMMPS system was saved after a LAMMPS setup.
+			bool lammps_system_modified = false; ///< True if atoms/bonds were created, deleted, or moved (e.g., by an executed event) since the last LAMMPS setup.
+			bool lammps_init_required = false; ///< True if fixes were added/removed since the last LAMMPS setup. In that case, a full LAMMPS initialization (i.e., run 0) is required.
+			LAMMPS_NS::bigint lammps_setup_ntimestep = -1; ///< LAMMPS timestep of the last LAMMPS setup.
+			LAMMPS_NS::bigint lammps_setup_natoms = -1; ///< Total number of atoms at the last LAMMPS setup.
+			LAMMPS_NS::bigint lammps_setup_nbonds = -1; ///< Total number of bonds at the last LAMMPS setup.
+			double lammps_setup_boxlo[3] = { 0.0 , 0.0 , 0.0 }; ///< Lower bounds of the simulation box at the last LAMMPS setup.
+			double lammps_setup_boxhi[3] = { 0.0 , 0.0 , 0.0 }; ///< Upper bounds of the simulation box at the last LAMMPS setup.
+			
 			//Desorption settings. For thin-film growth you might wanna delete atoms flying above a certain height, after the equilibration step.
 			double desorb_cut = -1; ///< Atoms above film_height + desorb_cut are deleted. The default value is -1 which means that desorption is disabled.
 			int desorb_delmax = std::numeric_limits< int >::max( ); ///< Maximum number of atoms that can be deleted at once. Initialized at max limits of int so if the user does not set that, the maximum number of deleted atoms will be unlimited
-			std::string desorb_style = "";	///< User defined desorption algorithm. Currently, can be gather_local or gather_all (defined in the PAPRECA input file).
+			std::string desorb_style = "";	///< User defined desorption algorithm. Currently, can be gather_local, gather_all, gather_filtered, or LAMMPS_region (defined in the PAPRECA input file).
 			
 			//Film Height Calculation Settings
 			std::string height_method = ""; ///< Algorithm to calculate height. Currently, only the mass_bins method is supported.
@@ -232,6 +371,10 @@ namespace PAPRECA{
 			//Map that returns the sigma distance (i.e., equilibrium distance of species as in the LJ potential). Currently initialized from the LAMMPS input.
 			INTPAIR2DOUBLE_MAP type2sigma; ///< maps types of atom types to their corresponding sigma.
 			std::string sigma_style = ""; ///< method for initialization of sigma values (can be manual/LAMMPS).
+			std::vector< double > sigma_sqr_matrix; ///< dense (types_num+1)x(types_num+1) row-major copy of the squared type2sigma values used in collision checks. Unmapped pairs are stored as -1.
+			int sigma_types_num = 0; ///< number of atom types (as in LAMMPS) covered by the sigma_sqr_matrix.
+			double sigma_max = 0.0; ///< largest mapped sigma value. Used as the collision cutoff in bounding-sphere tests.
+			double event_reach_max = 0.0; ///< largest distance from the parent atom at which a deposition or diffusion event can insert, move, or check atoms (see PAPRECA::PaprecaConfig::initEventReachMax()).
 			std::string sigma_mix =""; //< Two types of sigma_mix are currently supported: geom/arithm. See: https://docs.lammps.org/pair_modify.html. This variable is initialized as NONE so we know there is no mixing even when the mix keyword is not used.
 			
 			//Equilibrations - LAMMPS
@@ -244,6 +387,7 @@ namespace PAPRECA{
 			bool nvelim_active = false; ///< To check if nve lim operations have to be performed
 			int nvelim_steps = -1; ///< Number of MD stage time steps that atoms are integrated internally via an nve/limit command. See https://docs.lammps.org/fix_nve_limit.html
 			double nvelim_dist = -1.0; ///< Acceptable distance for atoms to move during nve/lim
+			bool nvelim_persistent = false; ///< If true, the nve/limit integrator is installed once (on the nve_limited group) and the nve_limited group is modified directly through the LAMMPS mask array on every MD stage (see PAPRECA::setNveLimitedGroupNative()).
 			TAGINT_VEC nvelim_ids; ///< Stores atom IDs to be integrated via nve/limit.
 			
 			//Neighbor lists
@@ -255,6 +399,10 @@ namespace PAPRECA{
 			HeightVtime heightVtime_file; ///< stores a PAPRECA::HeightVtime file.
 			SurfaceCoverage surfcoverage_file; ///< stores a PAPRECA::SurfaceCoverage file.
 			double surface_coverage = 0.0; ///< stores a surface coverage for easier printing (if necessary).
+			StepStats step_stats; ///< per-step scalars of all MPI processes (i.e., deposition tries/sites and execution times), reduced with a single collective per PAPRECA step (see PAPRECA::PaprecaConfig::reduceStepStats()).
+			int coverage_sites_stat = -1; ///< ID of the total deposition sites scalar in step_stats (-1 if the surface coverage is not calculated).
+			int coverage_tries_stat = -1; ///< ID of the total deposition tries scalar in step_stats (-1 if the surface coverage is not calculated).
+			std::unordered_map< std::string , INT_PAIR > adsorbate2stats; ///< maps adsorbate names (of depositions with variable sticking coefficients) to the IDs of their deposition sites and tries scalars in step_stats.
 			ElementalDistribution elementalDistribution_files; ///< stores the PAPRECA::ElementalDistribution files generated in the simulation.
 			ExecTime execTime_file; ///< stores a PAPRECA::ExecTime file.
 			int restart_dumpfreq = std::numeric_limits< int >::max( ); ///< dump a restart every restart_dumpfreq PAPRECA steps. Initialized at int limits, so if it is not set you virtually never dump restarts (see how restarts are dumped in lammps_wrappers.h of papreca lib).
@@ -59,6 +59,18 @@ namespace PAPRECA{
 		}
 		
 	}
+	
+	void advanceSimClockFromLAMMPSSteps( PaprecaConfig &papreca_config , double &time , const int &steps_num ){
+		
+		/// Advances the simulation clock by timestep*steps_num. Used for MD stages whose number of steps is only known after the run (see PAPRECA::runAdaptiveTrajectory()).
+		/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+		/// @param[in,out] time current time.
+		/// @param[in] steps_num number of LAMMPS timesteps actually run.
+		/// @see PAPRECA::advanceSimClockFromLAMMPS()
+		
+		time += papreca_config.getCtimeConvert( ) * steps_num;
+		
+	}
 
 	
 } //End of PAPRECA Namespace
@@ -39,6 +39,7 @@ namespace PAPRECA{
 	
 	void advanceSimClockFromKMC( PaprecaConfig &papreca_config , const double &proc_rates_sum , double &time );
 	void advanceSimClockFromLAMMPS( PaprecaConfig &papreca_config , double &time , const std::string &traj_type );
+	void advanceSimClockFromLAMMPSSteps( PaprecaConfig &papreca_config , double &time , const int &steps_num );
 	
 }//end of PAPRECA namespace 
 
@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Definitions for step_stats.h.
+
+#include "step_stats.h"
+
+namespace PAPRECA{
+	
+	//Constructors/Destructors
+	StepStats::StepStats( ){ }
+	StepStats::~StepStats( ){ }
+	
+	//Functions
+	const int StepStats::registerStat( const STAT_OP &op ){
+		
+		/// Registers a new scalar.
+		/// @param[in] op reduction operation of the scalar across MPI processes.
+		/// @return ID of the registered scalar (to be used in PAPRECA::StepStats::setLocalValue(), PAPRECA::StepStats::getGlobalValue(), etc.).
+		
+		local_values.push_back( 0.0 );
+		packed_stats.push_back( static_cast< double >( op ) );
+		packed_stats.push_back( 0.0 );
+		
+		return static_cast< int >( local_values.size( ) ) - 1;
+		
+	}
+	
+	void StepStats::clearStats( ){
+		
+		local_values.clear( );
+		packed_stats.clear( );
+		
+	}
+	
+	const int StepStats::getStatsNum( ) const{ return static_cast< int >( local_values.size( ) ); }
+	
+	void StepStats::resetLocalValues( ){ local_values.assign( local_values.size( ) , 0.0 ); }
+	void StepStats::setLocalValue( const int &stat_id , const double &value ){ local_values[stat_id] = value; }
+	void StepStats::addToLocalValue( const int &stat_id , const double &value ){ local_values[stat_id] += value; }
+	
+	void StepStats::reduce( MPI_Comm communicator ){
+		
+		/// Reduces all registered scalars across the MPI processes of communicator with a single MPI_Allreduce.
+		/// @param[in] communicator MPI communicator.
+		/// @note This is a collective operation. All MPI processes have to register the same scalars (in the same order).
+		/// @see PAPRECA::StepStats::getGlobalValue()
+		
+		const int stats_num = getStatsNum( );
+		if( stats_num == 0 ){ return; }
+		
+		for( int i = 0; i < stats_num; ++i ){ packed_stats[2*i+1] = local_values[i]; }
+		MPI_Allreduce( MPI_IN_PLACE , packed_stats.data( ) , stats_num , getPackedStatType( ) , getPackedOp( ) , communicator );
+		
+	}
+	
+	const double &StepStats::getGlobalValue( const int &stat_id ) const{
+		
+		/// @param[in] stat_id ID of registered scalar.
+		/// @return reduced value of the scalar (as obtained from the last PAPRECA::StepStats::reduce() call).
+		
+		return packed_stats[2*stat_id+1];
+		
+	}
+	
+	void StepStats::applyPackedOps( void *in , void *inout , int *len , MPI_Datatype * ){
+		
+		/// User-defined MPI operation applying the reduction operation packed with each scalar.
+		/// @param[in] in packed (operation,value) pairs of incoming data.
+		/// @param[in,out] inout packed (operation,value) pairs of accumulated data.
+		/// @param[in] len number of (operation,value) pairs.
+		/// @note The datatype argument (required by the MPI_User_function signature) is unnamed, since this operation is only used with PAPRECA::StepStats::getPackedStatType().
+		
+		const double *in_stats = static_cast< const double* >( in );
+		double *inout_stats = static_cast< double* >( inout );
+		
+		for( int i = 0; i < *len; ++i ){
+			
+			const double &in_value = in_stats[2*i+1];
+			double &inout_value = inout_stats[2*i+1];
+			
+			switch( static_cast< int >( inout_stats[2*i] ) ){
+				case STAT_SUM:
+					inout_value += in_value;
+					break;
+				case STAT_MIN:
+					if( in_value < inout_value ){ inout_value = in_value; }
+					break;
+				case STAT_MAX:
+					if( in_value > inout_value ){ inout_value = in_value; }
+					break;
+			}
+			
+		}
+		
+	}
+	
+	MPI_Datatype StepStats::getPackedStatType( ){
+		
+		/// @return MPI datatype of a (operation,value) pair. Using a pair datatype ensures that MPI never splits a pair when segmenting the reduction.
+		
+		static MPI_Datatype packed_stat_type = MPI_DATATYPE_NULL;
+		if( packed_stat_type == MPI_DATATYPE_NULL ){
+			MPI_Type_contiguous( 2 , MPI_DOUBLE , &packed_stat_type );
+			MPI_Type_commit( &packed_stat_type );
+		}
+		
+		return packed_stat_type;
+		
+	}
+	
+	MPI_Op StepStats::getPackedOp( ){
+		
+		/// @return user-defined MPI operation applying PAPRECA::StepStats::applyPackedOps().
+		
+		static MPI_Op packed_op = MPI_OP_NULL;
+		if( packed_op == MPI_OP_NULL ){ MPI_Op_create( &StepStats::applyPackedOps , 1 , &packed_op ); }
+		
+		return packed_op;
+		
+	}
+	
+	
+}//end of namespace PAPRECA
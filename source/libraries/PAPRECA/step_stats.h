@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------------------
+PAPRECA hybrid off-lattice kinetic Monte Carlo/Molecular dynamics simulator.
+Copyright (C) 2024 Stavros Ntioudis, James P. Ewen, Daniele Dini, and C. Heath Turner
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+----------------------------------------------------------------------------------------*/
+
+/// \file ///
+/// @brief Declarations for PAPRECA::StepStats class reducing per-step scalar statistics with a single MPI collective.
+
+#ifndef STEP_STATS_H
+#define STEP_STATS_H
+
+//System Headers
+#include <vector>
+#include <mpi.h>
+
+namespace PAPRECA{
+	
+	enum STAT_OP{ STAT_SUM = 0 , STAT_MIN = 1 , STAT_MAX = 2 };
+	
+	class StepStats{
+		
+		/// @class PAPRECA::StepStats
+		/// @brief Aggregates per-step scalar statistics of all MPI processes.
+		///
+		/// Modules register their scalars once (each with its own reduction operation: PAPRECA::STAT_SUM, PAPRECA::STAT_MIN, or PAPRECA::STAT_MAX) and set their local values on every PAPRECA step.
+		/// All registered scalars are then reduced with a single MPI_Allreduce. Each scalar is packed with its reduction operation, so a single user-defined MPI operation can apply different operations to different scalars.
+		/// This replaces many small (latency-bound) collectives with one.
+		
+		public:
+			//Constructors/Destructors
+			StepStats( );
+			~StepStats( );
+			
+			//Functions
+			const int registerStat( const STAT_OP &op );
+			void clearStats( );
+			const int getStatsNum( ) const;
+			void resetLocalValues( );
+			void setLocalValue( const int &stat_id , const double &value );
+			void addToLocalValue( const int &stat_id , const double &value );
+			void reduce( MPI_Comm communicator );
+			const double &getGlobalValue( const int &stat_id ) const;
+		
+		private:
+			static void applyPackedOps( void *in , void *inout , int *len , MPI_Datatype * );
+			static MPI_Datatype getPackedStatType( );
+			static MPI_Op getPackedOp( );
+			
+			std::vector< double > packed_stats; ///< pairs of (reduction operation, value) for every registered scalar. Local values before PAPRECA::StepStats::reduce() and global values after.
+			std::vector< double > local_values; ///< local (per MPI process) values of registered scalars.
+		
+	};
+	
+	
+}//end of namespace PAPRECA
+
+#endif
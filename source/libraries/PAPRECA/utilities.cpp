@@ -315,4 +315,17 @@ namespace PAPRECA{
 		
 	}
 	
+	//OpenMP threads
+	const int getThreadID( ){
+		
+		/// @return the ID of the calling OpenMP thread (0 outside parallel regions or if PAPRECA was compiled without OpenMP support).
+		
+		#ifdef _OPENMP
+		return omp_get_thread_num( );
+		#else
+		return 0;
+		#endif
+		
+	}
+	
 }//End of namespace PAPRECA
@@ -32,6 +32,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <algorithm>
 #include <cctype>
 #include <mpi.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 //LAMMPS headers
 #include "pointers.h"
@@ -155,6 +158,9 @@ namespace PAPRECA{
 	const bool string2Bool( std::string &string );
 	const int boolString2Int( std::string &string );
 	
+	//OpenMP threads
+	const int getThreadID( );
+	
 	struct PairHash{
 		
 		/// @class PAPRECA::PairHash
@@ -115,7 +115,7 @@ int main( int narg , char **arg ){
 	/// Driver function running the main PAPRECA simulation loop. The function sets up the MPI protocol, initializes all (LAMMPS and PAPRECA) variables, and performs the requested (by the user, in the PAPRECA input file) PAPRECA simulation KMC steps. On each PAPRECA simulation KMC step, each atom on every MPI process is scanned and PAPRECA::Events are discovered. Then, an event is executed on an MPI processes (the executed event as well as the MPI process firing the event are chosen based on the N-FOLD way).
 	/// @param[in] narg number of command-line arguments passed to the main function (i.e., the papreca executable) during the program invocation from the terminal.
 	/// @param[in] arg array containing the char* passed to the main function during the program invocation from the terminal.
-	/// @see PAPRECA::setupMPI(), PAPRECA::initializeLMP(), PAPRECA::readLMPinput(), PAPRECA::readInputAndInitPaprecaConfig(), PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::loopAtomsAndIdentifyEvents(), PAPRECA::selectAndExecuteEvent(), PAPRECA::deleteAndClearLocalEvents(), PAPRECA::equilibrate(), PAPRECA::finalize()
+	/// @see PAPRECA::setupMPI(), PAPRECA::initializeLMP(), PAPRECA::readLMPinput(), PAPRECA::readInputAndInitPaprecaConfig(), PAPRECA::refreshLammps(), PAPRECA::Bond::initAtomID2BondsMap(), PAPRECA::loopAtomsAndIdentifyEvents(), PAPRECA::updateEventCatalogAndIdentifyEvents(), PAPRECA::selectAndExecuteEvent(), PAPRECA::Event::resetEventPoolsAndClearLocalEvents(), PAPRECA::equilibrate(), PAPRECA::finalize()
 	/// @note Example execution of PAPRECA from UNIX terminal: mpiexec papreca -in in_kmc.lmp in_kmc.ppc. CAUTION: Always provide the LAMMPS input file first and the PAPRECA input file second, otherwise the code will exit with an error. 
 	/// @note See paper this paper for more information regarding the classic N-FOLD way and the event selection process: https://www.sciencedirect.com/science/article/pii/S0927025623004159
 	if ( narg != 4 ) { allAbortWithMessage( MPI_COMM_WORLD , "Syntax Error. Input command should be in the following form: mpirun -np N main -in in.lammps in.papreca." );}
@@ -133,7 +133,11 @@ int main( int narg , char **arg ){
 	int zero_rate = 0; //Tells you whether the total rate on a given step is zero (if it is you should equilibrate immediately)
 	vector<Event*> events_local; //using a unique pointer to switch effortlessly between the child classes of Event
 	events_local.reserve( 10 ); //Reserve 10 events per proc. Obviously, the vector will resize if necessary 
-	ATOM2BONDS_MAP atomID2bonds;
+	BondGraph atomID2bonds;
+	EventCatalog event_catalog; //Stores events between PAPRECA steps (only used if incremental_detection is active)
+	if( papreca_config.incrementalDetectionIsActive( ) ){ event_catalog.activate( ); }
+	if( papreca_config.localRelaxIsActive( ) ){ event_catalog.startRelaxTracking( ); }
+	int batch_events = 0; //Number of PAPRECA steps that executed events from the current detection pass (only used if kmc_batch is set)
 	
 	//Main loop
 	for( int i = 1; i <= papreca_config.getKMCsteps( ); ++i ){
@@ -141,24 +145,49 @@ int main( int narg , char **arg ){
 		//Initial timestamp for execution time measurement
 		papreca_config.setHybridStartTimeStamp4ExecTimeFile( i );
 		
-		//Init atomID2bonds 
-		PAPRECA::Bond::initAtomID2BondsMap( lmp , proc_id , atomID2bonds );
+		//Continue executing events from the previous detection pass (only if kmc_batch is set), or detect events from scratch
+		const bool batch_step = continueEventBatch( lmp , papreca_config , event_catalog , events_local , i , batch_events );
+		const bool md_step = ( i % papreca_config.getKMCperMD( ) == 0 || i % papreca_config.getKMCperLongMD( ) == 0 );
+		if( !batch_step ){ releaseLocalEvents( events_local , event_catalog ); }
+		
+		//Refresh LAMMPS neighbor lists (only if the system changed since the last refresh) and init atomID2bonds. On batch steps, atomID2bonds is only needed for the MD stage.
+		if( !batch_step || md_step ){
+			refreshLammps( lmp , papreca_config );
+			if( papreca_config.localBondAdjacencyIsActive( ) ){
+				PAPRECA::Bond::initAtomID2BondsMapFromLocalAtoms( lmp , atomID2bonds );
+			}else{
+				PAPRECA::Bond::initAtomID2BondsMap( lmp , proc_id , atomID2bonds );
+			}
+		}
 		
 		//KMC Operations
-		if( papreca_config.boxZvacuumIsActive( ) ){ adjustSimulationBoxZvacuum( lmp , papreca_config ); } //Box has to be resized here to enable depositions
-		loopAtomsAndIdentifyEvents( lmp , proc_id , nprocs , i , papreca_config , events_local , atomID2bonds , film_height );
-		zero_rate = selectAndExecuteEvent( lmp , i , time , event_type , proc_id , nprocs , papreca_config , events_local , atomID2bonds , film_height );
-		Event::deleteAndClearLocalEvents( lmp , events_local );	
+		if( !batch_step ){
+			batch_events = 0;
+			if( papreca_config.boxZvacuumIsActive( ) ){ adjustSimulationBoxZvacuum( lmp , papreca_config ); } //Box has to be resized here to enable depositions
+			if( event_catalog.isActive( ) ){
+				updateEventCatalogAndIdentifyEvents( lmp , proc_id , nprocs , i , papreca_config , event_catalog , events_local , atomID2bonds , film_height );
+			}else{
+				loopAtomsAndIdentifyEvents( lmp , proc_id , nprocs , i , papreca_config , events_local , atomID2bonds , film_height );
+			}
+			if( papreca_config.eventBatchingIsActive( ) ){ event_catalog.startEventBatch( ); }
+		}
+		if( papreca_config.sublatticeKMCIsActive( ) ){
+			zero_rate = selectAndExecuteSublatticeEvents( lmp , i , time , event_type , proc_id , nprocs , papreca_config , events_local , atomID2bonds , event_catalog , film_height );
+		}else{
+			zero_rate = selectAndExecuteEvent( lmp , i , time , event_type , proc_id , nprocs , papreca_config , events_local , atomID2bonds , event_catalog , film_height );
+		}
+		batch_events = ( zero_rate ? 0 : batch_events + 1 );
+		if( !papreca_config.eventBatchingIsActive( ) ){ releaseLocalEvents( events_local , event_catalog ); } //Otherwise, events are kept for the next PAPRECA step of the batch
 		
 		//LAMMPS Equilibration
-		equilibrate( lmp , proc_id , nprocs , time , papreca_config , film_height , zero_rate , i , atomID2bonds );
+		equilibrate( lmp , proc_id , nprocs , time , papreca_config , film_height , zero_rate , i , atomID2bonds , event_catalog );
 		
 		//Reset atomID2bonds
 		atomID2bonds.clear( );
 		
 		//Export Files
 		papreca_config.dumpLAMMPSRestart( lmp , i );
-		papreca_config.calcHybridAndKMCTimes4ExecTimeFile( nprocs , i );
+		papreca_config.calcHybridAndKMCTimes4ExecTimeFile( lmp , i );
 		papreca_config.appendExportFiles( lmp , proc_id , time , event_type , film_height , i );
 		
 		//Test if target ending time is exceeded to exit prematurely. 
@@ -166,5 +195,6 @@ int main( int narg , char **arg ){
 		
 	}
 	
+	releaseLocalEvents( events_local , event_catalog );
 	finalize( &lmp , papreca_config , proc_id );	
 }
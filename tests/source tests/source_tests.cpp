@@ -314,6 +314,86 @@ void testCollisions( LAMMPS *lmp , PaprecaConfig &papreca_config , const int &pr
 	
 }
 
+void testMinImageBatch( LAMMPS *lmp , const int &proc_id ){
+	
+	/// Checks if the batched minimum image distances (see PAPRECA::MinImageBatch) match the per-pair distances of PAPRECA::get3DSqrDistWithPBC().
+	/// @param[in] lmp pointer to LAMMPS instance.
+	/// @param[in] proc_id ID of current MPI process.
+	/// @note All local and ghost atoms of each MPI process are used as a (fake) neighbor list of points close to the corners of the box (to check periodic boundary conditions).
+	
+	double **atom_xyz = ( double **)lammps_extract_atom( lmp , "x" );
+	const int atoms_num = lmp->atom->nlocal + lmp->atom->nghost;
+	std::vector< int > neighbors( atoms_num );
+	for( int i = 0; i < atoms_num; ++i ){ neighbors[i] = i; }
+	
+	const double points[2][3] = { { lmp->domain->boxlo[0] + 0.1 , lmp->domain->boxlo[1] + 0.1 , 20.0 } , { lmp->domain->boxhi[0] - 0.1 , lmp->domain->boxhi[1] - 0.1 , 30.0 } };
+	
+	MinImageBatch batch;
+	int mismatches = 0;
+	for( const auto &point : points ){
+		
+		batch.compute( lmp , point , atom_xyz , neighbors.data( ) , atoms_num );
+		const double *sqr_dists = batch.getSqrDists( );
+		
+		for( int i = 0; i < atoms_num; ++i ){
+			if( std::fabs( sqr_dists[i] - get3DSqrDistWithPBC( lmp , point , atom_xyz[i] ) ) > 1.0e-8 ){ ++mismatches; }
+		}
+		
+	}
+	
+	int mismatches_global = 0;
+	MPI_Allreduce( &mismatches , &mismatches_global , 1 , MPI_INT , MPI_SUM , MPI_COMM_WORLD );
+	
+	if( proc_id == 0 ){
+		printf( "\n \n MINIMUM IMAGE BATCH TEST SUMMARY \n" );
+		printf( "---------------------------------------------------------------- \n" );
+		printf( "A total of %d mismatches with per-pair minimum image distances were detected (should be 0) \n" , mismatches_global );
+		printf( "----------------------------------------------------------------\n \n \n \n" );
+	}
+	
+	if( mismatches_global != 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "testMinImageBatch function in source_tests.cpp failed!" ); }
+	
+}
+
+void testDepositionSiteGrid( LAMMPS *lmp , const int &proc_id ){
+	
+	/// Checks if PAPRECA::DepositionSiteGrid finds stored deposition candidates within the tolerance (also across periodic boundaries) and ignores candidates of other templates or further than the tolerance.
+	/// @param[in] lmp pointer to LAMMPS instance.
+	/// @param[in] proc_id ID of current MPI process.
+	
+	if( proc_id != 0 ){ return; } //Only run this test for the master proc
+	
+	const double tolerance = 0.5;
+	DepositionSiteGrid grid;
+	grid.reset( lmp , tolerance );
+	
+	const double corner_site[3] = { lmp->domain->boxlo[0] + 0.1 , lmp->domain->boxlo[1] + 0.1 , 20.0 };
+	const double middle_site[3] = { lmp->domain->boxlo[0] + 0.5 * lmp->domain->prd[0] , lmp->domain->boxlo[1] + 0.5 * lmp->domain->prd[1] , 20.0 };
+	grid.insertSite( 0 , corner_site , true );
+	grid.insertSite( 0 , middle_site , false );
+	
+	const double corner_image[3] = { lmp->domain->boxhi[0] - 0.1 , lmp->domain->boxhi[1] - 0.1 , 20.0 }; //0.2*sqrt(2) away from corner_site (if the box is periodic along x and y)
+	const double middle_near[3] = { middle_site[0] + 0.3 , middle_site[1] , 20.2 };
+	const double middle_far[3] = { middle_site[0] + 0.3 , middle_site[1] , 21.0 };
+	
+	int failures = 0;
+	if( lmp->domain->periodicity[0] && lmp->domain->periodicity[1] && grid.findSite( lmp , 0 , corner_image ) != DEPO_SITE_FREE ){ ++failures; }
+	if( grid.findSite( lmp , 0 , middle_near ) != DEPO_SITE_BLOCKED ){ ++failures; }
+	if( grid.findSite( lmp , 1 , middle_near ) != DEPO_SITE_NONE ){ ++failures; }
+	if( grid.findSite( lmp , 0 , middle_far ) != DEPO_SITE_NONE ){ ++failures; }
+	
+	grid.reset( lmp , tolerance );
+	if( grid.findSite( lmp , 0 , middle_near ) != DEPO_SITE_NONE ){ ++failures; }
+	
+	printf( "\n \n DEPOSITION SITE GRID TEST SUMMARY \n" );
+	printf( "---------------------------------------------------------------- \n" );
+	printf( "A total of %d failed site lookups were detected (should be 0) \n" , failures );
+	printf( "----------------------------------------------------------------\n \n \n \n" );
+	
+	if( failures != 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "testDepositionSiteGrid function in source_tests.cpp failed!" ); }
+	
+}
+
 void testRandomNumberGenerator( PaprecaConfig &papreca_config , const int &proc_id , const int &nprocs ){
 	
 	/// Tests if the random number generator can produce a unique sequence of numbers. The user has to select the test limit.
@@ -352,6 +432,159 @@ void testRandomNumberGenerator( PaprecaConfig &papreca_config , const int &proc_
 }
 
 
+void testRateTree( PaprecaConfig &papreca_config , const int &proc_id ){
+	
+	/// Tests if the PAPRECA::RateTree selects the same processes as a linear cumulative scan (over the same process indices).
+	/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+	/// @param[in] proc_id ID of current MPI process.
+	/// @note Random rates (including zero rates) are produced on the master MPI proc. Rates are multiples of 1/1024, so all partial sums (of the tree and the linear scan) are exact and no mismatches are allowed.
+	
+	if( proc_id != 0 ){ return; } //Only run this test for the master proc
+	
+	const int rates_num = 1000 , test_limit = 1.0e5;
+	std::vector< double > rates( rates_num );
+	for( int i = 0; i < rates_num; ++i ){ rates[i] = ( papreca_config.getUniformRanNum( ) < 0.2 ) ? 0.0 : std::ceil( papreca_config.getUniformRanNum( ) * 1024.0 ) / 1024.0; }
+	
+	RateTree rate_tree;
+	rate_tree.build( rates.data( ) , rates_num );
+	
+	int mismatches = 0 , zero_rate_selections = 0;
+	for( int i = 0; i < test_limit; ++i ){
+		
+		if( i % 100 == 0 ){ //Change a random rate and rebuild the tree every 100 tests
+			const int index = static_cast< int >( papreca_config.getUniformRanNum( ) * rates_num ) % rates_num;
+			rates[index] = ( papreca_config.getUniformRanNum( ) < 0.2 ) ? 0.0 : std::ceil( papreca_config.getUniformRanNum( ) * 1024.0 ) / 1024.0;
+			rate_tree.build( rates.data( ) , rates_num );
+		}
+		
+		const double rnum = papreca_config.getUniformRanNum( );
+		const int selected = rate_tree.selectIndex( rnum );
+		if( rates[selected] <= 0.0 ){ ++zero_rate_selections; }
+		
+		//Reference: linear cumulative scan
+		double rates_sum = 0.0;
+		for( const double &rate : rates ){ rates_sum += rate; }
+		const double target = rnum * rates_sum;
+		double rate_cur = 0.0;
+		int expected = -1;
+		for( int j = 0; j < rates_num; ++j ){
+			if( rates[j] > 0.0 ){
+				rate_cur += rates[j];
+				expected = j;
+				if( target <= rate_cur ){ break; }
+			}
+		}
+		
+		if( selected != expected ){ ++mismatches; }
+	
+	}
+	
+	printf( "\n \n RATE TREE TEST SUMMARY \n" );
+	printf( "---------------------------------------------------------------- \n" );
+	printf( "A total of %d tests were performed...\n" , test_limit );
+	printf( "A total of %d mismatches with the linear scan selection were detected (should be 0) \n" , mismatches );
+	printf( "A total of %d zero-rate processes were selected (should be 0) \n" , zero_rate_selections );
+	printf( "----------------------------------------------------------------\n \n \n \n" );
+	
+	if( mismatches != 0 || zero_rate_selections != 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "testRateTree function in source_tests.cpp failed!" ); }
+	
+}
+
+
+void testCounterRNG( const int &proc_id ){
+	
+	/// Tests if PAPRECA::CounterRNG produces reproducible random numbers in (0,1) that are different for different counters (i.e., PAPRECA steps, atom IDs, streams, and template IDs).
+	/// @param[in] proc_id ID of current MPI process.
+	/// @note The first output of a zero key/counter is compared against the known answer of the Philox4x32-10 generator (Salmon et al., SC11).
+	
+	if( proc_id != 0 ){ return; } //Only run this test for the master proc
+	
+	CounterRNG counter_rng;
+	double rnums[2];
+	
+	counter_rng.setSeed( 0 );
+	counter_rng.getUniformRanNums( 0 , 0 , RNG_STREAM_DEPOSITION , 0 , rnums );
+	const double known_answer = ( static_cast< double >( 0x6627e8d5e169c58dULL >> 11 ) + 0.5 ) / 9007199254740992.0;
+	if( rnums[0] != known_answer ){ allAbortWithMessage( MPI_COMM_WORLD , "testCounterRNG function in source_tests.cpp failed! Philox known answer mismatch." ); }
+	
+	counter_rng.setSeed( 12345 );
+	const int steps_num = 100 , atoms_num = 1000;
+	std::unordered_set< double > generated;
+	int repetitions = 0 , out_of_range = 0 , irreproducible = 0;
+	
+	for( int step = 0; step < steps_num; ++step ){
+		for( LAMMPS_NS::tagint atom_id = 1; atom_id <= atoms_num; ++atom_id ){
+			for( const RNG_STREAM &stream : { RNG_STREAM_DEPOSITION , RNG_STREAM_DIFFUSION } ){
+				
+				double rnums_again[2];
+				counter_rng.getUniformRanNums( step , atom_id , stream , 1 , rnums );
+				counter_rng.getUniformRanNums( step , atom_id , stream , 1 , rnums_again );
+				
+				for( int i = 0; i < 2; ++i ){
+					if( rnums[i] != rnums_again[i] ){ ++irreproducible; }
+					if( rnums[i] <= 0.0 || rnums[i] >= 1.0 ){ ++out_of_range; }
+					if( !elementIsInUnorderedSet( generated , rnums[i] ) ){
+						generated.insert( rnums[i] );
+					}else{
+						++repetitions;
+					}
+				}
+				
+			}
+		}
+	}
+	
+	const int test_limit = steps_num * atoms_num * 4;
+	
+	printf( "\n \n COUNTER-BASED RANDOM NUMBERS TEST SUMMARY \n" );
+	printf( "---------------------------------------------------------------- \n" );
+	printf( "A total of %d tests were performed...\n" , test_limit );
+	printf( "A total of %d random number repetitions were detected (%f %%) \n" , repetitions , 100 * static_cast<double>(repetitions) / ( test_limit ) );
+	printf( "A total of %d irreproducible and %d out of range random numbers were detected (should be 0) \n" , irreproducible , out_of_range );
+	printf( "----------------------------------------------------------------\n \n \n \n" );
+	
+	if( irreproducible != 0 || out_of_range != 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "testCounterRNG function in source_tests.cpp failed!" ); }
+	
+}
+
+
+void testSublatticeRecords( PaprecaConfig &papreca_config , const int &proc_id ){
+	
+	/// Checks if synchronous sublattice kMC (see PAPRECA::getExecutableRecordsNum()) stops executing the records of a PAPRECA step after the first record that deletes atoms in atomic systems (i.e., before atom IDs are re-assigned), and executes all records in molecular systems.
+	/// @param[in] papreca_config object of the PAPRECA::PaprecaConfig class that stores global variables and settings for the current PAPRECA run.
+	/// @param[in] proc_id ID of current MPI process.
+	/// @note The diffusion record uses the first PAPRECA::PredefinedDiffusionHop template of the test input (spawn style, which does not delete atoms).
+	
+	if( proc_id != 0 ){ return; } //Only run this test for the master proc
+	
+	std::vector< EventRecord > records( 5 );
+	records[0].type = EVENT_DEPO;
+	records[1].type = EVENT_DIFF;
+	records[1].template_id = 0;
+	records[2].type = EVENT_RXN_FORM;
+	records[2].ints[1] = 1; //Bond formation with delete_atoms
+	records[3].type = EVENT_MONO_DES;
+	
+	int failures = 0;
+	if( getExecutableRecordsNum( papreca_config , records , true ) != 3 ){ ++failures; }
+	if( getExecutableRecordsNum( papreca_config , records , false ) != 5 ){ ++failures; }
+	
+	records[2].ints[1] = 0; //Bond formation without delete_atoms
+	if( getExecutableRecordsNum( papreca_config , records , true ) != 4 ){ ++failures; }
+	
+	records[3].type = EVENT_NONE;
+	if( getExecutableRecordsNum( papreca_config , records , true ) != 5 ){ ++failures; }
+	
+	printf( "\n \n SUBLATTICE RECORDS TEST SUMMARY \n" );
+	printf( "---------------------------------------------------------------- \n" );
+	printf( "A total of %d wrong numbers of executable records were detected (should be 0) \n" , failures );
+	printf( "----------------------------------------------------------------\n \n \n \n" );
+	
+	if( failures != 0 ){ allAbortWithMessage( MPI_COMM_WORLD , "testSublatticeRecords function in source_tests.cpp failed!" ); }
+	
+}
+
+
 int main( int narg , char **arg ){
 
 	/// Driver function for source tests.
@@ -375,9 +608,24 @@ int main( int narg , char **arg ){
 	testCollisions( lmp , papreca_config , proc_id );
 	resetLAMMPS( &lmp , &arg , proc_id );
 	
+	//Minimum image batch test
+	testMinImageBatch( lmp , proc_id );
+	
+	//Deposition site grid test
+	testDepositionSiteGrid( lmp , proc_id );
+	
 	//Random Numbers Test
 	testRandomNumberGenerator( papreca_config , proc_id , nprocs );
 	
+	//Rate Tree Test
+	testRateTree( papreca_config , proc_id );
+	
+	//Counter-based Random Numbers Test
+	testCounterRNG( proc_id );
+	
+	//Sublattice Records Test
+	testSublatticeRecords( papreca_config , proc_id );
+	
 	
 	finalizeTests( &lmp );
 	